@@ -0,0 +1,576 @@
+/*
+ * bench_render.cpp - Host timings of the rendering paths
+ *
+ *   - 7-segment digits: Paint_DrawPolygon per segment, a cacheShape()
+ *     sprite, and the flash asset (drawAsset())
+ *   - rectangle fills: the span kernels behind Paint_FillRect against a
+ *     Paint_SetPixel loop, byte-aligned and not, at 1 and 2 bpp
+ *   - text and polygons through the specialized pixel writers at each
+ *     rotation, checked against the ROTATE_0 image remapped with the
+ *     generic rotation/mirror switch
+ *   - portrait (ROTATE_270) drawing straight into the screen buffer
+ *     against the upright canvas, whole screen and one small region
+ *   - arcs, thick lines and Bezier curves: the float code WatcherDisplay
+ *     used against the integer Paint_Draw* rasterizers, by time and by
+ *     pixels that moved
+ *   - 4-gray frames: the original per-pixel plane conversion against the
+ *     table-driven EPD_4IN2_V2_Display_4Gray
+ *
+ * Host times only rank the paths; the ESP32 numbers differ in scale.
+ * Each pair is also checked for producing the same pixels.
+ * RAM data is not decoded while timing (HostPanel::decodeData).
+ */
+
+#include "panel_model.h"
+
+#include "WatcherDisplay.h"
+#include "seven_segment.h"
+#include "pomodoro_assets.h"
+
+#include <chrono>
+
+static int mismatches = 0;
+
+// Best of three batches, so a busy host does not skew one path
+template <typename F>
+static double usPerRun(int runs, F run)
+{
+    double best = 0;
+    for (int batch = 0; batch < 3; batch++) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < runs; i++) run(i);
+        auto end = std::chrono::steady_clock::now();
+        double us = std::chrono::duration<double, std::micro>(end - start).count() / runs;
+        if (batch == 0 || us < best) best = us;
+    }
+    return best;
+}
+
+static uint32_t bitDiff(const UBYTE *a, const UBYTE *b, uint32_t size)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < size; i++) count += __builtin_popcount((UBYTE)(a[i] ^ b[i]));
+    return count;
+}
+
+// ========== Digits ==========
+
+#define DIGIT_X 122
+#define DIGIT_Y 85
+
+// The segment paths reach x+70/y+130
+#define SPRITE_WIDTH  (DIGIT_WIDTH + 1)
+#define SPRITE_HEIGHT (DIGIT_HEIGHT + 1)
+
+static void drawDigitShape(void *context)
+{
+    drawDigitPolygons(0, 0, (uint8_t)(uintptr_t)context);
+}
+
+static void benchDigits()
+{
+    printf("7-segment digit, clear + draw\n");
+    const UWORD rotations[] = { ROTATE_0, ROTATE_90, ROTATE_180, ROTATE_270 };
+    static UBYTE reference[BUFFER_SIZE];
+    uint32_t off = 0, assetOff = 0;
+
+    for (UWORD rotation : rotations) {
+        host_reset();
+        WatcherDisplay display;
+        display.begin(false, rotation);
+        UBYTE *buffer = display.getBuffer();
+
+        int8_t shapes[10];
+        for (uint8_t d = 0; d < 10; d++) {
+            shapes[d] = display.cacheShape(SPRITE_WIDTH, SPRITE_HEIGHT, drawDigitShape,
+                                           (void *)(uintptr_t)d);
+        }
+        auto clearBox = [&]() {
+            display.fillRegion(DIGIT_X, DIGIT_Y, SPRITE_WIDTH, SPRITE_HEIGHT, WHITE);
+        };
+
+        if (rotation == ROTATE_0 || rotation == ROTATE_270) {
+            const int runs = 5000;
+            double polygons = usPerRun(runs, [&](int i) { clearBox(); drawDigitPolygons(DIGIT_X, DIGIT_Y, i % 10); });
+            double cached = usPerRun(runs, [&](int i) { clearBox(); display.drawCached(shapes[i % 10], DIGIT_X, DIGIT_Y, BLACK); });
+            double flash = usPerRun(runs, [&](int i) { clearBox(); display.drawAsset(DIGIT_X, DIGIT_Y, ASSET_DIGITS[i % 10], BLACK); });
+            printf("  ROTATE_%-3d Paint_DrawPolygon %6.2f us, cacheShape sprite %6.2f us (%.1fx), "
+                   "flash asset %6.2f us (%.1fx)\n", rotation, polygons, cached, polygons / cached,
+                   flash, polygons / flash);
+        }
+
+        for (uint8_t d = 0; d < 10; d++) {
+            clearBox();
+            drawDigitPolygons(DIGIT_X, DIGIT_Y, d);
+            memcpy(reference, buffer, BUFFER_SIZE);
+            clearBox();
+            display.drawCached(shapes[d], DIGIT_X, DIGIT_Y, BLACK);
+            off += bitDiff(buffer, reference, BUFFER_SIZE);
+            clearBox();
+            display.drawAsset(DIGIT_X, DIGIT_Y, ASSET_DIGITS[d], BLACK);
+            assetOff += bitDiff(buffer, reference, BUFFER_SIZE);
+        }
+    }
+    printf("  digits 0-9 at every rotation against the polygons: sprite %u px off, "
+           "flash asset %u px off\n", off, assetOff);
+    if (off || assetOff) mismatches++;
+}
+
+// ========== Fills ==========
+
+// What Paint_DrawRectangle(DRAW_FILL_FULL) came down to before the span
+// kernels: one Paint_SetPixel (rotation, mirror and clip per pixel) each
+static void fillPerPixel(UWORD x, UWORD y, UWORD w, UWORD h, UWORD color)
+{
+    for (UWORD row = y; row < y + h; row++)
+        for (UWORD col = x; col < x + w; col++) Paint_SetPixel(col, row, color);
+}
+
+static void benchFills()
+{
+    printf("rectangle fill, Paint_FillRect spans against Paint_SetPixel per pixel\n");
+    struct Rect { const char *name; UWORD x, y, w, h; } rects[] = {
+        { "280x200 aligned", 56, 48, 280, 200 },
+        { "277x197 unaligned", 61, 51, 277, 197 },
+        { "32x16 aligned", 64, 120, 32, 16 },
+        { "13x11 unaligned", 67, 123, 13, 11 },
+    };
+    const UBYTE scales[] = { 2, 4 };
+    const UWORD rotations[] = { ROTATE_0, ROTATE_270 };
+    static UBYTE images[2][2 * BUFFER_SIZE];  // Room for 2 bpp
+    uint32_t off = 0;
+
+    for (UBYTE scale : scales) {
+        for (UWORD rotation : rotations) {
+            printf("  %d bpp, ROTATE_%d\n", scale == 2 ? 1 : 2, rotation);
+            for (const Rect &r : rects) {
+                int runs = (int)(2000000 / ((uint32_t)r.w * r.h)) + 10;
+                double us[2];
+                for (int spans = 0; spans < 2; spans++) {
+                    Paint_NewImage(images[spans], DISPLAY_WIDTH, DISPLAY_HEIGHT, rotation, WHITE);
+                    Paint_SetScale(scale);
+                    Paint_Clear(WHITE);
+                    us[spans] = usPerRun(runs, [&](int i) {
+                        UWORD color = (i & 1) ? WHITE : BLACK;
+                        if (spans) Paint_FillRect(r.x, r.y, r.w, r.h, color);
+                        else fillPerPixel(r.x, r.y, r.w, r.h, color);
+                    });
+                }
+                double mpx = (double)r.w * r.h / us[1];
+                printf("    %-18s per pixel %8.2f us, spans %7.2f us (%5.1fx, %6.0f Mpx/s)\n",
+                       r.name, us[0], us[1], us[0] / us[1], mpx);
+                off += bitDiff(images[0], images[1], sizeof(images[0]));
+            }
+        }
+    }
+    printf("  images differ by %u bits\n", off);
+    if (off) mismatches++;
+}
+
+// ========== Rotated writers ==========
+
+// Same workload at every rotation: it fits the 300x300 both orientations share
+static void drawText(int i)
+{
+    char line[16];
+    for (int row = 0; row < 12; row++) {
+        snprintf(line, sizeof(line), "Row %02d %03d", row, i % 1000);
+        Paint_DrawString_EN(8, 8 + row * 24, line, &Font24, WHITE, BLACK);
+    }
+}
+
+static void drawPolygons(int i)
+{
+    static const int16_t X[6] = { 150, 280, 230, 150, 20, 70 };
+    static const int16_t Y[6] = { 10, 90, 280, 200, 280, 90 };
+    int16_t xs[6], ys[6];
+    for (int k = 0; k < 6; k++) {
+        xs[k] = X[k] - (i % 8);
+        ys[k] = Y[k] + (i % 8);
+    }
+    Paint_DrawPolygon(xs, ys, 6, BLACK, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
+    for (int k = 0; k < 6; k++) xs[k] = 150 + (xs[k] - 150) / 2;
+    Paint_DrawPolygon(xs, ys, 6, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+}
+
+// The rotation and mirror mapping Paint_SetPixel used before the writers
+static bool genericMap(UWORD x, UWORD y, UWORD rotate, UBYTE mirror, UWORD *X, UWORD *Y)
+{
+    switch (rotate) {
+    case ROTATE_0:   *X = x; *Y = y; break;
+    case ROTATE_90:  *X = DISPLAY_WIDTH - y - 1; *Y = x; break;
+    case ROTATE_180: *X = DISPLAY_WIDTH - x - 1; *Y = DISPLAY_HEIGHT - y - 1; break;
+    default:         *X = y; *Y = DISPLAY_HEIGHT - x - 1; break;
+    }
+    if (mirror & MIRROR_HORIZONTAL) *X = DISPLAY_WIDTH - *X - 1;
+    if (mirror & MIRROR_VERTICAL) *Y = DISPLAY_HEIGHT - *Y - 1;
+    return *X < DISPLAY_WIDTH && *Y < DISPLAY_HEIGHT;
+}
+
+// Draw upright into a logical-size canvas, then place every pixel through
+// genericMap()
+static void renderGeneric(void (*draw)(int), int i, UWORD rotate, UBYTE mirror, UBYTE *out)
+{
+    static UBYTE logical[BUFFER_SIZE];
+    bool swap = rotate == ROTATE_90 || rotate == ROTATE_270;
+    UWORD w = swap ? DISPLAY_HEIGHT : DISPLAY_WIDTH, h = swap ? DISPLAY_WIDTH : DISPLAY_HEIGHT;
+    UWORD widthByte = (w + 7) / 8;
+    Paint_NewImage(logical, w, h, ROTATE_0, WHITE);
+    Paint_Clear(WHITE);
+    draw(i);
+
+    memset(out, 0xFF, BUFFER_SIZE);
+    for (UWORD y = 0; y < h; y++) {
+        for (UWORD x = 0; x < w; x++) {
+            if (logical[y * widthByte + x / 8] & (0x80 >> (x % 8))) continue;
+            UWORD X, Y;
+            if (genericMap(x, y, rotate, mirror, &X, &Y))
+                out[Y * (DISPLAY_WIDTH / 8) + X / 8] &= ~(0x80 >> (X % 8));
+        }
+    }
+}
+
+static void benchRotations()
+{
+    printf("specialized writers by rotation (1 bpp), draw time\n");
+    struct Workload { const char *name; void (*draw)(int); int runs; } workloads[] = {
+        { "12 rows of Font24", drawText, 300 },
+        { "6-point polygons", drawPolygons, 300 },
+    };
+    const UWORD rotations[] = { ROTATE_0, ROTATE_90, ROTATE_180, ROTATE_270 };
+    const UBYTE mirrors[] = { MIRROR_NONE, MIRROR_HORIZONTAL, MIRROR_VERTICAL, MIRROR_ORIGIN };
+    static UBYTE image[BUFFER_SIZE], reference[BUFFER_SIZE];
+    uint32_t off = 0;
+
+    for (const Workload &w : workloads) {
+        printf("  %-18s", w.name);
+        for (UWORD rotate : rotations) {
+            Paint_NewImage(image, DISPLAY_WIDTH, DISPLAY_HEIGHT, rotate, WHITE);
+            Paint_Clear(WHITE);
+            double us = usPerRun(w.runs, [&](int i) { w.draw(i); });
+            printf("  %3d: %6.1f us", rotate, us);
+        }
+        printf("\n");
+
+        for (UWORD rotate : rotations) {
+            for (UBYTE mirror : mirrors) {
+                Paint_NewImage(image, DISPLAY_WIDTH, DISPLAY_HEIGHT, rotate, WHITE);
+                Paint_SetMirroring(mirror);
+                Paint_Clear(WHITE);
+                w.draw(7);
+                renderGeneric(w.draw, 7, rotate, mirror, reference);
+                off += bitDiff(image, reference, BUFFER_SIZE);
+            }
+        }
+    }
+    printf("  every rotation and mirror against the generic mapping: %u px off\n", off);
+    if (off) mismatches++;
+}
+
+// ========== Upright canvas ==========
+
+// Horizontal spans over the whole portrait screen
+static void portraitStripes(int i)
+{
+    for (int y = 0; y < 400; y++)
+        Paint_DrawHLine(0, y, 300, ((y + i) % 3) ? WHITE : BLACK);
+}
+
+static void portraitRegion(int i)
+{
+    Paint_DrawRectangle(40, 120, 104, 216, WHITE, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+    Paint_DrawRectangle(40, 120, 40 + (i % 64), 216, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+}
+
+static void portraitText(int i)
+{
+    Paint_Clear(WHITE);
+    char line[16];
+    for (int row = 0; row < 16; row++) {
+        snprintf(line, sizeof(line), "Row %02d %03d", row, i % 1000);
+        Paint_DrawString_EN(8, 8 + row * 24, line, &Font24, WHITE, BLACK);
+    }
+}
+
+// Lines and circles, only compared
+static void portraitMixed(int i)
+{
+    Paint_Clear(WHITE);
+    for (int k = 0; k < 12; k++)
+        Paint_DrawLine(5 + k * 7, 10, 290 - k * 11, 390 - k * 5, BLACK, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+    Paint_DrawCircle(150, 200, 90, BLACK, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
+    Paint_DrawCircle(150, 200, 40 + i % 20, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+}
+
+static void benchUpright()
+{
+    printf("ROTATE_270 drawing + refresh, direct against upright rendering on\n");
+    struct Workload { const char *name; void (*draw)(int); bool full; int runs; } workloads[] = {
+        { "full screen of spans", portraitStripes, true, 300 },
+        { "64x96 region fill", portraitRegion, false, 3000 },
+        { "16 rows of Font24", portraitText, true, 300 },
+    };
+    static UBYTE screens[2][BUFFER_SIZE];
+    uint32_t off = 0;
+
+    for (const Workload &w : workloads) {
+        double us[2];
+        bool canvas = false;
+        for (int upright = 0; upright < 2; upright++) {
+            host_reset();
+            WatcherDisplay display;
+            display.begin(false, ROTATE_270);
+            if (upright) display.setUprightRendering(true);
+            host_panel.decodeData = false;
+
+            us[upright] = usPerRun(w.runs, [&](int i) {
+                w.draw(i);
+                if (w.full) display.beginFullRefresh();
+                else display.commit();
+                display.waitForRefresh();
+            });
+            memcpy(screens[upright], display.getBuffer(), BUFFER_SIZE);
+            if (upright) canvas = display.isDrawingUpright();
+        }
+        printf("  %-22s direct %7.1f us, upright on %7.1f us (%.1fx), draws %s\n", w.name, us[0],
+               us[1], us[0] / us[1], canvas ? "upright" : "direct");
+        off += bitDiff(screens[0], screens[1], BUFFER_SIZE);
+    }
+
+    // Every workload, plus lines, circles and a sub-buffer, at 90 and 270
+    const Workload all[] = { workloads[0], workloads[1], workloads[2], { "mixed", portraitMixed, true, 1 } };
+    const UWORD rotations[] = { ROTATE_90, ROTATE_270 };
+    for (UWORD rotation : rotations) {
+        for (const Workload &w : all) {
+            for (int upright = 0; upright < 2; upright++) {
+                host_reset();
+                WatcherDisplay display;
+                display.begin(false, rotation);
+                if (upright) display.setUprightRendering(true);
+                w.draw(7);
+                UBYTE *sub = display.createSubBuffer(32, 48);
+                if (sub) {
+                    memset(sub, 0x5A, 4 * 48);
+                    display.copySubBuffer(sub, 0, 0, 32, 48, 200, 64);
+                    display.releaseSubBuffer(sub);
+                }
+                display.beginFullRefresh();
+                display.waitForRefresh();
+                memcpy(screens[upright], display.getBuffer(), BUFFER_SIZE);
+            }
+            off += bitDiff(screens[0], screens[1], BUFFER_SIZE);
+        }
+    }
+
+    // Workloads back to back, so the canvas switches both ways mid-session
+    const int sequence[] = { 0, 1, 2, 1, 0, 0, 3, 1, 0, 2, 1 };
+    for (UWORD rotation : rotations) {
+        for (int upright = 0; upright < 2; upright++) {
+            host_reset();
+            WatcherDisplay display;
+            display.begin(false, rotation);
+            if (upright) display.setUprightRendering(true);
+            for (int k = 0; k < (int)(sizeof(sequence) / sizeof(sequence[0])); k++) {
+                const Workload &w = all[sequence[k]];
+                w.draw(k);
+                if (w.full) display.beginFullRefresh();
+                else display.commit();
+                display.waitForRefresh();
+            }
+            memcpy(screens[upright], display.getBuffer(), BUFFER_SIZE);
+        }
+        off += bitDiff(screens[0], screens[1], BUFFER_SIZE);
+    }
+    printf("  screen buffers differ by %u px (timed cases, all at 90 and 270, and mixed sequences)\n", off);
+    if (off) mismatches++;
+}
+
+// ========== Curves ==========
+
+// drawArc, drawThickLine and drawBezier as WatcherDisplay had them in float
+
+static void floatArc(int16_t x, int16_t y, int16_t radius, int16_t startAngle, int16_t endAngle,
+                     UWORD color)
+{
+    while (startAngle < 0) startAngle += 360;
+    while (endAngle < 0) endAngle += 360;
+    startAngle %= 360;
+    endAngle %= 360;
+    if (endAngle < startAngle) endAngle += 360;
+
+    int16_t prevX = -1, prevY = -1;
+    for (int16_t angle = startAngle; angle <= endAngle; angle++) {
+        float rad = angle * PI / 180.0;
+        int16_t px = x + radius * cos(rad);
+        int16_t py = y - radius * sin(rad);
+        if (prevX != -1) Paint_DrawLine(prevX, prevY, px, py, color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+        prevX = px;
+        prevY = py;
+    }
+}
+
+static void floatThickLine(WatcherDisplay &display, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                           uint16_t thickness, UWORD color)
+{
+    int16_t dx = x1 - x0;
+    int16_t dy = y1 - y0;
+    float len = sqrt(dx * dx + dy * dy);
+    if (len == 0) return;
+
+    float offsetX = -dy * thickness / (2.0 * len);
+    float offsetY = dx * thickness / (2.0 * len);
+    uint16_t points[8] = {
+        (uint16_t)(x0 + offsetX), (uint16_t)(y0 + offsetY),
+        (uint16_t)(x0 - offsetX), (uint16_t)(y0 - offsetY),
+        (uint16_t)(x1 - offsetX), (uint16_t)(y1 - offsetY),
+        (uint16_t)(x1 + offsetX), (uint16_t)(y1 + offsetY)
+    };
+    display.drawPolygon(points, 4, color, true);
+}
+
+static void floatBezier(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
+                        UWORD color)
+{
+    uint16_t prevX = x0, prevY = y0;
+    for (float t = 0.0; t <= 1.0; t += 0.02) {
+        float t2 = t * t;
+        float mt = 1.0 - t;
+        float mt2 = mt * mt;
+        uint16_t x = mt2 * x0 + 2 * mt * t * x1 + t2 * x2;
+        uint16_t y = mt2 * y0 + 2 * mt * t * y1 + t2 * y2;
+        Paint_DrawLine(prevX, prevY, x, y, color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+        prevX = x;
+        prevY = y;
+    }
+}
+
+static void benchCurves()
+{
+    printf("arcs, thick lines and Bezier curves, old float code against the integer rasterizers\n");
+    host_reset();
+    WatcherDisplay display;
+    display.begin(false, ROTATE_0);
+    UBYTE *buffer = display.getBuffer();
+    static UBYTE old[BUFFER_SIZE];
+
+    struct Shape { const char *name; void (*before)(WatcherDisplay &); void (*after)(WatcherDisplay &); } shapes[] = {
+        { "arc r60 0-270",
+          [](WatcherDisplay &) { floatArc(200, 150, 60, 0, 270, BLACK); },
+          [](WatcherDisplay &d) { d.drawArc(200, 150, 60, 0, 270, BLACK); } },
+        { "thick line 200x80 w6",
+          [](WatcherDisplay &d) { floatThickLine(d, 100, 100, 300, 180, 6, BLACK); },
+          [](WatcherDisplay &d) { d.drawThickLine(100, 100, 300, 180, 6, BLACK); } },
+        { "bezier 20 px",
+          [](WatcherDisplay &) { floatBezier(100, 100, 110, 90, 120, 100, BLACK); },
+          [](WatcherDisplay &d) { d.drawBezier(100, 100, 110, 90, 120, 100, BLACK); } },
+        { "bezier 250 px",
+          [](WatcherDisplay &) { floatBezier(60, 250, 180, 20, 340, 240, BLACK); },
+          [](WatcherDisplay &d) { d.drawBezier(60, 250, 180, 20, 340, 240, BLACK); } },
+    };
+    for (const Shape &shape : shapes) {
+        double us[2];
+        for (int integer = 0; integer < 2; integer++) {
+            auto draw = integer ? shape.after : shape.before;
+            us[integer] = usPerRun(20000, [&](int) { draw(display); });
+        }
+        Paint_Clear(WHITE);
+        shape.before(display);
+        memcpy(old, buffer, BUFFER_SIZE);
+        Paint_Clear(WHITE);
+        shape.after(display);
+        printf("  %-22s float %6.2f us, integer %6.2f us (%.1fx), %4u px differ\n", shape.name,
+               us[0], us[1], us[0] / us[1], bitDiff(buffer, old, BUFFER_SIZE));
+    }
+
+    // A whole-turn arc is the circle, pixel for pixel
+    uint32_t off = 0;
+    for (UWORD r = 1; r < 60; r++) {
+        Paint_Clear(WHITE);
+        Paint_DrawCircle(200, 150, r, BLACK, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
+        memcpy(old, buffer, BUFFER_SIZE);
+        Paint_Clear(WHITE);
+        Paint_DrawArc(200, 150, r, 0, 360, BLACK);
+        off += bitDiff(buffer, old, BUFFER_SIZE);
+    }
+    printf("  Paint_DrawArc 0-360 against Paint_DrawCircle, r 1-59: %u px off\n", off);
+    if (off) mismatches++;
+}
+
+// ========== 4-gray conversion ==========
+
+// The original Display_4Gray conversion: an if/else per pixel, per plane
+static void referenceGrayPlane(const UBYTE *image, UBYTE *plane, bool high)
+{
+    for (uint32_t i = 0; i < BUFFER_SIZE; i++) {
+        UBYTE out = 0;
+        for (int j = 0; j < 2; j++) {
+            UBYTE in = image[i * 2 + j];
+            for (int k = 0; k < 4; k++) {
+                UBYTE pixel = in & 0xC0;
+                out <<= 1;
+                if (pixel == 0xC0)
+                    out |= 0x01;            // white
+                else if (pixel == 0x00)
+                    out |= 0x00;            // black
+                else if (pixel == 0x80)
+                    out |= high ? 0x01 : 0x00;  // gray1
+                else
+                    out |= high ? 0x00 : 0x01;  // gray2
+                in <<= 2;
+            }
+        }
+        plane[i] = out;
+    }
+}
+
+static void benchGray()
+{
+    printf("4-gray frame conversion\n");
+    host_reset();
+    DEV_Module_Init();
+    EPD_4IN2_V2_Init();
+
+    static UBYTE gray[GRAY_BUFFER_SIZE], plane24[BUFFER_SIZE], plane26[BUFFER_SIZE];
+    srand(21);
+    for (uint32_t i = 0; i < sizeof(gray); i++) gray[i] = (UBYTE)rand();
+
+    const int runs = 300;
+    double reference = usPerRun(runs, [&](int i) {
+        referenceGrayPlane(gray, plane24, false);
+        referenceGrayPlane(gray, plane26, true);
+    });
+    host_panel.decodeData = false;
+    double tables = usPerRun(runs, [&](int i) { EPD_4IN2_V2_Display_4Gray(gray); });
+    host_panel.decodeData = true;
+
+    DEV_SPI_ResetStats();
+    EPD_4IN2_V2_Display_4Gray(gray);
+    DEV_SPI_STATS stats = DEV_SPI_GetStats();
+
+    printf("  per-pixel if/else (convert only)   %8.1f us\n", reference);
+    printf("  Display_4Gray (convert + stream)   %8.1f us  (%.1fx)\n", tables, reference / tables);
+    printf("  %lu bytes in %lu SPI transactions\n",
+           (unsigned long)stats.bytes, (unsigned long)stats.transactions);
+
+    uint32_t off = bitDiff(host_panel.ram24, plane24, BUFFER_SIZE) +
+                   bitDiff(host_panel.ram26, plane26, BUFFER_SIZE);
+    printf("  planes differ from the original by %u px\n", off);
+    if (off) mismatches++;
+}
+
+int main()
+{
+    benchDigits();
+    printf("\n");
+    benchFills();
+    printf("\n");
+    benchRotations();
+    printf("\n");
+    benchUpright();
+    printf("\n");
+    benchCurves();
+    printf("\n");
+    benchGray();
+    if (mismatches) printf("\nbench_render: %d outputs differ\n", mismatches);
+    return mismatches ? 1 : 0;
+}
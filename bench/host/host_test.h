@@ -0,0 +1,36 @@
+/*
+ * host_test.h - Minimal check macros for the host tests
+ */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+
+static int host_failures = 0;
+static int host_checks = 0;
+
+#define CHECK(cond) do { \
+    host_checks++; \
+    if (!(cond)) { \
+        host_failures++; \
+        printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+    } \
+} while (0)
+
+#define CHECK_EQ(a, b) do { \
+    host_checks++; \
+    long long _a = (long long)(a), _b = (long long)(b); \
+    if (_a != _b) { \
+        host_failures++; \
+        printf("  FAIL %s:%d: %s == %s (%lld vs %lld)\n", __FILE__, __LINE__, #a, #b, _a, _b); \
+    } \
+} while (0)
+
+static inline int host_test_summary(const char *name)
+{
+    printf("%s: %d checks, %d failed\n", name, host_checks, host_failures);
+    return host_failures ? 1 : 0;
+}
+
+#endif
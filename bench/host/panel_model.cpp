@@ -0,0 +1,255 @@
+/*
+ * panel_model.cpp - Controller model behind the host SPI and GPIO stubs
+ */
+
+#include "panel_model.h"
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <Wire.h>
+#include "DEV_Config.h"
+
+HardwareSerial Serial;
+SPIClass SPI;
+TwoWire Wire;
+
+int host_pins[64];
+unsigned long host_millis;
+
+HostPanel host_panel;
+
+static unsigned long busyUntil;
+static uint8_t command;
+static uint16_t paramIndex;
+static uint8_t params[8];
+static unsigned long burstBytes;
+
+// Survives host_reset(): DEV_Config attaches its ISR only once
+static void (*busyIsr)(void);
+static int busyIsrMode;
+
+static void registerDefaults()
+{
+    HostPanel &p = host_panel;
+    p.xStart = 0;
+    p.xEnd = HOST_PANEL_WIDTH_BYTES - 1;
+    p.yStart = 0;
+    p.yEnd = HOST_PANEL_HEIGHT - 1;
+    p.xCount = 0;
+    p.yCount = 0;
+    p.entryMode = 0x03;
+    p.updateControl[0] = 0x00;
+    p.updateControl[1] = 0x00;
+    p.border = 0xC0;
+    p.sequence = 0xFF;
+}
+
+void host_reset()
+{
+    memset(&host_panel, 0, sizeof(host_panel));
+    memset(host_panel.shown, 0xFF, sizeof(host_panel.shown));
+    registerDefaults();
+    host_panel.decodeData = true;
+    memset(host_pins, 0, sizeof(host_pins));
+    host_pins[EPD_CS_PIN] = HIGH;
+    host_millis = 0;
+    busyUntil = 0;
+    command = 0;
+    paramIndex = 0;
+    burstBytes = 0;
+}
+
+void host_advance(unsigned long ms)
+{
+    unsigned long before = host_millis;
+    host_millis += ms;
+    bool fell = before < busyUntil && host_millis >= busyUntil;
+    if (fell && busyIsr && (busyIsrMode == FALLING || busyIsrMode == CHANGE)) busyIsr();
+}
+
+void host_attach_interrupt(int pin, void (*isr)(void), int mode)
+{
+    if (pin != EPD_BUSY_PIN) return;
+    busyIsr = isr;
+    busyIsrMode = mode;
+}
+
+int host_digital_read(int pin)
+{
+    if (pin == EPD_BUSY_PIN) return host_millis < busyUntil ? HIGH : LOW;
+    return host_pins[pin];
+}
+
+void host_digital_write(int pin, int value)
+{
+    if (pin == EPD_CS_PIN && value != host_pins[pin]) {
+        if (value == LOW) {
+            host_panel.bursts++;
+            burstBytes = 0;
+        } else if (burstBytes > host_panel.longestBurst) {
+            host_panel.longestBurst = burstBytes;
+        }
+    }
+    if (pin == EPD_RST_PIN && value == LOW) {
+        registerDefaults();
+    }
+    host_pins[pin] = value;
+}
+
+// ========== Waveforms ==========
+
+static void startWaveform()
+{
+    HostPanel &p = host_panel;
+    unsigned long ms;
+
+    switch (p.sequence) {
+    case 0xF7:
+    case 0xC7:
+        ms = (p.sequence == 0xF7) ? HOST_FULL_MS : HOST_FAST_MS;
+        if (p.updateControl[0] != 0x40 || p.border != 0x05) p.fullWithPartialRegs++;
+        memcpy(p.shown, p.ram24, HOST_PANEL_BYTES);
+        p.shownGray = false;
+        break;
+    case 0xFF:
+        ms = HOST_PARTIAL_MS;
+        for (uint32_t i = 0; i < HOST_PANEL_BYTES; i++) {
+            uint8_t driven = p.ram24[i] ^ p.ram26[i];
+            p.shown[i] = (p.shown[i] & ~driven) | (p.ram24[i] & driven);
+        }
+        break;
+    case 0xCF:
+        ms = HOST_GRAY_MS;
+        p.shownGray = true;
+        break;
+    default:
+        // 0x91 / 0xB1: temperature and LUT loads, nothing on the glass
+        ms = HOST_LUT_LOAD_MS;
+        break;
+    }
+
+    p.waveforms[p.sequence]++;
+    p.busyMs += ms;
+    busyUntil = p.busyStuck ? (unsigned long)-1 : host_millis + ms;
+}
+
+// ========== RAM writes ==========
+
+static void writeRam(uint8_t *ram, uint8_t value)
+{
+    HostPanel &p = host_panel;
+    if (p.xCount < HOST_PANEL_WIDTH_BYTES && p.yCount < HOST_PANEL_HEIGHT) {
+        ram[p.yCount * HOST_PANEL_WIDTH_BYTES + p.xCount] = value;
+    }
+
+    // Data entry mode 0x03: X increments first, wraps inside the window
+    if (p.xCount >= p.xEnd) {
+        p.xCount = p.xStart;
+        p.yCount = (p.yCount >= p.yEnd) ? p.yStart : p.yCount + 1;
+    } else {
+        p.xCount++;
+    }
+}
+
+static void commandByte(uint8_t value)
+{
+    command = value;
+    paramIndex = 0;
+
+    switch (value) {
+    case 0x12:
+        registerDefaults();
+        host_panel.busyMs += HOST_RESET_MS;
+        busyUntil = host_millis + HOST_RESET_MS;
+        break;
+    case 0x20:
+        startWaveform();
+        break;
+    }
+}
+
+static void dataByte(uint8_t value)
+{
+    HostPanel &p = host_panel;
+    if (paramIndex < sizeof(params)) params[paramIndex] = value;
+    paramIndex++;
+
+    switch (command) {
+    case 0x11:
+        p.entryMode = value;
+        break;
+    case 0x21:
+        if (paramIndex <= 2) p.updateControl[paramIndex - 1] = value;
+        break;
+    case 0x22:
+        p.sequence = value;
+        break;
+    case 0x3C:
+        p.border = value;
+        break;
+    case 0x44:
+        if (paramIndex == 1) p.xStart = value;
+        if (paramIndex == 2) p.xEnd = value;
+        break;
+    case 0x45:
+        if (paramIndex == 2) p.yStart = params[0] | (params[1] << 8);
+        if (paramIndex == 4) p.yEnd = params[2] | (params[3] << 8);
+        break;
+    case 0x4E:
+        p.xCount = value;
+        break;
+    case 0x4F:
+        if (paramIndex == 2) p.yCount = params[0] | (params[1] << 8);
+        break;
+    case 0x24:
+        writeRam(p.ram24, value);
+        break;
+    case 0x26:
+        writeRam(p.ram26, value);
+        break;
+    }
+}
+
+void host_spi_bytes(const uint8_t *data, size_t len)
+{
+    host_panel.bytes += len;
+    burstBytes += len;
+    if (host_pins[EPD_CS_PIN] != LOW) return;
+    if (!host_panel.decodeData && host_pins[EPD_DC_PIN] == HIGH &&
+        (command == 0x24 || command == 0x26)) return;
+
+    for (size_t i = 0; i < len; i++) {
+        if (host_pins[EPD_DC_PIN] == LOW) {
+            commandByte(data[i]);
+        } else {
+            dataByte(data[i]);
+        }
+    }
+}
+
+// ========== Checks ==========
+
+static uint32_t bitDiff(const uint8_t *a, const uint8_t *b)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < HOST_PANEL_BYTES; i++) {
+        count += __builtin_popcount((uint8_t)(a[i] ^ b[i]));
+    }
+    return count;
+}
+
+uint32_t host_shown_diff(const uint8_t *frame)
+{
+    return bitDiff(host_panel.shown, frame);
+}
+
+uint32_t host_ram_diff(uint8_t reg, const uint8_t *frame)
+{
+    return bitDiff(reg == 0x26 ? host_panel.ram26 : host_panel.ram24, frame);
+}
+
+unsigned long host_waveform_total()
+{
+    const unsigned long *w = host_panel.waveforms;
+    return w[0xF7] + w[0xC7] + w[0xFF] + w[0xCF];
+}
@@ -0,0 +1,79 @@
+/*
+ * panel_model.h - Host model of the 4.2" V2 controller (SSD1683 command set)
+ *
+ * Decodes the SPI stream the way the controller does: DC low is a command,
+ * DC high is its data. Keeps both RAMs with the window, cursor and X-first
+ * wrap of data entry mode 0x03, runs BUSY for as long as each waveform
+ * takes, and keeps a copy of what the panel shows:
+ *   full  (0x22 = 0xF7 / 0xC7) - every pixel takes RAM 0x24
+ *   partial (0xFF)             - pixels where 0x24 differs from 0x26 take 0x24,
+ *                                the rest keep what they showed
+ * so anything that leaves the RAMs out of step with the panel turns up as
+ * shown pixels that differ from the frame buffer.
+ */
+
+#ifndef HOST_PANEL_MODEL_H
+#define HOST_PANEL_MODEL_H
+
+#include <stdint.h>
+
+#define HOST_PANEL_WIDTH_BYTES 50
+#define HOST_PANEL_HEIGHT      300
+#define HOST_PANEL_BYTES       (HOST_PANEL_WIDTH_BYTES * HOST_PANEL_HEIGHT)
+
+// Simulated waveform lengths (BUSY high), in ms
+#define HOST_FULL_MS     3000
+#define HOST_FAST_MS     1500
+#define HOST_PARTIAL_MS  400
+#define HOST_GRAY_MS     3000
+#define HOST_LUT_LOAD_MS 100
+#define HOST_RESET_MS    10
+
+struct HostPanel {
+    uint8_t ram24[HOST_PANEL_BYTES];   // New image
+    uint8_t ram26[HOST_PANEL_BYTES];   // Old image (partial), red bypassed (full)
+    uint8_t shown[HOST_PANEL_BYTES];   // What the panel shows after the last waveform
+    bool shownGray;                    // Last waveform was 4-gray, shown[] is stale
+
+    // Controller registers
+    uint8_t xStart, xEnd, xCount;      // RAM X in bytes
+    uint16_t yStart, yEnd, yCount;
+    uint8_t entryMode;
+    uint8_t updateControl[2];          // 0x21
+    uint8_t border;                    // 0x3C
+    uint8_t sequence;                  // 0x22
+
+    bool busyStuck;                    // Waveforms started now never drop BUSY
+
+    // Decode RAM data (commands and BUSY always run); the benchmarks turn
+    // it off so they time the code under test, not the model
+    bool decodeData;
+
+    // Counters
+    unsigned long waveforms[256];      // Activations (0x20) by 0x22 value
+    unsigned long busyMs;              // Total BUSY time
+    unsigned long fullWithPartialRegs; // Full waveforms run with 0x21/0x3C left in partial mode
+    unsigned long bytes;               // Bytes clocked out
+    unsigned long bursts;              // CS low periods
+    unsigned long longestBurst;        // Most bytes in one CS low period
+};
+
+extern HostPanel host_panel;
+
+// Power-on state for the panel and the clock
+void host_reset();
+
+// Let time pass (the code under test only advances it through delay()).
+// BUSY falling on the way fires an interrupt attached to the BUSY pin.
+void host_advance(unsigned long ms);
+
+// Panel pixels that differ from a 1bpp frame buffer
+uint32_t host_shown_diff(const uint8_t *frame);
+
+// RAM pixels that differ from a 1bpp frame buffer (reg 0x24 or 0x26)
+uint32_t host_ram_diff(uint8_t reg, const uint8_t *frame);
+
+// Waveforms run since host_reset(): full + fast + partial + 4-gray
+unsigned long host_waveform_total();
+
+#endif
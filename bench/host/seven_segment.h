@@ -0,0 +1,45 @@
+/*
+ * seven_segment.h - The pomodoro 7-segment digits, as src/pomodoro.cpp
+ * draws them with Paint_DrawPolygon
+ */
+
+#ifndef HOST_SEVEN_SEGMENT_H
+#define HOST_SEVEN_SEGMENT_H
+
+#include "GUI_Paint.h"
+
+#define DIGIT_WIDTH   70
+#define DIGIT_HEIGHT  130
+
+// Segment outlines A-G, relative to the digit
+static const int16_t SEG_X[7][7] = {
+    { 1, 70, 57, 13, 1 }, { 70, 70, 59, 59, 70 }, { 70, 70, 59, 59, 70 },
+    { 67, 3, 13, 57, 67 }, { 0, 0, 11, 11, 0 }, { 0, 0, 11, 11, 0 },
+    { 11, 59, 69, 59, 11, 2, 11 },
+};
+static const int16_t SEG_Y[7][7] = {
+    { 0, 0, 11, 11, 0 }, { 3, 64, 57, 13, 3 }, { 67, 129, 118, 73, 67 },
+    { 130, 130, 119, 119, 130 }, { 129, 66, 73, 117, 129 }, { 64, 3, 13, 57, 64 },
+    { 60, 60, 65, 70, 70, 65, 60 },
+};
+static const UWORD SEG_POINTS[7] = { 5, 5, 5, 5, 5, 5, 7 };
+
+// Segments A-G (bit 0-6) lit for each digit
+static const uint8_t DIGIT_SEGMENTS[10] = {
+    0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F,
+};
+
+static void drawDigitPolygons(int16_t x, int16_t y, uint8_t digit)
+{
+    for (uint8_t s = 0; s < 7; s++) {
+        if (!(DIGIT_SEGMENTS[digit] & (1 << s))) continue;
+        int16_t xs[7], ys[7];
+        for (UWORD i = 0; i < SEG_POINTS[s]; i++) {
+            xs[i] = x + SEG_X[s][i];
+            ys[i] = y + SEG_Y[s][i];
+        }
+        Paint_DrawPolygon(xs, ys, SEG_POINTS[s], BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+    }
+}
+
+#endif
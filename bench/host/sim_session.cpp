@@ -0,0 +1,545 @@
+/*
+ * sim_session.cpp - A 25 minute pomodoro session against the panel model
+ *
+ * Replays the src/pomodoro.cpp screen (digits from flash, the 60 square
+ * ring, the start button) for one session with a 30 s pause at minute 12,
+ * and reports what each refresh setup costs on the panel:
+ *   - refresh policies: waveforms run, BUSY time and the peak ghosting
+ *     weighed with the default GhostBudgetPolicy yardstick
+ *   - tile cleaning against the fixed full refresh interval
+ *   - inline against deferred maintenance: cleans or fulls that start in
+ *     the middle of the countdown instead of just after the ring wraps
+ *   - updateChanged() every loop against markDirty() + serviceUpdates()
+ *   - window planning: the rects each drawing call records, refreshed
+ *     one partial per rect (pomodoro before flush()) against
+ *     planRegions() + one flush() per tick, by the cost model estimate,
+ *     BUSY time and bytes on the bus
+ * Every run must end with the panel showing the frame buffer.
+ */
+
+#include "panel_model.h"
+
+#include "WatcherDisplay.h"
+#include "pomodoro_assets.h"
+
+#define DIGIT_WIDTH   70
+#define DIGIT_HEIGHT  130
+#define TENS_X        122
+#define TENS_Y        85
+#define ONES_X        207
+#define ONES_Y        85
+#define PROGRESS_SIZE 10
+#define BORDER_X      59
+#define BORDER_Y      49
+#define BORDER_W      282
+#define BORDER_H      202
+#define BUTTON_Y      265
+#define BTN_START_X   20
+
+#define SESSION_MINUTES 25
+#define PAUSE_AT_S      (12 * 60)
+#define PAUSE_MS        30000
+#define LOOP_MS         50
+
+struct Setup {
+    const char *name;
+    RefreshPolicy *policy;
+    bool differential;
+    uint8_t fullInterval;   // With differential refresh
+    bool tiles;
+    bool deferred;
+    bool coalesce;          // markDirty() + serviceUpdates() instead of updateChanged()
+};
+
+struct Result {
+    unsigned long partials, fasts, fulls, cleans;
+    unsigned long midCountdown;   // Cleans/fulls started away from a ring wrap
+    unsigned long busyMs, runMs;
+    unsigned long maxTickLag;     // Tick due until its update started
+    uint32_t peakGhost, peakTileFlips;
+    bool inSync;
+};
+
+// ========== The pomodoro screen ==========
+
+static WatcherDisplay *display;
+static struct { uint16_t x, y; } squares[60];
+static uint16_t remaining, elapsed;
+static uint8_t lastTens, lastOnes, lastSecond;
+static bool running;
+
+static void calculateSquarePositions()
+{
+    uint8_t idx = 0;
+    for (uint8_t i = 0; i < 18; i++) squares[idx++] = { (uint16_t)(BORDER_X + i * 16), BORDER_Y };
+    for (uint8_t i = 1; i <= 12; i++)
+        squares[idx++] = { BORDER_X + BORDER_W - PROGRESS_SIZE, (uint16_t)(BORDER_Y + i * 16) };
+    for (uint8_t i = 0; i < 18; i++)
+        squares[idx++] = { (uint16_t)(BORDER_X + BORDER_W - PROGRESS_SIZE - i * 16),
+                           BORDER_Y + BORDER_H - PROGRESS_SIZE };
+    for (uint8_t i = 1; i <= 12; i++)
+        squares[idx++] = { BORDER_X, (uint16_t)(BORDER_Y + BORDER_H - PROGRESS_SIZE - i * 16) };
+}
+
+static void drawSquare(uint8_t i, bool filled)
+{
+    Paint_DrawRectangle(squares[i].x, squares[i].y, squares[i].x + PROGRESS_SIZE,
+                        squares[i].y + PROGRESS_SIZE, BLACK, DOT_PIXEL_1X1,
+                        filled ? DRAW_FILL_FULL : DRAW_FILL_EMPTY);
+}
+
+static void drawButton()
+{
+    Paint_DrawRectangle(BTN_START_X - 4, BUTTON_Y - 4, BTN_START_X + 80, BUTTON_Y + 22,
+                        WHITE, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+    Paint_DrawString_EN(BTN_START_X, BUTTON_Y, running ? "PAUSE" : "START", &Font16, WHITE, BLACK);
+}
+
+static void drawFullScreen()
+{
+    uint8_t minutes = remaining / 60;
+    Paint_Clear(WHITE);
+    Paint_DrawString_EN(130, 15, "POMODORO", &Font20, WHITE, BLACK);
+    display->drawAsset(TENS_X, TENS_Y, ASSET_DIGITS[minutes / 10], BLACK);
+    display->drawAsset(ONES_X, ONES_Y, ASSET_DIGITS[minutes % 10], BLACK);
+    for (uint8_t i = 0; i < 60; i++) drawSquare(i, i < elapsed % 60);
+    drawButton();
+    Paint_DrawString_EN(160, BUTTON_Y, "MODE", &Font16, WHITE, BLACK);
+    Paint_DrawString_EN(290, BUTTON_Y, "RESET", &Font16, WHITE, BLACK);
+    display->fullRefresh();
+    lastTens = minutes / 10;
+    lastOnes = minutes % 10;
+    lastSecond = 255;
+}
+
+static void updateDigits()
+{
+    uint8_t minutes = remaining / 60, tens = minutes / 10, ones = minutes % 10;
+    if (tens == lastTens && ones == lastOnes) return;
+    Paint_DrawRectangle(TENS_X - 8, TENS_Y - 8, TENS_X + DIGIT_WIDTH + 8, TENS_Y + DIGIT_HEIGHT + 8,
+                        WHITE, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+    Paint_DrawRectangle(ONES_X - 8, ONES_Y - 8, ONES_X + DIGIT_WIDTH + 8, ONES_Y + DIGIT_HEIGHT + 8,
+                        WHITE, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+    display->drawAsset(TENS_X, TENS_Y, ASSET_DIGITS[tens], BLACK);
+    display->drawAsset(ONES_X, ONES_Y, ASSET_DIGITS[ones], BLACK);
+    lastTens = tens;
+    lastOnes = ones;
+}
+
+static void updateProgressSquares()
+{
+    uint8_t second = elapsed % 60;
+    if (second == lastSecond) return;
+    for (uint8_t i = 0; i < 60; i++) {
+        Paint_DrawRectangle(squares[i].x, squares[i].y, squares[i].x + PROGRESS_SIZE,
+                            squares[i].y + PROGRESS_SIZE, WHITE, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+    }
+    for (uint8_t i = 0; i < 60; i++) drawSquare(i, i < second);
+    lastSecond = second;
+}
+
+// ========== Instrumentation ==========
+
+static GhostBudgetPolicy yardstick;
+static uint32_t ghost, deepGhost, peakGhost;
+
+// Ghosting as the default GhostBudgetPolicy weighs it, whatever policy runs
+static void traceGhost(const RefreshDecision &decision, void *context)
+{
+    if (decision.waveform == WAVEFORM_PARTIAL) {
+        ghost += yardstick.weigh(decision.update);
+    } else if (decision.waveform == WAVEFORM_FAST_FULL) {
+        deepGhost += ghost / DEFAULT_FAST_FULL_RESIDUE;
+        ghost = 0;
+    } else {
+        ghost = deepGhost = 0;
+    }
+    if (ghost + deepGhost > peakGhost) peakGhost = ghost + deepGhost;
+}
+
+static unsigned long cleans, midCountdown, lastWrap;
+
+// Called when a refresh ends; a clean or full that started more than a
+// tick after the last ring wrap interrupted the countdown
+static void countCleans(RefreshResult result, RefreshState kind, void *context)
+{
+    if (kind != REFRESH_CLEAN_RUNNING && kind != REFRESH_FULL_RUNNING) return;
+    unsigned long ms = kind == REFRESH_CLEAN_RUNNING ? 2 * HOST_PARTIAL_MS
+                     : host_panel.sequence == 0xC7 ? HOST_FAST_MS : HOST_FULL_MS;
+    if (running && millis() - ms - lastWrap > 1100) midCountdown++;
+    if (kind == REFRESH_CLEAN_RUNNING) cleans++;
+}
+
+// ========== Session ==========
+
+static bool allInSync = true;
+
+// The session in real time: a tick a second, updateChanged() or serviceUpdates()
+// every loop
+static Result runSession(const Setup &setup)
+{
+    host_reset();
+    WatcherDisplay d;
+    display = &d;
+    d.begin(false, ROTATE_0);
+    if (setup.differential) d.setDifferentialRefresh(true, setup.fullInterval);
+    if (setup.tiles) d.setTileCleaning(true);
+    if (setup.deferred) d.setDeferredMaintenance(true);
+    if (setup.policy) {
+        setup.policy->setTraceCallback(traceGhost);
+        d.setRefreshPolicy(setup.policy);
+    }
+    d.setRefreshCallback(countCleans);
+    calculateSquarePositions();
+
+    remaining = SESSION_MINUTES * 60;
+    elapsed = 0;
+    running = false;
+    drawFullScreen();
+    d.waitForRefresh();
+
+    Result r = {};
+    unsigned long start[256];
+    memcpy(start, host_panel.waveforms, sizeof(start));
+    unsigned long busy = host_panel.busyMs;
+    ghost = deepGhost = peakGhost = 0;
+    cleans = midCountdown = lastWrap = 0;
+
+    running = true;
+    drawButton();
+    if (setup.coalesce) d.markDirty(LATENCY_INTERACTIVE_MS);
+
+    unsigned long lastTick = millis(), lastLoop = millis(), tickDue = 0;
+    bool paused = false, tickPending = false;
+
+    while (remaining > 0 || running) {
+        d.poll();
+        unsigned long now = millis();
+        if (running) r.runMs += now - lastLoop;
+        lastLoop = now;
+
+        if (!paused && running && elapsed == PAUSE_AT_S) {
+            running = false;
+            paused = true;
+            lastTick = now;
+            drawButton();
+            if (setup.coalesce) d.markDirty(LATENCY_INTERACTIVE_MS);
+        } else if (paused && !running && now - lastTick >= PAUSE_MS) {
+            running = true;
+            lastTick = now;
+            drawButton();
+            if (setup.coalesce) d.markDirty(LATENCY_INTERACTIVE_MS);
+        }
+
+        if (running && now - lastTick >= 1000) {
+            if (!tickPending) tickDue = now;
+            lastTick = now;
+            if (remaining > 0) {
+                remaining--;
+                elapsed++;
+                updateDigits();
+                updateProgressSquares();
+                // Squares 29 and 30 share the corner, so not every tick
+                // changes the frame
+                UIRegion changed;
+                if (d.findChangedRegions(&changed, 1)) tickPending = true;
+                bool wrapped = elapsed % 60 == 0;
+                if (wrapped) {
+                    d.declareIdleWindow(1000);
+                    lastWrap = now;
+                }
+                if (setup.coalesce)
+                    d.markDirty(wrapped ? LATENCY_INTERACTIVE_MS : LATENCY_PROGRESS_MS);
+            } else {
+                running = false;
+                drawButton();
+                if (setup.coalesce) d.markDirty(LATENCY_INTERACTIVE_MS);
+            }
+        }
+
+        bool started = setup.coalesce ? d.serviceUpdates() : d.updateChanged();
+        if (started && tickPending) {
+            tickPending = false;
+            if (millis() - tickDue > r.maxTickLag) r.maxTickLag = millis() - tickDue;
+        }
+
+        d.setIdle(!running);
+        if (setup.deferred || !d.poll()) d.maintainDisplay();
+
+        for (uint8_t ty = 0; ty < GHOST_TILES_Y; ty++)
+            for (uint8_t tx = 0; tx < GHOST_TILES_X; tx++)
+                if (d.getGhostTile(tx, ty).flips > r.peakTileFlips)
+                    r.peakTileFlips = d.getGhostTile(tx, ty).flips;
+
+        delay(LOOP_MS);
+        if (!running && remaining == 0) break;
+    }
+    // Show the final button
+    d.waitForRefresh();
+    if (setup.coalesce) {
+        while (d.hasPendingUpdates()) {
+            d.serviceUpdates();
+            delay(LOOP_MS);
+        }
+    } else {
+        d.updateChanged();
+    }
+    d.waitForRefresh();
+
+    // A clean is two partial waveforms (inverted, then the image)
+    r.cleans = cleans;
+    r.midCountdown = midCountdown;
+    r.partials = host_panel.waveforms[0xFF] - start[0xFF] - 2 * cleans;
+    r.fasts = host_panel.waveforms[0xC7] - start[0xC7];
+    r.fulls = host_panel.waveforms[0xF7] - start[0xF7];
+    r.busyMs = host_panel.busyMs - busy;
+    r.peakGhost = peakGhost;
+    r.inSync = host_shown_diff(d.getBuffer()) == 0;
+    if (setup.policy) setup.policy->setTraceCallback(nullptr);
+    return r;
+}
+
+static Result run(const Setup &setup)
+{
+    Result r = runSession(setup);
+    if (!r.inSync) {
+        printf("  %s: panel out of sync with the frame buffer\n", setup.name);
+        allInSync = false;
+    }
+    return r;
+}
+
+static void reportPolicies()
+{
+    printf("refresh policies (differential, updateChanged per loop)\n");
+    IntervalRefreshPolicy never(0), every5(5), every60(60);
+    GhostBudgetPolicy budget, budget25(25000), budget12(12280);
+    const Setup setups[] = {
+        { "no cleaning", &never, true, 0, false, false, false },
+        { "interval 5", &every5, true, 0, false, false, false },
+        { "interval 60", &every60, true, 0, false, false, false },
+        { "ghost budget 60000", &budget, true, 0, false, false, false },
+        { "ghost budget 25000", &budget25, true, 0, false, false, false },
+        { "ghost budget 12280", &budget12, true, 0, false, false, false },
+    };
+    for (const Setup &s : setups) {
+        Result r = run(s);
+        printf("  %-20s partial %4lu fast %3lu full %3lu | BUSY %6.1f s | peak ghost %6u\n",
+               s.name, r.partials, r.fasts, r.fulls, r.busyMs / 1000.0, r.peakGhost);
+    }
+}
+
+static void reportTiles()
+{
+    printf("tile cleaning (differential, updateChanged per loop)\n");
+    const Setup setups[] = {
+        { "interval 60", nullptr, true, 60, false, false, false },
+        { "tile cleaning", nullptr, true, 0, true, false, false },
+    };
+    for (const Setup &s : setups) {
+        Result r = run(s);
+        printf("  %-20s partial %4lu full %3lu cleans %3lu | BUSY %6.1f s | peak tile flips %5u\n",
+               s.name, r.partials, r.fulls, r.cleans, r.busyMs / 1000.0, r.peakTileFlips);
+    }
+}
+
+static void reportMaintenance()
+{
+    printf("maintenance timing\n");
+    const Setup setups[] = {
+        { "tiles, inline", nullptr, true, 0, true, false, false },
+        { "tiles, deferred", nullptr, true, 0, true, true, false },
+        { "interval 60, inline", nullptr, true, 60, false, false, false },
+        { "interval 60, deferred", nullptr, true, 60, false, true, false },
+    };
+    for (const Setup &s : setups) {
+        Result r = run(s);
+        printf("  %-22s fulls %2lu cleans %2lu | mid-countdown %2lu | max tick lag %5lu ms\n",
+               s.name, r.fulls, r.cleans, r.midCountdown, r.maxTickLag);
+    }
+}
+
+static void reportScheduling()
+{
+    printf("update scheduling (differential, tiles, deferred)\n");
+    const Setup setups[] = {
+        { "updateChanged per loop", nullptr, true, 0, true, true, false },
+        { "markDirty + service", nullptr, true, 0, true, true, true },
+    };
+    for (const Setup &s : setups) {
+        Result r = run(s);
+        printf("  %-23s partials %4lu (%.1f per running minute) | max tick lag %4lu ms | BUSY %6.1f s\n",
+               s.name, r.partials, r.partials / (r.runMs / 60000.0), r.maxTickLag,
+               r.busyMs / 1000.0);
+    }
+}
+
+// ========== Window planning ==========
+
+// A tick's dirty set: the rects each drawing call recorded, in call order,
+// the way pomodoro refreshed them one partialRefresh() per call before
+// flush() and commit()
+struct DirtySet {
+    UIRegion regions[3 * PAINT_MAX_DIRTY];
+    uint8_t count;
+    uint8_t kind;           // SET_* of the calls that drew
+};
+
+enum { SET_RING = 0, SET_DIGITS = 1, SET_BUTTON = 2, SET_KINDS = 4 };
+static const char *SET_NAMES[SET_KINDS] = {
+    "ring", "digits + ring", "button + ring", "digits + button + ring",
+};
+
+struct PlanResult {
+    unsigned long sets, regions, refreshes, windows;
+    uint64_t estimateUs;
+    unsigned long busyMs, bytes;
+};
+
+// Append what was drawn since the last call to the set
+static void recordCall(DirtySet &set, uint8_t kind)
+{
+    const PAINT_RECT *rects;
+    uint8_t count = Paint_GetDirtyRects(&rects);
+    for (uint8_t i = 0; i < count; i++) {
+        set.regions[set.count++] = UIRegion(rects[i].X1, rects[i].Y1, rects[i].X2 - rects[i].X1 + 1,
+                                            rects[i].Y2 - rects[i].Y1 + 1);
+    }
+    if (count) set.kind |= kind;
+    Paint_ClearDirty();
+}
+
+static void refreshSet(const DirtySet &set, bool planned, PlanResult *byKind)
+{
+    WatcherDisplay &d = *display;
+    unsigned long busy = host_panel.busyMs, bytes = host_panel.bytes;
+    PlanResult &r = byKind[set.kind];
+    r.sets++;
+    r.regions += set.count;
+    if (planned) {
+        UIRegion windows[MAX_QUEUED_REGIONS];
+        uint8_t n = d.planRegions(set.regions, set.count, windows);
+        r.estimateUs += d.estimateCost(windows, n);
+        r.windows += n;
+        r.refreshes++;
+        for (uint8_t i = 0; i < set.count; i++) d.queueRegion(set.regions[i]);
+        d.flush();
+        d.waitForRefresh();
+    } else {
+        for (uint8_t i = 0; i < set.count; i++) {
+            r.estimateUs += d.estimateCost(&set.regions[i], 1);
+            r.windows++;
+            r.refreshes++;
+            d.partialRefresh(set.regions[i]);
+        }
+    }
+    r.busyMs += host_panel.busyMs - busy;
+    r.bytes += host_panel.bytes - bytes;
+}
+
+// The session, refreshing each tick's dirty set naively or planned.
+// Returns whether the panel ended up showing the frame buffer.
+static bool runPlanning(bool planned, PlanResult *byKind)
+{
+    host_reset();
+    WatcherDisplay d;
+    display = &d;
+    d.begin(false, ROTATE_0);
+    d.setDifferentialRefresh(true, 0);
+    d.setCostCalibration(false);
+    calculateSquarePositions();
+
+    remaining = SESSION_MINUTES * 60;
+    elapsed = 0;
+    running = false;
+    drawFullScreen();
+    Paint_ClearDirty();
+
+    DirtySet set = {};
+    running = true;
+    drawButton();
+    recordCall(set, SET_BUTTON);
+    while (remaining > 0) {
+        remaining--;
+        elapsed++;
+        updateDigits();
+        recordCall(set, SET_DIGITS);
+        updateProgressSquares();
+        recordCall(set, SET_RING);
+        if (elapsed == PAUSE_AT_S || remaining == 0) {
+            running = false;
+            drawButton();
+            recordCall(set, SET_BUTTON);
+        }
+        if (set.count) refreshSet(set, planned, byKind);
+        set = {};
+        if (!running && remaining > 0) {
+            delay(PAUSE_MS);
+            running = true;
+            drawButton();
+            recordCall(set, SET_BUTTON);
+        }
+    }
+    return host_shown_diff(d.getBuffer()) == 0;
+}
+
+static void printPlan(const char *name, const PlanResult &r)
+{
+    printf("  %-24s %4lu sets %4lu rects -> %4lu refreshes %4lu windows | "
+           "model %7.2f s | BUSY %6.1f s | %9lu bytes\n",
+           name, r.sets, r.regions, r.refreshes, r.windows, r.estimateUs / 1e6,
+           r.busyMs / 1000.0, r.bytes);
+}
+
+static void reportPlanning()
+{
+    printf("window planning (differential): one partialRefresh() per drawn rect\n"
+           "against planRegions() + one flush() per tick\n");
+    PlanResult results[2][SET_KINDS] = {};
+    for (int planned = 0; planned < 2; planned++) {
+        if (!runPlanning(planned != 0, results[planned])) {
+            printf("  %s: panel out of sync with the frame buffer\n",
+                   planned ? "planned" : "one per rect");
+            allInSync = false;
+        }
+    }
+    PlanResult total[2] = {};
+    for (uint8_t k = 0; k < SET_KINDS; k++) {
+        if (!results[0][k].sets) continue;
+        printf(" %s\n", SET_NAMES[k]);
+        for (int planned = 0; planned < 2; planned++) {
+            const PlanResult &r = results[planned][k];
+            printPlan(planned ? "planRegions + flush" : "one refresh per rect", r);
+            PlanResult &t = total[planned];
+            t.sets += r.sets;
+            t.regions += r.regions;
+            t.refreshes += r.refreshes;
+            t.windows += r.windows;
+            t.estimateUs += r.estimateUs;
+            t.busyMs += r.busyMs;
+            t.bytes += r.bytes;
+        }
+    }
+    printf(" whole session\n");
+    printPlan("one refresh per rect", total[0]);
+    printPlan("planRegions + flush", total[1]);
+}
+
+int main()
+{
+    printf("%d minute session, %d s pause at minute %d, %d ms loop\n\n",
+           SESSION_MINUTES, PAUSE_MS / 1000, PAUSE_AT_S / 60, LOOP_MS);
+
+    reportPolicies();
+    printf("\n");
+    reportTiles();
+    printf("\n");
+    reportMaintenance();
+    printf("\n");
+    reportScheduling();
+    printf("\n");
+    reportPlanning();
+
+    printf("\npanel %s the frame buffer after every session\n", allInSync ? "matched" : "did NOT match");
+    return allInSync ? 0 : 1;
+}
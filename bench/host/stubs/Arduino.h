@@ -0,0 +1,72 @@
+/*
+ * Arduino.h - Host stand-in for the bits of the ESP32 Arduino core the
+ * display libraries use
+ *
+ * Time only moves when the code under test calls delay() (or a harness
+ * calls host_advance()), so a 25-minute session runs in well under a
+ * second and every run is deterministic. BUSY is driven by the panel
+ * model in panel_model.cpp.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define HIGH 1
+#define LOW  0
+
+#define INPUT        0
+#define OUTPUT       1
+#define INPUT_PULLUP 2
+
+#define RISING  1
+#define FALLING 2
+#define CHANGE  3
+
+#define PI 3.1415926535897932384626433832795
+
+#define IRAM_ATTR
+#define PROGMEM
+#define MSBFIRST  1
+#define SPI_MODE0 0
+
+typedef bool boolean;
+
+// Pins and clock (panel_model.cpp)
+extern int host_pins[64];
+extern unsigned long host_millis;
+
+int  host_digital_read(int pin);
+void host_digital_write(int pin, int value);
+void host_advance(unsigned long ms);
+void host_attach_interrupt(int pin, void (*isr)(void), int mode);
+
+inline void pinMode(int, int) {}
+inline void digitalWrite(int pin, int value) { host_digital_write(pin, value); }
+inline int digitalRead(int pin) { return host_digital_read(pin); }
+
+inline void delay(unsigned long ms) { host_advance(ms); }
+inline void delayMicroseconds(unsigned int) {}
+inline unsigned long millis() { return host_millis; }
+inline unsigned long micros() { return host_millis * 1000UL; }
+
+inline int digitalPinToInterrupt(int pin) { return pin; }
+inline void attachInterrupt(int pin, void (*isr)(void), int mode) { host_attach_interrupt(pin, isr, mode); }
+inline void detachInterrupt(int pin) { host_attach_interrupt(pin, nullptr, 0); }
+
+struct HardwareSerial {
+    void begin(unsigned long) {}
+    template <class T> size_t print(T) { return 0; }
+    template <class T> size_t println(T) { return 0; }
+    size_t println() { return 0; }
+    int printf(const char *, ...) { return 0; }
+};
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,30 @@
+/*
+ * SPI.h - Host stand-in for SPIClass
+ *
+ * Every byte clocked out, single or bulk, goes to the panel model, which
+ * reads DC and CS to tell commands from data.
+ */
+
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include "Arduino.h"
+
+void host_spi_bytes(const uint8_t *data, size_t len);
+
+struct SPISettings {
+    SPISettings() {}
+    SPISettings(uint32_t, int, int) {}
+};
+
+struct SPIClass {
+    void begin(int, int, int, int) {}
+    void beginTransaction(SPISettings) {}
+    void endTransaction() {}
+    uint8_t transfer(uint8_t data) { host_spi_bytes(&data, 1); return 0; }
+    void transferBytes(const uint8_t *data, uint8_t *, uint32_t len) { host_spi_bytes(data, len); }
+    void writeBytes(const uint8_t *data, uint32_t len) { host_spi_bytes(data, len); }
+};
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include "Arduino.h"
+
+struct TwoWire {
+    void begin(int, int) {}
+    void beginTransmission(int) {}
+    int endTransmission() { return 0; }
+    void write(int) {}
+    int requestFrom(int, int) { return 0; }
+    int read() { return 0; }
+};
+extern TwoWire Wire;
+
+#endif
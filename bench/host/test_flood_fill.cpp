@@ -0,0 +1,274 @@
+/*
+ * test_flood_fill.cpp - Paint_FloodFill against a per-pixel BFS
+ *
+ * Worst cases for a scanline fill (perfect mazes, combs, noise, a
+ * checkerboard) in every rotation, with and without a clip region. Also
+ * reports the peak seed use, which FLOOD_FILL_MAX_SEEDS is sized from,
+ * and checks that WatcherDisplay::floodFill fills in portrait, takes its
+ * seeds from the pool and reports exhaustion instead of overrunning a
+ * small array.
+ */
+
+#include "host_test.h"
+#include "panel_model.h"
+
+#include "WatcherDisplay.h"
+
+#include <vector>
+
+#define W 400
+#define H 300
+#define MAX_SEEDS 65535  // Largest Paint_FloodFill accepts
+
+static UBYTE image[W / 8 * H], reference[W / 8 * H];
+static PAINT_FILL_SEED seeds[MAX_SEEDS];
+
+static bool get(const UBYTE *m, int x, int y) { return m[y * (W / 8) + x / 8] & (0x80 >> (x % 8)); }
+
+static void put(UBYTE *m, int x, int y, bool white)
+{
+    if (white) m[y * (W / 8) + x / 8] |= 0x80 >> (x % 8);
+    else m[y * (W / 8) + x / 8] &= ~(0x80 >> (x % 8));
+}
+
+// 4-connected fill of the seed's colour, memory coordinates
+static void referenceFill(int sx, int sy, bool white, int x1, int y1, int x2, int y2)
+{
+    bool target = get(reference, sx, sy);
+    if (target == white) return;
+
+    std::vector<int> stack(1, sy * W + sx);
+    put(reference, sx, sy, white);
+    while (!stack.empty()) {
+        int p = stack.back();
+        stack.pop_back();
+        int x = p % W, y = p / W;
+        const int nx[4] = { x - 1, x + 1, x, x }, ny[4] = { y, y, y - 1, y + 1 };
+        for (int k = 0; k < 4; k++) {
+            int a = nx[k], b = ny[k];
+            if (a < x1 || a > x2 || b < y1 || b > y2) continue;
+            if (get(reference, a, b) == target) {
+                put(reference, a, b, white);
+                stack.push_back(b * W + a);
+            }
+        }
+    }
+}
+
+// Perfect maze: black walls 1 px, white corridors 'cell' px wide
+static void maze(int cell)
+{
+    memset(image, 0x00, sizeof(image));
+    int cw = (W - 1) / (cell + 1), ch = (H - 1) / (cell + 1);
+    std::vector<char> visited(cw * ch, 0);
+    std::vector<int> stack(1, 0);
+    visited[0] = 1;
+
+    auto open = [&](int cx, int cy) {
+        for (int y = 0; y < cell; y++)
+            for (int x = 0; x < cell; x++)
+                put(image, 1 + cx * (cell + 1) + x, 1 + cy * (cell + 1) + y, true);
+    };
+    open(0, 0);
+
+    const int dx[4] = { 1, -1, 0, 0 }, dy[4] = { 0, 0, 1, -1 };
+    while (!stack.empty()) {
+        int c = stack.back(), cx = c % cw, cy = c / cw;
+        int dirs[4], n = 0;
+        for (int k = 0; k < 4; k++) {
+            int a = cx + dx[k], b = cy + dy[k];
+            if (a >= 0 && a < cw && b >= 0 && b < ch && !visited[b * cw + a]) dirs[n++] = k;
+        }
+        if (!n) {
+            stack.pop_back();
+            continue;
+        }
+        int k = dirs[rand() % n];
+        int a = cx + dx[k], b = cy + dy[k];
+        visited[b * cw + a] = 1;
+        open(a, b);
+        // Knock the wall between the cells through
+        for (int i = 0; i < cell; i++) {
+            if (dx[k]) put(image, 1 + cx * (cell + 1) + (dx[k] > 0 ? cell : -1), 1 + cy * (cell + 1) + i, true);
+            else put(image, 1 + cx * (cell + 1) + i, 1 + cy * (cell + 1) + (dy[k] > 0 ? cell : -1), true);
+        }
+        stack.push_back(b * cw + a);
+    }
+}
+
+// Vertical teeth joined alternately at the top and bottom: one long snake
+static void comb(int gap)
+{
+    memset(image, 0xFF, sizeof(image));
+    for (int x = 1; x < W; x += gap + 1) {
+        bool fromTop = (x / (gap + 1)) % 2;
+        for (int y = fromTop ? 0 : 1; y < H - (fromTop ? 1 : 0); y++) put(image, x, y, false);
+    }
+}
+
+static void noise(int blackPercent)
+{
+    for (uint32_t i = 0; i < sizeof(image); i++) {
+        UBYTE b = 0;
+        for (int k = 0; k < 8; k++)
+            if (rand() % 100 >= blackPercent) b |= 0x80 >> k;
+        image[i] = b;
+    }
+}
+
+static void checker()
+{
+    for (int y = 0; y < H; y++)
+        for (int x = 0; x < W; x++) put(image, x, y, ((x + y) & 1) || (y % 2 == 0));
+}
+
+static void toMemory(UWORD rotate, int x, int y, int &mx, int &my)
+{
+    switch (rotate) {
+    case 0: mx = x; my = y; break;
+    case 90: mx = W - y - 1; my = x; break;
+    case 180: mx = W - x - 1; my = H - y - 1; break;
+    default: mx = y; my = H - x - 1; break;
+    }
+}
+
+static int peakSeeds()
+{
+    int n = MAX_SEEDS;
+    while (n > 0 && seeds[n - 1].Dir == 0x5A) n--;
+    return n;
+}
+
+static void testAgainstReference()
+{
+    struct Case { const char *name; int kind, arg; } cases[] = {
+        { "empty", 0, 0 }, { "maze 1px", 1, 1 }, { "maze 2px", 1, 2 }, { "maze 5px", 1, 5 },
+        { "comb 1px", 2, 1 }, { "comb 3px", 2, 3 }, { "noise 30%", 3, 30 },
+        { "noise 40%", 3, 40 }, { "checker", 4, 0 },
+    };
+    srand(20);
+
+    for (unsigned c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        int peak = 0, bad = 0, runs = 0;
+        for (UWORD rotate = 0; rotate < 360; rotate += 90) {
+            for (int clip = 0; clip < 2; clip++) {
+                for (int trial = 0; trial < 6; trial++) {
+                    switch (cases[c].kind) {
+                    case 0: memset(image, 0xFF, sizeof(image)); break;
+                    case 1: maze(cases[c].arg); break;
+                    case 2: comb(cases[c].arg); break;
+                    case 3: noise(cases[c].arg); break;
+                    default: checker(); break;
+                    }
+                    Paint_NewImage(image, W, H, rotate, WHITE);
+                    Paint_SelectImage(image);
+                    Paint_SetDirtyTracking(false);
+
+                    int lw = (rotate % 180) ? H : W, lh = (rotate % 180) ? W : H;
+                    int cx1 = 0, cy1 = 0, cx2 = lw - 1, cy2 = lh - 1;
+                    if (clip) {
+                        cx1 = 20; cy1 = 30; cx2 = lw - 41; cy2 = lh - 17;
+                        Paint_SetClipRegion(cx1, cy1, cx2, cy2);
+                    }
+                    int lx = cx1 + rand() % (cx2 - cx1 + 1), ly = cy1 + rand() % (cy2 - cy1 + 1);
+
+                    int mx, my, a1, b1, a2, b2;
+                    toMemory(rotate, lx, ly, mx, my);
+                    toMemory(rotate, cx1, cy1, a1, b1);
+                    toMemory(rotate, cx2, cy2, a2, b2);
+                    if (a1 > a2) { int t = a1; a1 = a2; a2 = t; }
+                    if (b1 > b2) { int t = b1; b1 = b2; b2 = t; }
+
+                    // Fill with the other colour than the one under the seed
+                    UWORD color = get(image, mx, my) ? BLACK : WHITE;
+                    memcpy(reference, image, sizeof(image));
+                    referenceFill(mx, my, color != BLACK, a1, b1, a2, b2);
+
+                    for (int i = 0; i < MAX_SEEDS; i++) seeds[i].Dir = 0x5A;
+                    bool complete = Paint_FloodFill(lx, ly, color, seeds, MAX_SEEDS);
+                    Paint_ClearClipRegion();
+                    runs++;
+
+                    if (!complete || memcmp(image, reference, sizeof(image)) != 0) bad++;
+                    int used = peakSeeds();
+                    if (used > peak) peak = used;
+                }
+            }
+        }
+        printf("  %-10s %2d/%d differ, peak %5d seeds (%6d bytes)\n", cases[c].name, bad, runs,
+               peak, peak * (int)sizeof(PAINT_FILL_SEED));
+        CHECK_EQ(bad, 0);
+        if (cases[c].kind == 1) CHECK(peak <= FLOOD_FILL_MAX_SEEDS);
+    }
+}
+
+static void testWatcherDisplay()
+{
+    printf("WatcherDisplay::floodFill\n");
+    host_reset();
+    WatcherDisplay display;
+    display.begin(false, ROTATE_270);
+
+    // The maze corridor at memory (1,1), seeded in portrait coordinates
+    int mx, my;
+    toMemory(ROTATE_270, H - 2, 1, mx, my);
+    CHECK(mx == 1 && my == 1);
+    maze(1);
+    memcpy(display.getBuffer(), image, sizeof(image));
+    memcpy(reference, image, sizeof(image));
+    referenceFill(1, 1, false, 0, 0, W - 1, H - 1);
+    CHECK(display.floodFill(H - 2, 1, BLACK, BLACK));
+    CHECK(memcmp(display.getBuffer(), reference, sizeof(image)) == 0);
+
+    // A 1px lattice over the whole screen needs more than FLOOD_FILL_MAX_SEEDS
+    checker();
+    memcpy(display.getBuffer(), image, sizeof(image));
+    bool complete = display.floodFill(H - 1, 0, BLACK, BLACK);
+    printf("  1px lattice, %d seeds: %s\n", FLOOD_FILL_MAX_SEEDS,
+           complete ? "complete" : "reported incomplete");
+    CHECK(!complete);
+}
+
+// Seeds come from the pool and go back to it
+static void testSeedPool()
+{
+    host_reset();
+    WatcherDisplay display;
+    display.begin(false, ROTATE_0, FLOOD_FILL_MAX_SEEDS * sizeof(PAINT_FILL_SEED), 2);
+    maze(1);
+    memcpy(display.getBuffer(), image, sizeof(image));
+    for (int i = 0; i < 3; i++) {
+        CHECK(display.floodFill(1, 1, BLACK, BLACK));
+        CHECK(display.floodFill(1, 1, WHITE, WHITE));
+    }
+    const RegionPool &pool = display.getRegionPool();
+    CHECK_EQ(pool.getInUse(), 0);
+    CHECK_EQ(pool.getHighWater(), 1);
+    CHECK_EQ(pool.getFailedCount(), 0);
+}
+
+// Caller's array, too small for a 1px maze: partly filled, reported
+static void testCallerSeeds()
+{
+    host_reset();
+    WatcherDisplay display;
+    display.begin(false, ROTATE_0);
+    maze(1);
+    memcpy(display.getBuffer(), image, sizeof(image));
+    static PAINT_FILL_SEED few[8];
+    bool complete = display.floodFill(1, 1, BLACK, BLACK, few, 8);
+    printf("  8 seeds on a 1px maze: %s\n", complete ? "complete" : "reported incomplete");
+    CHECK(!complete);
+    CHECK(display.floodFill(1, 1, BLACK, BLACK));
+}
+
+int main()
+{
+    host_reset();
+    printf("flood fill against BFS\n");
+    testAgainstReference();
+    testWatcherDisplay();
+    testSeedPool();
+    testCallerSeeds();
+    return host_test_summary("test_flood_fill");
+}
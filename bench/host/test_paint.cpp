@@ -0,0 +1,344 @@
+/*
+ * test_paint.cpp - Line and rectangle rasterizers against a per-pixel reference
+ *
+ * The reference steps the line one pixel at a time and stamps a
+ * Paint_DrawPoint square (2 * width - 1 pixels, centred one pixel up-left
+ * of the point) at each, clipping pixel by pixel. The span-based
+ * Paint_DrawLine/Paint_DrawRectangle must paint exactly the same pixels
+ * in every rotation and with a clip region, including lines that run off
+ * the image (which the originals dropped outright). Sloped lines round
+ * to the nearest pixel, as Paint_DrawLine does since it stopped using the
+ * original Bresenham loop; horizontal, vertical and 45 degree lines, and
+ * so rectangles, are pixel for pixel the original ones.
+ *
+ * Round rects that start left of or above the image are compared with the
+ * same rect drawn whole into a larger image.
+ *
+ * Paint_Sin/Paint_Cos are checked against libm over a whole turn.
+ *
+ * Polygons past PAINT_POLYGON_STACK_EDGES must fill exactly as with a
+ * caller's edge table, from the kept scratch or a borrowed pool slot, and
+ * a filled WatcherDisplay triangle must match the same triangle as a
+ * polygon.
+ */
+
+#include "host_test.h"
+#include "panel_model.h"
+
+#include "GUI_Paint.h"
+#include "GUI_GFX.h"
+#include "WatcherDisplay.h"
+
+#include <math.h>
+
+#define W 400
+#define H 300
+
+static UBYTE image[W / 8 * H], reference[W / 8 * H];
+
+static void refDot(int X, int Y, UWORD Color, int Width)
+{
+    for (int i = 0; i < 2 * Width - 1; i++) {
+        for (int j = 0; j < 2 * Width - 1; j++) {
+            int PX = X + i - Width, PY = Y + j - Width;
+            if (PX >= 0 && PY >= 0)
+                Paint_SetPixel(PX, PY, Color);
+        }
+    }
+}
+
+static void refLine(int Xstart, int Ystart, int Xend, int Yend,
+                    UWORD Color, int Width, LINE_STYLE Style)
+{
+    // Major axis M, minor axis N; pixel K of the minor axis sits at
+    // round(K * DN / DM), halves away from the start
+    bool Steep = abs(Yend - Ystart) > abs(Xend - Xstart);
+    int M0 = Steep ? Ystart : Xstart, M1 = Steep ? Yend : Xend;
+    int N0 = Steep ? Xstart : Ystart, N1 = Steep ? Xend : Yend;
+    int DM = abs(M1 - M0), DN = abs(N1 - N0);
+    int SM = (M1 >= M0) ? 1 : -1, SN = (N1 >= N0) ? 1 : -1;
+
+    for (int K = 0; K <= DM; K++) {
+        int J = DM ? (2 * DN * K + DM) / (2 * DM) : 0;
+        int M = M0 + SM * K, N = N0 + SN * J;
+        UWORD Dot = (Style == LINE_STYLE_DOTTED && K % 3 == 2) ? IMAGE_BACKGROUND : Color;
+        refDot(Steep ? N : M, Steep ? M : N, Dot, Width);
+    }
+}
+
+static void refRectangle(int Xstart, int Ystart, int Xend, int Yend,
+                         UWORD Color, int Width, DRAW_FILL Fill)
+{
+    if (Fill) {
+        for (int Y = Ystart; Y < Yend; Y++)
+            refLine(Xstart, Y, Xend, Y, Color, Width, LINE_STYLE_SOLID);
+    } else {
+        refLine(Xstart, Ystart, Xend, Ystart, Color, Width, LINE_STYLE_SOLID);
+        refLine(Xstart, Ystart, Xstart, Yend, Color, Width, LINE_STYLE_SOLID);
+        refLine(Xend, Yend, Xend, Ystart, Color, Width, LINE_STYLE_SOLID);
+        refLine(Xend, Yend, Xstart, Yend, Color, Width, LINE_STYLE_SOLID);
+    }
+}
+
+static uint32_t blackPixels(const UBYTE *buffer)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < sizeof(image); i++)
+        count += __builtin_popcount((UBYTE)~buffer[i]);
+    return count;
+}
+
+static void select(UBYTE *buffer, UWORD rotate, bool clip)
+{
+    Paint_NewImage(buffer, W, H, rotate, WHITE);
+    Paint_SelectImage(buffer);
+    Paint_SetDirtyTracking(false);
+    Paint_Clear(WHITE);
+    if (clip) Paint_SetClipRegion(37, 21, 250, 190);
+}
+
+static void testRectangleFootprint()
+{
+    printf("rectangle footprint\n");
+    select(image, ROTATE_0, false);
+    Paint_DrawRectangle(50, 50, 200, 120, BLACK, DOT_PIXEL_3X3, DRAW_FILL_EMPTY);
+    select(reference, ROTATE_0, false);
+    refRectangle(50, 50, 200, 120, BLACK, 3, DRAW_FILL_EMPTY);
+
+    printf("  DOT_PIXEL_3X3 (50,50)-(200,120): %u px, original %u px\n",
+           blackPixels(image), blackPixels(reference));
+    CHECK_EQ(blackPixels(image), 2200);
+    CHECK(memcmp(image, reference, sizeof(image)) == 0);
+
+    // A thick line is as wide as a Paint_DrawPoint dot
+    select(image, ROTATE_0, false);
+    Paint_DrawLine(100, 100, 100, 100, BLACK, DOT_PIXEL_5X5, LINE_STYLE_SOLID);
+    CHECK_EQ(blackPixels(image), 81);
+    select(reference, ROTATE_0, false);
+    Paint_DrawPoint(100, 100, BLACK, DOT_PIXEL_5X5, DOT_FILL_AROUND);
+    CHECK(memcmp(image, reference, sizeof(image)) == 0);
+}
+
+static void testRandom()
+{
+    printf("random lines and rectangles\n");
+    srand(18);
+    uint32_t cases = 0, bad = 0;
+
+    for (UWORD rotate = 0; rotate < 360; rotate += 90) {
+        for (int clip = 0; clip < 2; clip++) {
+            int lw = (rotate % 180) ? H : W, lh = (rotate % 180) ? W : H;
+            for (int n = 0; n < 400; n++) {
+                int width = 1 + rand() % 8;
+                int kind = rand() % 4;
+                // Endpoints up to 20 px beyond the far edges
+                int x0 = rand() % (lw + 20), y0 = rand() % (lh + 20);
+                int x1 = rand() % (lw + 20), y1 = rand() % (lh + 20);
+                if (kind == 1) y1 = y0;
+                if (kind == 2) x1 = x0;
+                LINE_STYLE style = (rand() & 1) ? LINE_STYLE_DOTTED : LINE_STYLE_SOLID;
+
+                select(image, rotate, clip);
+                select(reference, rotate, clip);
+                if (kind == 3) {
+                    if (x0 > x1) { int t = x0; x0 = x1; x1 = t; }
+                    if (y0 > y1) { int t = y0; y0 = y1; y1 = t; }
+                    if (x1 > lw) x1 = lw;
+                    if (y1 > lh) y1 = lh;
+                    if (x0 > x1) x0 = x1;
+                    if (y0 > y1) y0 = y1;
+                    DRAW_FILL fill = (rand() & 1) ? DRAW_FILL_FULL : DRAW_FILL_EMPTY;
+                    Paint_SelectImage(image);
+                    Paint_DrawRectangle(x0, y0, x1, y1, BLACK, (DOT_PIXEL)width, fill);
+                    Paint_SelectImage(reference);
+                    refRectangle(x0, y0, x1, y1, BLACK, width, fill);
+                } else {
+                    Paint_SelectImage(image);
+                    Paint_DrawLine(x0, y0, x1, y1, BLACK, (DOT_PIXEL)width, style);
+                    Paint_SelectImage(reference);
+                    refLine(x0, y0, x1, y1, BLACK, width, style);
+                }
+                cases++;
+                if (memcmp(image, reference, sizeof(image)) != 0) {
+                    if (bad < 5) {
+                        printf("  mismatch: rotate %u clip %d kind %d (%d,%d)-(%d,%d) width %d\n",
+                               rotate, clip, kind, x0, y0, x1, y1, width);
+                    }
+                    bad++;
+                }
+            }
+        }
+    }
+    Paint_ClearClipRegion();
+    printf("  %u cases, %u differ from the reference\n", cases, bad);
+    CHECK_EQ(bad, 0);
+}
+
+// GUI_GFX round rects that hang off the image keep their shape: the
+// visible part matches the same rect drawn whole into a larger image
+#define MARGIN 128
+#define BIG_W (W + 2 * MARGIN)
+#define BIG_H (H + 2 * MARGIN)
+
+static UBYTE big[BIG_W / 8 * BIG_H];
+
+static bool pixel(const UBYTE *buffer, int width, int x, int y)
+{
+    return buffer[y * (width / 8) + x / 8] & (0x80 >> (x % 8));
+}
+
+static void testRoundRectClipping()
+{
+    printf("round rects partly off the image\n");
+    GUI_GFX gfx(image, W, H);
+    srand(17);
+    uint32_t cases = 0, bad = 0, visible = 0;
+
+    for (int n = 0; n < 600; n++) {
+        int w = 1 + rand() % 200, h = 1 + rand() % 160, r = rand() % 60;
+        int x = -w + rand() % (W + w), y = -h + rand() % (H + h);
+        bool fill = rand() & 1;
+
+        Paint_NewImage(big, BIG_W, BIG_H, ROTATE_0, WHITE);
+        Paint_SelectImage(big);
+        Paint_SetDirtyTracking(false);
+        Paint_Clear(WHITE);
+        Paint_DrawRoundRect(x + MARGIN, y + MARGIN, x + MARGIN + w - 1, y + MARGIN + h - 1, r,
+                            BLACK, fill ? DRAW_FILL_FULL : DRAW_FILL_EMPTY);
+
+        gfx.begin();
+        select(image, ROTATE_0, false);
+        if (fill) gfx.fillRoundRect(x, y, w, h, r, GFX_BLACK);
+        else gfx.drawRoundRect(x, y, w, h, r, GFX_BLACK);
+
+        uint32_t diff = 0, black = 0;
+        for (int py = 0; py < H; py++) {
+            for (int px = 0; px < W; px++) {
+                bool mine = pixel(image, W, px, py);
+                diff += mine != pixel(big, BIG_W, px + MARGIN, py + MARGIN);
+                black += !mine;
+            }
+        }
+        cases++;
+        if (black) visible++;
+        if (diff) {
+            if (bad < 5)
+                printf("  mismatch: (%d,%d) %dx%d r%d %s, %u px\n", x, y, w, h, r,
+                       fill ? "filled" : "outline", diff);
+            bad++;
+        }
+    }
+    printf("  %u cases (%u with pixels on the image), %u differ\n", cases, visible, bad);
+    CHECK(visible > cases / 2);
+    CHECK_EQ(bad, 0);
+}
+
+// ========== Q15 sine/cosine ==========
+
+static void testTrig()
+{
+    const int32_t steps = 360 << PAINT_ANGLE_FRAC_BITS;
+    int32_t worst = 0;
+    for (int32_t a = -steps; a <= steps; a++) {
+        double rad = a * M_PI / 180.0 / (1 << PAINT_ANGLE_FRAC_BITS);
+        int32_t sinErr = labs(Paint_Sin(a) - lround(sin(rad) * 32767));
+        int32_t cosErr = labs(Paint_Cos(a) - lround(cos(rad) * 32767));
+        if (sinErr > worst) worst = sinErr;
+        if (cosErr > worst) worst = cosErr;
+    }
+    printf("Paint_Sin/Paint_Cos\n  %d angles, worst error %d/32767\n", 2 * steps + 1, worst);
+    CHECK(worst <= 2);
+    CHECK_EQ(Paint_Sin(90 << PAINT_ANGLE_FRAC_BITS), 32767);
+    CHECK_EQ(Paint_Cos(180 << PAINT_ANGLE_FRAC_BITS), -32767);
+    CHECK_EQ(Paint_Sin(-(30 << PAINT_ANGLE_FRAC_BITS)), -16384);
+}
+
+// ========== Large polygons and triangles ==========
+
+#define STAR_POINTS 96
+
+static void starOutline(int16_t *xs, int16_t *ys, uint16_t *points, int turn)
+{
+    for (int i = 0; i < STAR_POINTS; i++) {
+        int32_t angle = (int32_t)(i * 360 + turn) * (1 << PAINT_ANGLE_FRAC_BITS) / STAR_POINTS;
+        int32_t radius = (i % 2) ? 60 : 140;
+        xs[i] = 200 + ((radius * Paint_Cos(angle) + 0x4000) >> 15);
+        ys[i] = 150 + ((radius * Paint_Sin(angle) + 0x4000) >> 15);
+        points[i * 2] = xs[i];
+        points[i * 2 + 1] = ys[i];
+    }
+}
+
+static void testLargePolygons()
+{
+    static PAINT_EDGE edges[STAR_POINTS];
+    int16_t xs[STAR_POINTS], ys[STAR_POINTS];
+    uint16_t points[STAR_POINTS * 2];
+    uint32_t bad = 0;
+
+    // Paint_DrawPolygon, growing its kept table once and reusing it
+    for (int turn = 0; turn < 8; turn++) {
+        starOutline(xs, ys, points, turn * 5);
+        select(reference, ROTATE_0, false);
+        Paint_FillPolygon(xs, ys, STAR_POINTS - turn, BLACK, FILL_RULE_EVEN_ODD, edges, STAR_POINTS);
+        select(image, ROTATE_0, false);
+        Paint_DrawPolygon(xs, ys, STAR_POINTS - turn, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+        if (memcmp(image, reference, sizeof(image)) != 0) bad++;
+    }
+
+    // WatcherDisplay::drawPolygon from its kept scratch, then from the pool
+    for (int pooled = 0; pooled < 2; pooled++) {
+        host_reset();
+        WatcherDisplay display;
+        if (pooled)
+            display.begin(false, ROTATE_0, 2048, 1);
+        else
+            display.begin(false, ROTATE_0);
+        for (int turn = 0; turn < 4; turn++) {
+            starOutline(xs, ys, points, turn * 5);
+            select(reference, ROTATE_0, false);
+            Paint_FillPolygon(xs, ys, STAR_POINTS, BLACK, FILL_RULE_NONZERO, edges, STAR_POINTS);
+            display.fillRegion(0, 0, W, H, WHITE);
+            display.drawPolygon(points, STAR_POINTS, BLACK, true, FILL_RULE_NONZERO);
+            if (memcmp(display.getBuffer(), reference, sizeof(reference)) != 0) bad++;
+        }
+        if (pooled) {
+            const RegionPool &pool = display.getRegionPool();
+            CHECK_EQ(pool.getInUse(), 0);
+            CHECK_EQ(pool.getHighWater(), 1);
+        }
+    }
+
+    // Filled triangles, against the same three points as a polygon
+    host_reset();
+    WatcherDisplay display;
+    display.begin(false, ROTATE_0);
+    srand(7);
+    const int triangles = 500;
+    for (int i = 0; i < triangles; i++) {
+        int16_t tx[3], ty[3];
+        for (int k = 0; k < 3; k++) {
+            tx[k] = rand() % W;
+            ty[k] = rand() % H;
+        }
+        select(reference, ROTATE_0, false);
+        Paint_DrawPolygon(tx, ty, 3, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+        display.fillRegion(0, 0, W, H, WHITE);
+        display.drawTriangle(tx[0], ty[0], tx[1], ty[1], tx[2], ty[2], BLACK, true);
+        if (memcmp(display.getBuffer(), reference, sizeof(reference)) != 0) bad++;
+    }
+    printf("large polygons and triangles\n  %d-point stars and %d triangles, %u differ\n",
+           STAR_POINTS, triangles, bad);
+    CHECK_EQ(bad, 0);
+}
+
+int main()
+{
+    host_reset();
+    testRectangleFootprint();
+    testRandom();
+    testRoundRectClipping();
+    testTrig();
+    testLargePolygons();
+    return host_test_summary("test_paint");
+}
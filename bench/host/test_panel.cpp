@@ -0,0 +1,365 @@
+/*
+ * test_panel.cpp - What reaches the controller, checked against the panel model
+ *
+ *   - a full frame goes out in a handful of SPI transactions (DEV_SPI_Stream*)
+ *   - full refreshes and clear() after a partial rewrite all of both RAMs,
+ *     with the full-update 0x21/0x3C settings back in place
+ *   - asynchronous refreshes return at once, finish through poll() with
+ *     one callback, and time out when BUSY never drops
+ *   - 4-gray planes match a per-pixel reference, also after a partial
+ *   - a long session of partials, coalesced updates and tile cleans keeps
+ *     the panel equal to the frame buffer whenever nothing is in flight
+ */
+
+#include "host_test.h"
+#include "panel_model.h"
+
+#include "WatcherDisplay.h"
+
+#define FRAME_BYTES BUFFER_SIZE
+
+static void scribble(UBYTE *buffer, uint32_t size, unsigned seed)
+{
+    srand(seed);
+    for (uint32_t i = 0; i < size; i++) buffer[i] = (UBYTE)rand();
+}
+
+static void testFrameTransactions()
+{
+    printf("full frame over SPI\n");
+    static UBYTE frame[FRAME_BYTES], white[FRAME_BYTES];
+    scribble(frame, sizeof(frame), 1);
+    memset(white, 0xFF, sizeof(white));
+
+    struct { const char *name; int kind; } cases[] = {
+        { "Display", 0 },
+        { "Display_Fast", 1 },
+        { "Clear", 2 },
+    };
+    for (unsigned c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        host_reset();
+        DEV_Module_Init();
+        if (cases[c].kind == 1) EPD_4IN2_V2_Init_Fast(Seconds_1_5S);
+        else EPD_4IN2_V2_Init();
+
+        DEV_SPI_ResetStats();
+        unsigned long bursts = host_panel.bursts;
+        switch (cases[c].kind) {
+        case 0: EPD_4IN2_V2_Display(frame); break;
+        case 1: EPD_4IN2_V2_Display_Fast(frame); break;
+        case 2: EPD_4IN2_V2_Clear(); break;
+        }
+        DEV_SPI_STATS stats = DEV_SPI_GetStats();
+
+        const UBYTE *expect = cases[c].kind == 2 ? white : frame;
+        printf("  %-13s %lu bytes in %lu transactions, longest CS low %lu bytes\n", cases[c].name,
+               (unsigned long)stats.bytes, (unsigned long)stats.transactions,
+               host_panel.longestBurst);
+        CHECK(stats.transactions < 64);
+        CHECK(host_panel.bursts - bursts < 64);
+        CHECK_EQ(host_panel.longestBurst, FRAME_BYTES);
+        CHECK_EQ(host_ram_diff(0x24, expect), 0);
+        CHECK_EQ(host_ram_diff(0x26, expect), 0);
+        CHECK_EQ(host_shown_diff(expect), 0);
+    }
+}
+
+// A partial window streams its rows in one transaction too
+static void testPartialTransactions()
+{
+    printf("partial window over SPI\n");
+    host_reset();
+    DEV_Module_Init();
+    EPD_4IN2_V2_Init();
+
+    static UBYTE frame[FRAME_BYTES], window[FRAME_BYTES];
+    memset(frame, 0xFF, sizeof(frame));
+    EPD_4IN2_V2_Display(frame);
+
+    // 80x40 at (64, 100): 10 bytes a row
+    scribble(window, 10 * 40, 2);
+    for (int y = 0; y < 40; y++) memcpy(&frame[(100 + y) * 50 + 8], &window[y * 10], 10);
+
+    DEV_SPI_ResetStats();
+    host_panel.longestBurst = 0;
+    EPD_4IN2_V2_PartialDisplay(window, 64, 100, 144, 140);
+    DEV_SPI_STATS stats = DEV_SPI_GetStats();
+
+    printf("  %lu bytes in %lu transactions, longest CS low %lu bytes\n",
+           (unsigned long)stats.bytes, (unsigned long)stats.transactions,
+           host_panel.longestBurst);
+    CHECK(stats.transactions < 32);
+    CHECK_EQ(host_panel.longestBurst, 10 * 40);
+    CHECK_EQ(host_ram_diff(0x24, frame), 0);
+    CHECK_EQ(host_shown_diff(frame), 0);
+}
+
+// Start from a panel that has just run a small partial window
+static void partialThenRedraw(WatcherDisplay &display, unsigned seed)
+{
+    UBYTE *buffer = display.getBuffer();
+    Paint_Clear(WHITE);
+    display.fullRefresh();
+
+    Paint_DrawString_EN(8, 250, "12", &Font8, WHITE, BLACK);
+    display.updateRegion(8, 250, 16, 8);
+    display.waitForRefresh();
+    CHECK_EQ(host_shown_diff(buffer), 0);
+
+    scribble(buffer, BUFFER_SIZE, seed);
+}
+
+static void testFullAfterPartial()
+{
+    printf("full refresh after a partial\n");
+    struct { const char *name; int kind; } cases[] = {
+        { "beginFullRefresh", 0 },
+        { "beginFastFullRefresh", 1 },
+        { "fullRefresh", 2 },
+        { "clear", 3 },
+    };
+
+    for (unsigned c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        for (int differential = 0; differential < 2; differential++) {
+            host_reset();
+            WatcherDisplay display;
+            display.begin(false, ROTATE_0);
+            display.setDifferentialRefresh(differential != 0, 0);
+            partialThenRedraw(display, 10 + c);
+
+            unsigned long before = host_panel.fullWithPartialRegs;
+            switch (cases[c].kind) {
+            case 0: display.beginFullRefresh(); break;
+            case 1: display.beginFastFullRefresh(); break;
+            case 2: display.fullRefresh(); break;
+            case 3: display.clear(); break;
+            }
+            display.waitForRefresh();
+
+            UBYTE *buffer = display.getBuffer();
+            uint32_t ram = host_ram_diff(0x24, buffer);
+            uint32_t shown = host_shown_diff(buffer);
+            printf("  %-22s %-12s RAM 0x24 off by %5u px, panel by %5u px\n", cases[c].name,
+                   differential ? "differential" : "plain", ram, shown);
+            CHECK_EQ(ram, 0);
+            CHECK_EQ(host_ram_diff(0x26, buffer), 0);
+            CHECK_EQ(shown, 0);
+            CHECK_EQ(host_panel.fullWithPartialRegs - before, 0);
+        }
+    }
+}
+
+struct CallbackLog {
+    int calls;
+    RefreshResult result;
+    RefreshState kind;
+    unsigned long at;
+};
+
+static void logRefresh(RefreshResult result, RefreshState kind, void *context)
+{
+    CallbackLog *log = (CallbackLog *)context;
+    log->calls++;
+    log->result = result;
+    log->kind = kind;
+    log->at = millis();
+}
+
+static void testAsyncRefresh()
+{
+    printf("asynchronous refresh\n");
+    host_reset();
+    WatcherDisplay display;
+    display.begin(false, ROTATE_0);
+    CallbackLog log = {};
+    display.setRefreshCallback(logRefresh, &log);
+    UBYTE *buffer = display.getBuffer();
+
+    // Full: returns right after the trigger, poll() runs until BUSY drops
+    scribble(buffer, BUFFER_SIZE, 5);
+    unsigned long start = millis();
+    CHECK(display.beginFullRefresh());
+    CHECK(millis() - start < HOST_FULL_MS / 10);
+    CHECK_EQ(display.getRefreshState(), REFRESH_FULL_RUNNING);
+    CHECK(display.isBusy());
+    int polls = 0;
+    while (display.poll()) {
+        delay(10);
+        polls++;
+    }
+    printf("  full    done after %lu ms, %d polls\n", log.at - start, polls);
+    CHECK(polls > 0);
+    CHECK_EQ(log.calls, 1);
+    CHECK_EQ(log.result, REFRESH_COMPLETED);
+    CHECK_EQ(log.kind, REFRESH_FULL_RUNNING);
+    CHECK(log.at - start >= HOST_FULL_MS);
+    CHECK(log.at - start <= HOST_FULL_MS + 10);
+    CHECK_EQ(display.getRefreshState(), REFRESH_IDLE);
+    CHECK_EQ(host_shown_diff(buffer), 0);
+
+    // Partial: the interrupt latches the edge, one poll afterwards finishes
+    // 1x1 points also set x-1/y-1, so this stays inside 40..119 x 40..79
+    Paint_DrawRectangle(41, 41, 119, 79, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+    start = millis();
+    CHECK(display.beginPartialRefresh(UIRegion(40, 40, 80, 40)));
+    CHECK_EQ(display.getRefreshState(), REFRESH_PARTIAL_RUNNING);
+    host_advance(HOST_PARTIAL_MS);
+    CHECK(!display.poll());
+    printf("  partial done after %lu ms\n", log.at - start);
+    CHECK_EQ(log.calls, 2);
+    CHECK_EQ(log.kind, REFRESH_PARTIAL_RUNNING);
+    CHECK_EQ(log.result, REFRESH_COMPLETED);
+    CHECK_EQ(display.getPartialRefreshCount(), 1);
+    CHECK_EQ(host_shown_diff(buffer), 0);
+
+    // A second begin waits for the first
+    CHECK(display.beginPartialRefresh(UIRegion(40, 40, 80, 40)));
+    CHECK(display.beginFullRefresh());
+    CHECK_EQ(log.calls, 3);
+    CHECK(display.waitForRefresh());
+    CHECK_EQ(log.calls, 4);
+    CHECK_EQ(host_panel.waveforms[0xFF], 2);
+    CHECK_EQ(host_panel.waveforms[0xF7], 2);
+}
+
+static void testRefreshTimeout()
+{
+    printf("refresh timeout\n");
+    host_reset();
+    WatcherDisplay display;
+    display.begin(false, ROTATE_0);
+    CallbackLog log = {};
+    display.setRefreshCallback(logRefresh, &log);
+
+    host_panel.busyStuck = true;
+    unsigned long start = millis();
+    CHECK(display.beginPartialRefresh(UIRegion(0, 0, 64, 32)));
+    CHECK(!display.waitForRefresh());
+    printf("  partial gave up after %lu ms\n", log.at - start);
+    CHECK_EQ(log.calls, 1);
+    CHECK_EQ(log.result, REFRESH_TIMED_OUT);
+    CHECK_EQ(log.kind, REFRESH_PARTIAL_RUNNING);
+    CHECK(log.at - start > DEFAULT_PARTIAL_REFRESH_TIMEOUT_MS);
+    CHECK(log.at - start <= DEFAULT_PARTIAL_REFRESH_TIMEOUT_MS + 2);
+    CHECK_EQ(display.getRefreshState(), REFRESH_IDLE);
+
+    display.setRefreshTimeout(500, 100);
+    host_reset();
+    host_panel.busyStuck = true;
+    start = millis();
+    CHECK(display.beginFullRefresh());
+    while (display.poll()) delay(5);
+    printf("  full    gave up after %lu ms (timeout 500)\n", log.at - start);
+    CHECK_EQ(log.calls, 2);
+    CHECK_EQ(log.result, REFRESH_TIMED_OUT);
+    CHECK_EQ(log.kind, REFRESH_FULL_RUNNING);
+    CHECK(log.at - start > 500);
+    CHECK(log.at - start <= 505);
+}
+
+static int grayReference(const UBYTE *image, int x, int y)
+{
+    UBYTE byte = image[y * (DISPLAY_WIDTH / 4) + x / 4];
+    return (byte >> (6 - 2 * (x % 4))) & 0x03;
+}
+
+static void testGrayPlanes()
+{
+    printf("4-gray planes\n");
+    host_reset();
+    DEV_Module_Init();
+    EPD_4IN2_V2_Init();
+
+    // Leave a narrow window and a stray cursor behind
+    static UBYTE mono[BUFFER_SIZE];
+    scribble(mono, sizeof(mono), 3);
+    EPD_4IN2_V2_PartialBegin();
+    EPD_4IN2_V2_PartialLoadWindow_Strided(mono, mono, DISPLAY_WIDTH / 8, 8, 250, 24, 258);
+    EPD_4IN2_V2_PartialUpdate();
+
+    static UBYTE gray[GRAY_BUFFER_SIZE];
+    scribble(gray, sizeof(gray), 4);
+    EPD_4IN2_V2_Display_4Gray(gray);
+
+    uint32_t bad = 0;
+    for (int y = 0; y < DISPLAY_HEIGHT; y++) {
+        for (int x = 0; x < DISPLAY_WIDTH; x++) {
+            int level = grayReference(gray, x, y);
+            UBYTE mask = 0x80 >> (x % 8);
+            int low = (host_panel.ram24[y * 50 + x / 8] & mask) ? 1 : 0;
+            int high = (host_panel.ram26[y * 50 + x / 8] & mask) ? 1 : 0;
+            if (low != (level & 1) || high != (level >> 1)) bad++;
+        }
+    }
+    printf("  %u of %u pixels differ from the reference\n", bad, DISPLAY_WIDTH * DISPLAY_HEIGHT);
+    CHECK_EQ(bad, 0);
+    CHECK_EQ(host_panel.waveforms[0xCF], 1);
+}
+
+// Random drawing with markDirty, tile cleaning and deferred maintenance,
+// checked every time the panel is idle with nothing pending
+static void testSession()
+{
+    printf("session sync\n");
+    host_reset();
+    WatcherDisplay display;
+    display.begin(false, ROTATE_0);
+    display.setDifferentialRefresh(true, 0);
+    display.setTileCleaning(true);
+    display.setDeferredMaintenance(true);
+    display.clear();
+
+    UBYTE *buffer = display.getBuffer();
+    srand(5);
+    uint32_t checks = 0, outOfSync = 0;
+    unsigned long end = millis() + 25UL * 60 * 1000;
+    unsigned long nextDraw = millis();
+    bool idle = false;
+
+    while (millis() < end) {
+        display.poll();
+        if (millis() >= nextDraw) {
+            uint16_t x = rand() % 380, y = rand() % 280;
+            uint16_t w = 1 + rand() % (DISPLAY_WIDTH - x), h = 1 + rand() % 20;
+            display.fillRegion(x, y, w, h, (rand() & 1) ? BLACK : WHITE);
+            display.markDirty(UIRegion(x, y, w, h),
+                              (rand() & 1) ? LATENCY_INTERACTIVE_MS : LATENCY_PROGRESS_MS);
+            nextDraw = millis() + 200 + rand() % 1800;
+        }
+        display.serviceUpdates();
+
+        if ((millis() / 60000) % 5 == 4) {
+            if (!idle) display.declareIdleWindow(2000);
+            idle = true;
+        } else {
+            idle = false;
+        }
+        display.maintainDisplay();
+
+        if (!display.poll() && !display.hasPendingUpdates()) {
+            checks++;
+            if (host_shown_diff(buffer) || host_ram_diff(0x24, buffer)) outOfSync++;
+        }
+        delay(10);
+    }
+    display.waitForRefresh();
+
+    printf("  %u idle checks, %u out of sync; %lu partials, %lu fulls, BUSY %.0f s\n",
+           checks, outOfSync, host_panel.waveforms[0xFF], host_panel.waveforms[0xF7],
+           host_panel.busyMs / 1000.0);
+    CHECK(checks > 1000);
+    CHECK_EQ(outOfSync, 0);
+    CHECK_EQ(host_panel.fullWithPartialRegs, 0);
+}
+
+int main()
+{
+    testFrameTransactions();
+    testPartialTransactions();
+    testFullAfterPartial();
+    testAsyncRefresh();
+    testRefreshTimeout();
+    testGrayPlanes();
+    testSession();
+    return host_test_summary("test_panel");
+}
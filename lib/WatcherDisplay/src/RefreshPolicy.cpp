@@ -0,0 +1,136 @@
+/**
+ * RefreshPolicy - Implementation
+ */
+
+#include "RefreshPolicy.h"
+#include <string.h>
+
+// ========== RefreshPolicy ==========
+
+RefreshPolicy::RefreshPolicy()
+    : fastFullMs(DEFAULT_FAST_FULL_WAVEFORM_MS),
+      fullMs(DEFAULT_FULL_WAVEFORM_MS),
+      traceCallback(nullptr),
+      traceContext(nullptr),
+      busyMs(0) {
+    memset(counts, 0, sizeof(counts));
+}
+
+RefreshWaveform RefreshPolicy::decide(const RefreshUpdate& update) {
+    RefreshWaveform waveform = choose(update);
+    applied(waveform, &update);
+
+    RefreshDecision decision;
+    decision.waveform = waveform;
+    decision.update = update;
+    decision.level = level();
+    decision.busyMs = (waveform == WAVEFORM_PARTIAL) ? update.partialMs : getWaveformTime(waveform);
+
+    counts[waveform]++;
+    busyMs += decision.busyMs;
+    if (traceCallback) {
+        traceCallback(decision, traceContext);
+    }
+    return waveform;
+}
+
+void RefreshPolicy::noteWaveformTime(RefreshWaveform waveform, uint32_t ms) {
+    if (waveform == WAVEFORM_FAST_FULL) {
+        fastFullMs += ((int32_t)ms - (int32_t)fastFullMs) / 4;
+    } else if (waveform == WAVEFORM_FULL) {
+        fullMs += ((int32_t)ms - (int32_t)fullMs) / 4;
+    }
+}
+
+void RefreshPolicy::setWaveformTimes(uint32_t fastFull, uint32_t full) {
+    fastFullMs = fastFull;
+    fullMs = full;
+}
+
+uint32_t RefreshPolicy::getWaveformTime(RefreshWaveform waveform) const {
+    if (waveform == WAVEFORM_FAST_FULL) return fastFullMs;
+    if (waveform == WAVEFORM_FULL) return fullMs;
+    return 0;
+}
+
+uint32_t RefreshPolicy::getCount(RefreshWaveform waveform) const {
+    return (waveform < WAVEFORM_COUNT) ? counts[waveform] : 0;
+}
+
+void RefreshPolicy::resetStats() {
+    memset(counts, 0, sizeof(counts));
+    busyMs = 0;
+}
+
+// ========== IntervalRefreshPolicy ==========
+
+RefreshWaveform IntervalRefreshPolicy::choose(const RefreshUpdate& update) {
+    (void)update;
+    if (interval > 0 && partials >= interval) return WAVEFORM_FULL;
+    return WAVEFORM_PARTIAL;
+}
+
+void IntervalRefreshPolicy::applied(RefreshWaveform waveform, const RefreshUpdate* update) {
+    (void)update;
+    if (waveform == WAVEFORM_PARTIAL) {
+        partials++;
+    } else {
+        partials = 0;
+    }
+}
+
+// ========== GhostBudgetPolicy ==========
+
+GhostBudgetPolicy::GhostBudgetPolicy(uint32_t ceiling)
+    : ceiling(ceiling),
+      areaWeight(DEFAULT_GHOST_AREA_WEIGHT),
+      flipWeight(DEFAULT_GHOST_FLIP_WEIGHT),
+      residue(DEFAULT_FAST_FULL_RESIDUE),
+      ghost(0),
+      deepGhost(0) {
+}
+
+void GhostBudgetPolicy::setWeights(uint16_t area, uint16_t flip) {
+    areaWeight = area;
+    flipWeight = flip;
+}
+
+uint32_t GhostBudgetPolicy::weigh(const RefreshUpdate& update) const {
+    uint64_t units = (uint64_t)update.area * areaWeight + (uint64_t)update.flipped * flipWeight;
+    units >>= 8;
+    return (units > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t)units;
+}
+
+RefreshWaveform GhostBudgetPolicy::choose(const RefreshUpdate& update) {
+    // Budget each clean buys back, and the cheaper one per unit:
+    // fastFullMs / fastBudget < fullMs / ceiling
+    uint64_t left = residue ? (uint64_t)deepGhost + ghost / residue : ceiling;
+    uint32_t fastBudget = (left < ceiling) ? ceiling - (uint32_t)left : 0;
+    RefreshWaveform clean = WAVEFORM_FULL;
+    uint32_t cleanBudget = ceiling;
+    uint32_t cleanMs = fullMs;
+    if (fastBudget > 0 && (uint64_t)fastFullMs * ceiling < (uint64_t)fullMs * fastBudget) {
+        clean = WAVEFORM_FAST_FULL;
+        cleanBudget = fastBudget;
+        cleanMs = fastFullMs;
+    }
+    if (cleanMs == 0) return clean;
+
+    // A partial now, and the clean later, beats cleaning now (and throwing
+    // the unused budget away) while that budget is worth more than a partial
+    uint64_t margin = (uint64_t)update.partialMs * cleanBudget / cleanMs;
+    uint64_t after = (uint64_t)ghost + deepGhost + weigh(update) + margin;
+    return (after <= ceiling) ? WAVEFORM_PARTIAL : clean;
+}
+
+void GhostBudgetPolicy::applied(RefreshWaveform waveform, const RefreshUpdate* update) {
+    if (waveform == WAVEFORM_PARTIAL) {
+        if (update) ghost += weigh(*update);
+    } else if (waveform == WAVEFORM_FAST_FULL) {
+        if (residue) deepGhost += ghost / residue;
+        ghost = 0;
+    } else {
+        ghost = 0;
+        deepGhost = 0;
+    }
+}
@@ -0,0 +1,213 @@
+/**
+ * RefreshPolicy - Picks the waveform for each WatcherDisplay update
+ *
+ * Partial updates are fast but leave ghosting behind; the full-screen
+ * waveforms clean it at the price of a flash and seconds of BUSY. A policy
+ * sees every update before it reaches the panel (its area and how many
+ * pixels flip) and chooses partial, fast-full or full.
+ *
+ * Features:
+ * - IntervalRefreshPolicy: the classic "full refresh every N partials"
+ * - GhostBudgetPolicy: ghosting budget weighted by area and flipped pixels,
+ *   bought back with whichever full waveform is cheaper per unit of budget
+ * - Decision trace callback and busy-time totals, for tuning on a host
+ * - Full waveform times refined from measured refreshes
+ *
+ * Usage:
+ *   GhostBudgetPolicy policy;
+ *   display.setRefreshPolicy(&policy);
+ */
+
+#ifndef REFRESH_POLICY_H
+#define REFRESH_POLICY_H
+
+#include <Arduino.h>
+
+// Blocking time of the full-screen waveforms, until measured
+#define DEFAULT_FAST_FULL_WAVEFORM_MS 1500  // EPD_4IN2_V2_Init_Fast(Seconds_1_5S) + Display_Fast
+#define DEFAULT_FULL_WAVEFORM_MS      3000
+
+// GhostBudgetPolicy defaults
+#define DEFAULT_GHOST_CEILING     60000  // Ghost units on the panel before it must be cleaned
+#define DEFAULT_GHOST_AREA_WEIGHT 32     // Units per 256 rewritten pixels that keep their colour
+#define DEFAULT_GHOST_FLIP_WEIGHT 256    // Units per 256 pixels that change colour
+#define DEFAULT_FAST_FULL_RESIDUE 4      // A fast full leaves 1/N of the ghosting it cleans
+
+/**
+ * RefreshWaveform - How an update reaches the panel
+ */
+enum RefreshWaveform {
+    WAVEFORM_PARTIAL = 0,  // Partial update of the changed windows
+    WAVEFORM_FAST_FULL,    // Whole screen, fast LUT (shorter flash, cleans less)
+    WAVEFORM_FULL,         // Whole screen, standard LUT
+    WAVEFORM_COUNT
+};
+
+/**
+ * RefreshUpdate - What an update is about to change
+ */
+struct RefreshUpdate {
+    uint32_t area;       // Pixels in the update's windows
+    uint32_t flipped;    // Pixels that change colour (area when unknown)
+    uint32_t partialMs;  // Estimated blocking time as a partial refresh
+};
+
+/**
+ * RefreshDecision - One entry of the decision trace
+ */
+struct RefreshDecision {
+    RefreshWaveform waveform;
+    RefreshUpdate update;
+    uint32_t level;      // Policy state after the update (ghost units, or
+                         // partials since the last clean for the interval policy)
+    uint32_t busyMs;     // Estimated blocking time of the chosen waveform
+};
+
+typedef void (*RefreshTraceCallback)(const RefreshDecision& decision, void* context);
+
+/**
+ * RefreshPolicy - Base class; subclasses implement choose() and applied()
+ */
+class RefreshPolicy {
+public:
+    RefreshPolicy();
+    virtual ~RefreshPolicy() {}
+
+    /**
+     * Choose the waveform for an update and account for it
+     * @param update Area, flipped pixels and partial cost of the update
+     * @return Waveform the display should use
+     */
+    RefreshWaveform decide(const RefreshUpdate& update);
+
+    /**
+     * Account for a full-screen refresh started outside decide()
+     * (fullRefresh(), clear(), a shadow resync)
+     */
+    void noteRefresh(RefreshWaveform waveform) { applied(waveform, nullptr); }
+
+    /**
+     * Feed back the measured time of a full-screen waveform
+     * Moving average with 1/4 weight, like the partial cost model.
+     */
+    void noteWaveformTime(RefreshWaveform waveform, uint32_t ms);
+
+    /**
+     * Set or get the blocking time assumed for the full-screen waveforms
+     */
+    void setWaveformTimes(uint32_t fastFullMs, uint32_t fullMs);
+    uint32_t getWaveformTime(RefreshWaveform waveform) const;
+
+    /**
+     * Set a callback fired for every decide()
+     */
+    void setTraceCallback(RefreshTraceCallback callback, void* context = nullptr) {
+        traceCallback = callback;
+        traceContext = context;
+    }
+
+    /**
+     * Decisions per waveform, and their estimated total blocking time
+     */
+    uint32_t getCount(RefreshWaveform waveform) const;
+    uint32_t getBusyMs() const { return busyMs; }
+    void resetStats();
+
+protected:
+    /**
+     * Pick a waveform, without changing any state
+     */
+    virtual RefreshWaveform choose(const RefreshUpdate& update) = 0;
+
+    /**
+     * Update the state for a waveform that is being sent
+     * @param update The update it shows, or nullptr from noteRefresh()
+     */
+    virtual void applied(RefreshWaveform waveform, const RefreshUpdate* update) = 0;
+
+    /**
+     * Current state, reported in the trace
+     */
+    virtual uint32_t level() const = 0;
+
+    uint32_t fastFullMs;
+    uint32_t fullMs;
+
+private:
+    RefreshTraceCallback traceCallback;
+    void* traceContext;
+    uint32_t counts[WAVEFORM_COUNT];
+    uint32_t busyMs;
+};
+
+/**
+ * IntervalRefreshPolicy - A full refresh instead of every (interval + 1)th partial
+ * The fixed counter WatcherDisplay uses without a policy, as a policy
+ * object for comparison. interval 0 never cleans.
+ */
+class IntervalRefreshPolicy : public RefreshPolicy {
+public:
+    IntervalRefreshPolicy(uint8_t interval = 5) : interval(interval), partials(0) {}
+
+protected:
+    RefreshWaveform choose(const RefreshUpdate& update) override;
+    void applied(RefreshWaveform waveform, const RefreshUpdate* update) override;
+    uint32_t level() const override { return partials; }
+
+private:
+    uint8_t interval;
+    uint32_t partials;   // Partials since the last full refresh
+};
+
+/**
+ * GhostBudgetPolicy - Spend a ghosting budget on partials, clean when it pays
+ *
+ * Each partial adds (area * areaWeight + flipped * flipWeight) / 256 ghost
+ * units. A fast full clears them but leaves 1/residue behind, which only
+ * a full clears; ghosting never exceeds the ceiling.
+ *
+ * Cleaning buys budget back: a fast full buys (ceiling - what it leaves)
+ * units, a full buys the whole ceiling, and the policy uses whichever is
+ * cheaper per unit. An update goes out as a partial while, after it, the
+ * budget left is still worth more than one partial refresh at that price;
+ * otherwise it rides on the clean, which would have come a few updates
+ * later anyway.
+ */
+class GhostBudgetPolicy : public RefreshPolicy {
+public:
+    GhostBudgetPolicy(uint32_t ceiling = DEFAULT_GHOST_CEILING);
+
+    /**
+     * Set the ghost units per 256 pixels rewritten / flipped
+     */
+    void setWeights(uint16_t areaWeight, uint16_t flipWeight);
+
+    /**
+     * Set the share of ghosting a fast full leaves behind (1/residue)
+     * @param residue Divisor, 0 = never use the fast full waveform
+     */
+    void setFastFullResidue(uint8_t residue) { this->residue = residue; }
+
+    void setCeiling(uint32_t ceiling) { this->ceiling = ceiling; }
+    uint32_t getCeiling() const { return ceiling; }
+
+    /**
+     * Ghost units an update adds as a partial
+     */
+    uint32_t weigh(const RefreshUpdate& update) const;
+
+protected:
+    RefreshWaveform choose(const RefreshUpdate& update) override;
+    void applied(RefreshWaveform waveform, const RefreshUpdate* update) override;
+    uint32_t level() const override { return ghost + deepGhost; }
+
+private:
+    uint32_t ceiling;
+    uint16_t areaWeight;
+    uint16_t flipWeight;
+    uint8_t residue;
+    uint32_t ghost;      // Cleared by either full waveform
+    uint32_t deepGhost;  // Left by fast fulls, cleared by a full
+};
+
+#endif // REFRESH_POLICY_H
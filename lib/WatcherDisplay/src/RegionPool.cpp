@@ -0,0 +1,109 @@
+/**
+ * RegionPool - Implementation
+ */
+
+#include "RegionPool.h"
+#include <stdlib.h>
+
+RegionPool::RegionPool()
+    : arena(nullptr),
+      slotSize(0),
+      slotCount(0),
+      usedMask(0),
+      inUse(0),
+      highWater(0),
+      failedCount(0),
+      inPsram(false) {
+}
+
+RegionPool::~RegionPool() {
+    end();
+}
+
+bool RegionPool::begin(uint32_t size, uint8_t count, bool usePsram) {
+    end();
+
+    if (size == 0 || count == 0) return false;
+    if (count > REGION_POOL_MAX_SLOTS) count = REGION_POOL_MAX_SLOTS;
+
+    // Keep every slot word aligned
+    size = (size + 3) & ~(uint32_t)3;
+
+#ifdef BOARD_HAS_PSRAM
+    if (usePsram) {
+        arena = (UBYTE*)ps_malloc(size * count);
+        inPsram = arena != nullptr;
+    }
+#else
+    (void)usePsram;
+#endif
+    if (!arena) {
+        arena = (UBYTE*)malloc(size * count);
+    }
+    if (!arena) {
+        Serial.printf("Failed to allocate region pool (%lu bytes)!\n",
+                      (unsigned long)(size * count));
+        return false;
+    }
+
+    slotSize = size;
+    slotCount = count;
+    usedMask = 0;
+    inUse = 0;
+    highWater = 0;
+    failedCount = 0;
+
+    Serial.printf("Region pool: %d x %lu bytes%s\n", slotCount,
+                  (unsigned long)slotSize, inPsram ? " (PSRAM)" : "");
+    return true;
+}
+
+void RegionPool::end() {
+    free(arena);
+    arena = nullptr;
+    slotSize = 0;
+    slotCount = 0;
+    usedMask = 0;
+    inUse = 0;
+    inPsram = false;
+}
+
+UBYTE* RegionPool::allocate(uint32_t size) {
+    if (!arena || size > slotSize) {
+        failedCount++;
+        return nullptr;
+    }
+
+    for (uint8_t i = 0; i < slotCount; i++) {
+        uint32_t bit = (uint32_t)1 << i;
+        if (!(usedMask & bit)) {
+            usedMask |= bit;
+            inUse++;
+            if (inUse > highWater) highWater = inUse;
+            return arena + (uint32_t)i * slotSize;
+        }
+    }
+
+    failedCount++;
+    return nullptr;
+}
+
+bool RegionPool::release(const void* buffer) {
+    if (!owns(buffer)) return false;
+
+    uint8_t slot = ((const UBYTE*)buffer - arena) / slotSize;
+    uint32_t bit = (uint32_t)1 << slot;
+    if (usedMask & bit) {
+        usedMask &= ~bit;
+        inUse--;
+    }
+    return true;
+}
+
+bool RegionPool::owns(const void* buffer) const {
+    if (!arena || !buffer) return false;
+
+    const UBYTE* p = (const UBYTE*)buffer;
+    if (p < arena || p >= arena + slotSize * slotCount) return false;
+    return (uint32_t)(p - arena) % slotSize == 0;
+}
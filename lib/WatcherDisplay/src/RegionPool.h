@@ -0,0 +1,87 @@
+/**
+ * RegionPool - Fixed-slot buffer allocator for WatcherDisplay
+ *
+ * One arena is allocated up front and carved into equal slots, so region
+ * and sub-buffers never touch the heap at runtime. A device that runs for
+ * days keeps a predictable heap and predictable timing.
+ *
+ * Features:
+ * - Fixed slot size and count, chosen once in begin()
+ * - O(slots) allocate/release, no fragmentation
+ * - High-water mark and failed-allocation statistics
+ * - Optional arena placement in PSRAM (BOARD_HAS_PSRAM)
+ */
+
+#ifndef REGION_POOL_H
+#define REGION_POOL_H
+
+#include <Arduino.h>
+#include "DEV_Config.h"
+
+// Maximum number of slots (one bit each in the occupancy mask)
+#define REGION_POOL_MAX_SLOTS 32
+
+/**
+ * RegionPool - Arena of equal-sized buffers
+ */
+class RegionPool {
+public:
+    RegionPool();
+    ~RegionPool();
+
+    /**
+     * Allocate the arena
+     * @param slotSize Largest buffer the pool hands out, in bytes
+     * @param slotCount Number of buffers (max REGION_POOL_MAX_SLOTS)
+     * @param usePsram Place the arena in PSRAM (only with BOARD_HAS_PSRAM)
+     * @return true if the arena was allocated
+     */
+    bool begin(uint32_t slotSize, uint8_t slotCount, bool usePsram = false);
+
+    /**
+     * Free the arena (all outstanding buffers become invalid)
+     */
+    void end();
+
+    /**
+     * Take a free slot
+     * @param size Requested size in bytes (must fit in one slot)
+     * @return Buffer, or nullptr if too large or the pool is exhausted
+     */
+    UBYTE* allocate(uint32_t size);
+
+    /**
+     * Return a slot to the pool
+     * @return false if the pointer does not belong to this pool
+     */
+    bool release(const void* buffer);
+
+    /**
+     * Check whether a pointer is one of this pool's slots
+     */
+    bool owns(const void* buffer) const;
+
+    bool isReady() const { return arena != nullptr; }
+    bool isInPsram() const { return inPsram; }
+    uint32_t getSlotSize() const { return slotSize; }
+    uint8_t getSlotCount() const { return slotCount; }
+    uint8_t getInUse() const { return inUse; }
+    uint8_t getHighWater() const { return highWater; }
+    uint32_t getFailedCount() const { return failedCount; }
+
+private:
+    // Prevent copying
+    RegionPool(const RegionPool&) = delete;
+    RegionPool& operator=(const RegionPool&) = delete;
+
+    UBYTE* arena;
+    uint32_t slotSize;
+    uint8_t slotCount;
+    uint32_t usedMask;             // Bit n set: slot n handed out
+    uint8_t inUse;
+    uint8_t highWater;             // Most slots ever in use at once
+    uint32_t failedCount;          // allocate() calls that returned nullptr
+    bool inPsram;
+};
+
+#endif // REGION_POOL_H
@@ -0,0 +1,381 @@
+/**
+ * VectorAsset - Compile-time rasterization of SVG shapes into 1bpp bitmaps
+ *
+ * UI shapes exported from Figma (icons, mode pills, 7-segment digits) are
+ * described by their SVG path data and scan-converted by the compiler, so
+ * the firmware only carries packed bitmaps in flash and never rasterizes
+ * them at runtime.
+ *
+ * Features:
+ * - C++17 constexpr scanline fill, sampled at pixel centres
+ * - SVG path subset used by the exports: absolute M, L, H, V, C, Z
+ * - Non-zero and even-odd fill rules, white layers cut out of black ones
+ * - Integer polygons filled exactly as Paint_DrawPolygon fills them
+ * - Ink bounding box computed with the bitmap, for partial refresh regions
+ * - sFONT row layout (set bit = ink), drawn with WatcherDisplay::drawAsset()
+ *
+ * Usage (C++17, included by the sketch; WatcherDisplay.h only declares it):
+ *   #include "VectorAsset.h"
+ *   constexpr auto ICON_STOP = vectorRasterize<13, 13>("M3 0C1.34 0 0 1.34 ...Z");
+ *   display.drawAsset(356, 270, ICON_STOP);
+ */
+
+#ifndef VECTOR_ASSET_H
+#define VECTOR_ASSET_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "GUI_Paint.h"
+
+#define VECTOR_MAX_CROSSINGS 64  // Edge crossings kept per scanline and layer
+#define VECTOR_CURVE_STEPS   16  // Line segments per cubic Bezier
+
+/**
+ * VectorLayer - One SVG path painted onto the asset
+ * Layers are painted in order, like SVG elements, so a white layer cuts
+ * its shape out of the black ones before it.
+ */
+struct VectorLayer {
+    const char* path;   // SVG path data
+    bool ink;           // true = black (set bits), false = white (clears them)
+    FILL_RULE rule;     // SVG fill-rule (the SVG default is non-zero)
+};
+
+/**
+ * VectorPolygon - Integer outline filled with the Paint_DrawPolygon rules
+ */
+struct VectorPolygon {
+    const int16_t* xs;
+    const int16_t* ys;
+    uint8_t points;
+};
+
+/**
+ * VectorAsset - Packed 1bpp bitmap of W x H pixels
+ */
+template <uint16_t W, uint16_t H>
+struct VectorAsset {
+    static constexpr uint16_t width = W;
+    static constexpr uint16_t height = H;
+    static constexpr uint16_t rowBytes = (W + 7) / 8;
+
+    uint8_t bits[rowBytes * H];  // Rows of rowBytes, MSB first, set bit = ink
+    uint16_t inkX, inkY;         // Bounding box of the set bits
+    uint16_t inkW, inkH;         // (0 x 0 for an empty asset)
+};
+
+constexpr int vectorCeil(float v) {
+    int i = (int)v;
+    return (v > i) ? i + 1 : i;
+}
+
+/**
+ * VectorEdgeTable - Edge crossings of every scanline of an H-row asset
+ * A path is traced once per layer; each segment drops its crossing into
+ * the rows it spans. More than VECTOR_MAX_CROSSINGS crossings in one row
+ * is an out-of-bounds write, which fails the constant evaluation (raise
+ * the limit for such an asset).
+ */
+template <uint16_t H>
+struct VectorEdgeTable {
+    uint8_t count[H];
+    float xs[H][VECTOR_MAX_CROSSINGS];
+    int8_t dirs[H][VECTOR_MAX_CROSSINGS];  // +1 downward edge, -1 upward
+
+    // Record a segment at the rows whose centre lies in [top, bottom)
+    constexpr void edge(float x0, float y0, float x1, float y1) {
+        if (y0 == y1) return;
+        int8_t dir = (y1 > y0) ? 1 : -1;
+        float top = (dir > 0) ? y0 : y1;
+        float bottom = (dir > 0) ? y1 : y0;
+        int r0 = vectorCeil(top - 0.5f);
+        int r1 = vectorCeil(bottom - 0.5f);
+        if (r0 < 0) r0 = 0;
+        if (r1 > H) r1 = H;
+        float slope = (x1 - x0) / (y1 - y0);
+        for (int r = r0; r < r1; r++) {
+            xs[r][count[r]] = x0 + (r + 0.5f - y0) * slope;
+            dirs[r][count[r]] = dir;
+            count[r]++;
+        }
+    }
+};
+
+// ========== Path parsing ==========
+
+constexpr bool vectorIsSeparator(char c) {
+    return c == ' ' || c == ',' || c == '\t' || c == '\n' || c == '\r';
+}
+
+constexpr bool vectorIsNumberStart(char c) {
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.';
+}
+
+/**
+ * Read count numbers (SVG syntax, exponents included)
+ * @return false if the path data runs out first
+ */
+constexpr bool vectorReadNumbers(const char* d, size_t& i, float* out, uint8_t count) {
+    for (uint8_t n = 0; n < count; n++) {
+        while (vectorIsSeparator(d[i])) i++;
+        if (!vectorIsNumberStart(d[i])) return false;
+
+        float sign = 1.0f;
+        if (d[i] == '-' || d[i] == '+') {
+            if (d[i] == '-') sign = -1.0f;
+            i++;
+        }
+        float value = 0.0f;
+        while (d[i] >= '0' && d[i] <= '9') value = value * 10.0f + (d[i++] - '0');
+        if (d[i] == '.') {
+            i++;
+            float scale = 0.1f;
+            while (d[i] >= '0' && d[i] <= '9') {
+                value += (d[i++] - '0') * scale;
+                scale *= 0.1f;
+            }
+        }
+        if (d[i] == 'e' || d[i] == 'E') {
+            i++;
+            bool negative = (d[i] == '-');
+            if (d[i] == '-' || d[i] == '+') i++;
+            int exponent = 0;
+            while (d[i] >= '0' && d[i] <= '9') exponent = exponent * 10 + (d[i++] - '0');
+            for (; exponent > 0; exponent--) value = negative ? value / 10.0f : value * 10.0f;
+        }
+        out[n] = sign * value;
+    }
+    return true;
+}
+
+/**
+ * Walk a path and feed every segment to the edge table
+ * Cubic Beziers are flattened into VECTOR_CURVE_STEPS lines and open
+ * subpaths are closed, as SVG does for fills. Parsing stops at the first
+ * unsupported command or malformed argument.
+ */
+template <class EdgeSink>
+constexpr void vectorTracePath(const char* d, EdgeSink& edges) {
+    float cx = 0, cy = 0;   // Current point
+    float sx = 0, sy = 0;   // Subpath start
+    bool open = false;
+    char cmd = 0;
+    size_t i = 0;
+
+    while (true) {
+        while (vectorIsSeparator(d[i])) i++;
+        if (d[i] == 0) break;
+        if (!vectorIsNumberStart(d[i])) {
+            cmd = d[i++];
+        } else if (cmd == 0) {
+            break;
+        }
+
+        float a[6] = {};
+        if (cmd == 'M') {
+            if (!vectorReadNumbers(d, i, a, 2)) break;
+            if (open) edges.edge(cx, cy, sx, sy);
+            cx = sx = a[0];
+            cy = sy = a[1];
+            open = true;
+            cmd = 'L';  // Further pairs are line-tos
+        } else if (cmd == 'L') {
+            if (!vectorReadNumbers(d, i, a, 2)) break;
+            edges.edge(cx, cy, a[0], a[1]);
+            cx = a[0];
+            cy = a[1];
+        } else if (cmd == 'H') {
+            if (!vectorReadNumbers(d, i, a, 1)) break;
+            cx = a[0];  // Horizontal segments never cross a scanline
+        } else if (cmd == 'V') {
+            if (!vectorReadNumbers(d, i, a, 1)) break;
+            edges.edge(cx, cy, cx, a[0]);
+            cy = a[0];
+        } else if (cmd == 'C') {
+            if (!vectorReadNumbers(d, i, a, 6)) break;
+            float px = cx, py = cy;
+            for (uint8_t s = 1; s <= VECTOR_CURVE_STEPS; s++) {
+                float t = (float)s / VECTOR_CURVE_STEPS;
+                float u = 1.0f - t;
+                float qx = u * u * u * cx + 3 * u * u * t * a[0] + 3 * u * t * t * a[2] + t * t * t * a[4];
+                float qy = u * u * u * cy + 3 * u * u * t * a[1] + 3 * u * t * t * a[3] + t * t * t * a[5];
+                edges.edge(px, py, qx, qy);
+                px = qx;
+                py = qy;
+            }
+            cx = a[4];
+            cy = a[5];
+        } else if (cmd == 'Z' || cmd == 'z') {
+            if (open) edges.edge(cx, cy, sx, sy);
+            cx = sx;
+            cy = sy;
+            open = false;
+            cmd = 0;  // Z takes no arguments
+        } else {
+            break;
+        }
+    }
+
+    if (open) edges.edge(cx, cy, sx, sy);
+}
+
+// ========== Rasterization ==========
+
+/**
+ * Compute the ink bounding box of a finished asset
+ */
+template <uint16_t W, uint16_t H>
+constexpr void vectorInkBox(VectorAsset<W, H>& asset) {
+    constexpr uint16_t rowBytes = VectorAsset<W, H>::rowBytes;
+    uint16_t x1 = W, y1 = H, x2 = 0, y2 = 0;
+    for (uint16_t y = 0; y < H; y++) {
+        for (uint16_t x = 0; x < W; x++) {
+            if (asset.bits[y * rowBytes + x / 8] & (0x80 >> (x % 8))) {
+                if (x < x1) x1 = x;
+                if (x > x2) x2 = x;
+                if (y < y1) y1 = y;
+                if (y > y2) y2 = y;
+            }
+        }
+    }
+    if (x1 <= x2) {
+        asset.inkX = x1;
+        asset.inkY = y1;
+        asset.inkW = x2 - x1 + 1;
+        asset.inkH = y2 - y1 + 1;
+    }
+}
+
+/**
+ * Rasterize layers into a W x H asset
+ * A pixel is inside a path when its centre is, under the layer's fill rule.
+ */
+template <uint16_t W, uint16_t H>
+constexpr VectorAsset<W, H> vectorRasterize(const VectorLayer* layers, size_t count) {
+    VectorAsset<W, H> asset{};
+    constexpr uint16_t rowBytes = VectorAsset<W, H>::rowBytes;
+
+    VectorEdgeTable<H> table{};
+
+    for (size_t l = 0; l < count; l++) {
+        for (uint16_t row = 0; row < H; row++) table.count[row] = 0;
+        vectorTracePath(layers[l].path, table);
+
+        for (uint16_t row = 0; row < H; row++) {
+            float* xs = table.xs[row];
+            int8_t* dirs = table.dirs[row];
+            uint8_t crossings = table.count[row];
+            uint8_t* bits = asset.bits + row * rowBytes;
+
+            // Insertion sort by x (a handful of crossings per row)
+            for (uint8_t k = 1; k < crossings; k++) {
+                float x = xs[k];
+                int8_t dir = dirs[k];
+                uint8_t j = k;
+                for (; j > 0 && xs[j - 1] > x; j--) {
+                    xs[j] = xs[j - 1];
+                    dirs[j] = dirs[j - 1];
+                }
+                xs[j] = x;
+                dirs[j] = dir;
+            }
+
+            int winding = 0;
+            float spanStart = 0;
+            for (uint8_t k = 0; k < crossings; k++) {
+                bool wasInside = (layers[l].rule == FILL_RULE_NONZERO) ? winding != 0 : (winding & 1);
+                winding += dirs[k];
+                bool isInside = (layers[l].rule == FILL_RULE_NONZERO) ? winding != 0 : (winding & 1);
+                if (!wasInside && isInside) {
+                    spanStart = xs[k];
+                } else if (wasInside && !isInside) {
+                    int x0 = vectorCeil(spanStart - 0.5f);
+                    int x1 = vectorCeil(xs[k] - 0.5f);
+                    if (x0 < 0) x0 = 0;
+                    if (x1 > W) x1 = W;
+                    for (int x = x0; x < x1; x++) {
+                        if (layers[l].ink)
+                            bits[x / 8] |= (uint8_t)(0x80 >> (x % 8));
+                        else
+                            bits[x / 8] &= (uint8_t)~(0x80 >> (x % 8));
+                    }
+                }
+            }
+        }
+    }
+
+    vectorInkBox(asset);
+    return asset;
+}
+
+template <uint16_t W, uint16_t H, size_t N>
+constexpr VectorAsset<W, H> vectorRasterize(const VectorLayer (&layers)[N]) {
+    return vectorRasterize<W, H>(layers, N);
+}
+
+/**
+ * Rasterize a single black path
+ */
+template <uint16_t W, uint16_t H>
+constexpr VectorAsset<W, H> vectorRasterize(const char* path, FILL_RULE rule = FILL_RULE_NONZERO) {
+    const VectorLayer layer = { path, true, rule };
+    return vectorRasterize<W, H>(&layer, 1);
+}
+
+/**
+ * Rasterize integer polygons into a W x H asset, each one filled like
+ * Paint_DrawPolygon(..., DRAW_FILL_FULL) fills it
+ * Same arithmetic as Paint_FillPolygon: scanlines at integer y, edges in
+ * 16.16 with the step rounded up, even-odd rule, and each inside run
+ * drawn from its rounded start to its rounded end inclusive. Shapes that
+ * used to be drawn as polygons therefore come out pixel for pixel.
+ */
+template <uint16_t W, uint16_t H>
+constexpr VectorAsset<W, H> vectorRasterizePolygons(const VectorPolygon* polygons, size_t count) {
+    VectorAsset<W, H> asset{};
+    constexpr uint16_t rowBytes = VectorAsset<W, H>::rowBytes;
+
+    for (size_t p = 0; p < count; p++) {
+        const VectorPolygon& poly = polygons[p];
+        for (int y = 0; y < H; y++) {
+            int32_t xs[VECTOR_MAX_CROSSINGS] = {};
+            uint8_t crossings = 0;
+            for (uint8_t i = 0; i < poly.points; i++) {
+                uint8_t next = (i + 1 == poly.points) ? 0 : i + 1;
+                int32_t x1 = poly.xs[i], y1 = poly.ys[i];
+                int32_t x2 = poly.xs[next], y2 = poly.ys[next];
+                if (y1 == y2) continue;
+                if (y1 > y2) {
+                    int32_t t = x1; x1 = x2; x2 = t;
+                    t = y1; y1 = y2; y2 = t;
+                }
+                if (y < y1 || y >= y2) continue;
+                int32_t run = (x2 - x1) * 65536;
+                int32_t dx = (run > 0) ? (run + (y2 - y1) - 1) / (y2 - y1) : run / (y2 - y1);
+                xs[crossings++] = x1 * 65536 + (int32_t)((int64_t)(y - y1) * dx);
+            }
+
+            for (uint8_t k = 1; k < crossings; k++) {
+                int32_t x = xs[k];
+                uint8_t j = k;
+                for (; j > 0 && xs[j - 1] > x; j--) xs[j] = xs[j - 1];
+                xs[j] = x;
+            }
+
+            uint8_t* bits = asset.bits + y * rowBytes;
+            for (uint8_t k = 0; k + 1 < crossings; k += 2) {
+                int x0 = (xs[k] + 0x8000) >> 16;
+                int x1 = (xs[k + 1] + 0x8000) >> 16;
+                if (x0 < 0) x0 = 0;
+                if (x1 >= W) x1 = W - 1;
+                for (int x = x0; x <= x1; x++)
+                    bits[x / 8] |= (uint8_t)(0x80 >> (x % 8));
+            }
+        }
+    }
+
+    vectorInkBox(asset);
+    return asset;
+}
+
+#endif // VECTOR_ASSET_H
@@ -16,10 +16,62 @@ WatcherDisplay::WatcherDisplay(uint8_t fullRefreshInterval)
       partialRefreshCount(0),
       fullRefreshInterval(fullRefreshInterval),
       autoFullRefreshEnabled(true),
-      initialized(false) {
+      initialized(false),
+      grayscale(false),
+      shadowBuffer(nullptr),
+      differentialEnabled(false),
+      shadowValid(false),
+      rotation(ROTATE_270),
+      uprightBuffer(nullptr),
+      uprightActive(false),
+      uprightStaleValid(false),
+      uprightStale(),
+      refreshState(REFRESH_IDLE),
+      lastRefreshResult(REFRESH_COMPLETED),
+      refreshStartMs(0),
+      busySeen(false),
+      fullRefreshTimeoutMs(DEFAULT_FULL_REFRESH_TIMEOUT_MS),
+      partialRefreshTimeoutMs(DEFAULT_PARTIAL_REFRESH_TIMEOUT_MS),
+      refreshCallback(nullptr),
+      refreshCallbackContext(nullptr),
+      queuedCount(0),
+      batchMode(BATCH_MULTI_WINDOW),
+      refreshPolicy(nullptr),
+      fastFullRunning(false),
+      tileCleaning(false),
+      tilePartialLimit(DEFAULT_TILE_PARTIAL_LIMIT),
+      tileFlipLimit(DEFAULT_TILE_FLIP_LIMIT),
+      cleanCount(0),
+      cleanInverted(false),
+      cleanFromShadow(false),
+      deferredMaintenance(false),
+      maintenanceMaxDeferMs(DEFAULT_MAINTENANCE_MAX_DEFER_MS),
+      maintenanceDue(false),
+      maintenanceDueMs(0),
+      idleHeld(false),
+      idleWindowOpen(false),
+      idleUntilMs(0),
+      costModel{DEFAULT_COST_FIXED_US, DEFAULT_COST_PER_WINDOW_US, DEFAULT_COST_PER_BYTE_NS},
+      costCalibration(true),
+      lastLoadUs(0),
+      lastLoadWindows(0),
+      captureBuffer(nullptr),
+      floodSeeds(nullptr),
+      polygonScratch(nullptr),
+      polygonScratchPoints(0),
+      updatesPending(false),
+      updateDeadlineMs(0),
+      lastRefreshBytes(0),
+      lastCommitBytes(0),
+      totalCommitBytes(0),
+      commitCount(0) {
+    memset(cachedShapes, 0, sizeof(cachedShapes));
+    memset(ghostTiles, 0, sizeof(ghostTiles));
 }
 
-bool WatcherDisplay::begin(bool fastInit) {
+bool WatcherDisplay::begin(bool fastInit, UWORD rotation,
+                           uint32_t poolSlotSize, uint8_t poolSlots, bool poolInPsram,
+                           bool grayscale) {
     // Initialize hardware
     if (DEV_Module_Init() != 0) {
         Serial.println("E-Paper hardware init failed!");
@@ -27,25 +79,41 @@ bool WatcherDisplay::begin(bool fastInit) {
     }
 
     // Allocate main screen buffer
-    screenBuffer = (UBYTE*)malloc(BUFFER_SIZE);
+    this->grayscale = grayscale;
+    screenBuffer = (UBYTE*)malloc(grayscale ? GRAY_BUFFER_SIZE : BUFFER_SIZE);
     if (!screenBuffer) {
         Serial.println("Failed to allocate screen buffer!");
         return false;
     }
 
+    // Sub-buffers come from a fixed arena so the heap doesn't fragment
+    if (poolSlotSize > 0 && poolSlots > 0 &&
+        !regionPool.begin(poolSlotSize, poolSlots, poolInPsram)) {
+        return false;
+    }
+
     // Initialize Paint library with our buffer
-    Paint_NewImage(screenBuffer, DISPLAY_WIDTH, DISPLAY_HEIGHT, 270, UNCOLORED);
+    this->rotation = rotation;
+    Paint_NewImage(screenBuffer, DISPLAY_WIDTH, DISPLAY_HEIGHT, rotation, UNCOLORED);
+    if (grayscale) Paint_SetScale(4);
     Paint_SelectImage(screenBuffer);
+    Paint_SetDirtyTracking(true);
 
     // Initialize display
-    if (fastInit) {
-        EPD_4IN2_V2_Init_Fast(FULL_REFRESH);
+    if (grayscale) {
+        EPD_4IN2_V2_Init_4Gray();
+    } else if (fastInit) {
+        EPD_4IN2_V2_Init_Fast(Seconds_1_5S);
     } else {
         EPD_4IN2_V2_Init();
     }
 
+    // Latch BUSY edges so refresh completion can be polled
+    DEV_Busy_AttachIRQ();
+
     initialized = true;
     partialRefreshCount = 0;
+    refreshState = REFRESH_IDLE;
 
     Serial.println("WatcherDisplay initialized successfully");
     return true;
@@ -54,16 +122,31 @@ bool WatcherDisplay::begin(bool fastInit) {
 void WatcherDisplay::clear(uint16_t color) {
     if (!initialized || !screenBuffer) return;
 
-    Paint_SelectImage(screenBuffer);
+    waitForRefresh();
+    selectCanvas();
     Paint_Clear(color);
-    EPD_4IN2_V2_Display(screenBuffer);
+    syncUpright();
+    if (grayscale) {
+        EPD_4IN2_V2_Display_4Gray(screenBuffer);
+    } else {
+        EPD_4IN2_V2_Display(screenBuffer);
+    }
     partialRefreshCount = 0;
+    if (refreshPolicy) refreshPolicy->noteRefresh(WAVEFORM_FULL);
+    relieveTiles(1);
+    Paint_ClearDirty();
+
+    if (shadowBuffer) {
+        memcpy(shadowBuffer, screenBuffer, BUFFER_SIZE);
+        shadowValid = true;
+    }
 
     Serial.println("Display cleared");
 }
 
 void WatcherDisplay::sleep() {
     if (!initialized) return;
+    waitForRefresh();
     EPD_4IN2_V2_Sleep();
     Serial.println("Display sleeping");
 }
@@ -74,8 +157,8 @@ void WatcherDisplay::fullRefresh() {
     if (!initialized || !screenBuffer) return;
 
     unsigned long startTime = millis();
-    EPD_4IN2_V2_Display(screenBuffer);
-    partialRefreshCount = 0;
+    if (!beginFullRefresh()) return;
+    waitForRefresh();
 
     unsigned long elapsed = millis() - startTime;
     Serial.printf("Full refresh complete (%lu ms)\n", elapsed);
@@ -87,8 +170,14 @@ void WatcherDisplay::updateRegion(const UIRegion& region) {
     // Perform partial refresh
     partialRefresh(region);
 
-    // Check if we need a full refresh (hybrid strategy)
-    if (autoFullRefreshEnabled && partialRefreshCount >= fullRefreshInterval) {
+    // Check if we need a full refresh (hybrid strategy), or just a
+    // clean of the tiles that ghosted; deferred, the scheduler decides
+    if (deferredMaintenance) {
+        maintainDisplay();
+    } else if (tileCleaning) {
+        if (cleanGhostedTiles()) waitForRefresh();
+    } else if (!refreshPolicy && autoFullRefreshEnabled && fullRefreshInterval > 0 &&
+               partialRefreshCount >= fullRefreshInterval) {
         Serial.printf("Auto full refresh triggered (count: %d)\n", partialRefreshCount);
         fullRefresh();
     }
@@ -102,81 +191,991 @@ void WatcherDisplay::partialRefresh(const UIRegion& region) {
     if (!initialized || !screenBuffer) return;
 
     unsigned long startTime = millis();
+    if (!beginPartialRefresh(region)) return;
+    waitForRefresh();
 
-    // Get byte-aligned region
-    UIRegion aligned = region.getByteAligned();
+    unsigned long elapsed = millis() - startTime;
+    Serial.printf("Partial refresh [%d,%d,%d,%d] complete (%lu ms, count: %d)\n",
+                  activeRegion.x, activeRegion.y, activeRegion.width, activeRegion.height,
+                  elapsed, partialRefreshCount);
+}
 
-    // Validate coordinates
-    if (aligned.x >= DISPLAY_WIDTH || aligned.y >= DISPLAY_HEIGHT) {
+// ========== Asynchronous Refresh ==========
+
+bool WatcherDisplay::beginFullRefresh() {
+    return startFullWaveform(false);
+}
+
+bool WatcherDisplay::beginFastFullRefresh() {
+    return startFullWaveform(!grayscale);
+}
+
+bool WatcherDisplay::startFullWaveform(bool fast) {
+    if (!initialized || !screenBuffer) return false;
+
+    waitForRefresh();
+    syncUpright();
+
+    // The fast LUT is loaded by its init sequence; the standard and
+    // partial waveforms load their own again from the temperature sensor
+    if (fast) {
+        EPD_4IN2_V2_Init_Fast(Seconds_1_5S);
+    }
+    armRefresh();
+
+    EPD_4IN2_V2_SetAsync(1);
+    if (grayscale) {
+        EPD_4IN2_V2_Display_4Gray(screenBuffer);
+    } else if (fast) {
+        EPD_4IN2_V2_Display_Fast(screenBuffer);
+    } else {
+        EPD_4IN2_V2_Display(screenBuffer);
+    }
+    EPD_4IN2_V2_SetAsync(0);
+
+    if (refreshPolicy) {
+        refreshPolicy->noteRefresh(fast ? WAVEFORM_FAST_FULL : WAVEFORM_FULL);
+    }
+    fastFullRunning = fast;
+    relieveTiles(fast ? DEFAULT_FAST_FULL_RESIDUE : 1);
+
+    stageShadow(UIRegion(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT));
+
+    // Anything still queued or drawn is on the panel now
+    queuedCount = 0;
+    Paint_ClearDirty();
+    lastRefreshBytes = 2UL * BUFFER_SIZE;  // 0x24 + 0x26
+
+    startRefresh(REFRESH_FULL_RUNNING);
+    return true;
+}
+
+bool WatcherDisplay::beginPartialRefresh(const UIRegion& region) {
+    if (!initialized || !screenBuffer) return false;
+
+    UIRegion aligned;
+    if (!alignRegion(region, aligned)) {
         Serial.println("Invalid region coordinates");
-        return;
+        return false;
     }
 
-    // Clamp to display bounds
-    if (aligned.right() > DISPLAY_WIDTH) {
-        aligned.width = DISPLAY_WIDTH - aligned.x;
+    return beginPartialWindows(&aligned, 1);
+}
+
+bool WatcherDisplay::queueRegion(const UIRegion& region) {
+    if (!initialized || !screenBuffer) return false;
+
+    UIRegion aligned;
+    if (!alignRegion(region, aligned)) {
+        Serial.println("Invalid region coordinates");
+        return false;
     }
-    if (aligned.bottom() > DISPLAY_HEIGHT) {
-        aligned.height = DISPLAY_HEIGHT - aligned.y;
+
+    if (queuedCount < MAX_QUEUED_REGIONS) {
+        queuedRegions[queuedCount++] = aligned;
+    } else {
+        // Out of slots: let the planner merge the cheapest pair
+        UIRegion pending[MAX_QUEUED_REGIONS + 1];
+        memcpy(pending, queuedRegions, sizeof(queuedRegions));
+        pending[MAX_QUEUED_REGIONS] = aligned;
+        queuedCount = planRegions(pending, MAX_QUEUED_REGIONS + 1, queuedRegions);
     }
+    return true;
+}
 
-    // Calculate region buffer size
-    uint16_t regionBytesPerRow = aligned.width / 8;
-    uint16_t regionBufferSize = regionBytesPerRow * aligned.height;
+bool WatcherDisplay::queueRegion(uint16_t x, uint16_t y, uint16_t width, uint16_t height) {
+    return queueRegion(UIRegion(x, y, width, height));
+}
 
-    // Allocate temporary region buffer
-    UBYTE* regionBuffer = (UBYTE*)malloc(regionBufferSize);
-    if (!regionBuffer) {
-        Serial.println("Failed to allocate region buffer!");
-        return;
+bool WatcherDisplay::flush() {
+    if (queuedCount == 0) return false;
+
+    if (batchMode == BATCH_UNION_WINDOW) {
+        for (uint8_t i = 1; i < queuedCount; i++) {
+            queuedRegions[0] = queuedRegions[0].unionWith(queuedRegions[i]);
+        }
+        queuedCount = 1;
+    } else {
+        UIRegion pending[MAX_QUEUED_REGIONS];
+        memcpy(pending, queuedRegions, queuedCount * sizeof(UIRegion));
+        queuedCount = planRegions(pending, queuedCount, queuedRegions);
     }
 
-    // Extract region data from screen buffer
-    extractRegionBuffer(aligned, regionBuffer);
+    uint8_t count = queuedCount;
+    queuedCount = 0;
+    return beginPartialWindows(queuedRegions, count);
+}
 
-    // Perform partial refresh
-    partialRefreshRaw(aligned, regionBuffer);
+// ========== Refresh Planning ==========
 
-    // Cleanup
-    free(regionBuffer);
+uint32_t WatcherDisplay::windowCostUs(const UIRegion& window) const {
+    // Differential refreshes send every window twice (0x26 and 0x24)
+    uint32_t passes = differentialEnabled ? 2 : 1;
+    uint32_t bytes = (uint32_t)(window.width / 8) * window.height;
+    return passes * (costModel.perWindowUs + bytes * costModel.perByteNs / 1000);
+}
 
-    // Increment counter
-    partialRefreshCount++;
+uint32_t WatcherDisplay::estimateCost(const UIRegion* regions, uint8_t count) const {
+    if (count == 0) return 0;
 
-    unsigned long elapsed = millis() - startTime;
-    Serial.printf("Partial refresh [%d,%d,%d,%d] complete (%lu ms, count: %d)\n",
-                  aligned.x, aligned.y, aligned.width, aligned.height,
-                  elapsed, partialRefreshCount);
+    uint32_t cost = costModel.fixedUs;
+    for (uint8_t i = 0; i < count; i++) {
+        UIRegion aligned;
+        if (alignRegion(regions[i], aligned)) {
+            cost += windowCostUs(aligned);
+        }
+    }
+    return cost;
+}
+
+uint8_t WatcherDisplay::planRegions(const UIRegion* regions, uint8_t count, UIRegion* planned) const {
+    // Windows share one waveform, so the fixed cost drops out: two windows
+    // are merged when their union is no dearer than sending both, and the
+    // cheapest pair is merged anyway while there are too many windows
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        UIRegion aligned;
+        if (!alignRegion(regions[i], aligned)) continue;
+
+        planned[n++] = aligned;
+        if (n > MAX_QUEUED_REGIONS) {
+            n--;
+            // planned[] only holds MAX_QUEUED_REGIONS: fold into the
+            // window whose merge costs least
+            uint8_t best = 0;
+            int32_t bestDelta = INT32_MAX;
+            for (uint8_t j = 0; j < n; j++) {
+                int32_t delta = (int32_t)windowCostUs(planned[j].unionWith(aligned)) -
+                                (int32_t)(windowCostUs(planned[j]) + windowCostUs(aligned));
+                if (delta < bestDelta) {
+                    bestDelta = delta;
+                    best = j;
+                }
+            }
+            planned[best] = planned[best].unionWith(aligned);
+        }
+    }
+
+    while (n > 1) {
+        uint8_t bestA = 0, bestB = 0;
+        int32_t bestDelta = INT32_MAX;
+        for (uint8_t a = 0; a < n; a++) {
+            for (uint8_t b = a + 1; b < n; b++) {
+                int32_t delta = (int32_t)windowCostUs(planned[a].unionWith(planned[b])) -
+                                (int32_t)(windowCostUs(planned[a]) + windowCostUs(planned[b]));
+                if (delta < bestDelta) {
+                    bestDelta = delta;
+                    bestA = a;
+                    bestB = b;
+                }
+            }
+        }
+        if (bestDelta > 0) break;
+
+        planned[bestA] = planned[bestA].unionWith(planned[bestB]);
+        planned[bestB] = planned[--n];
+    }
+    return n;
+}
+
+bool WatcherDisplay::commit() {
+    if (!initialized || !screenBuffer) return false;
+
+    queueDirtyRects();
+
+    lastCommitBytes = 0;
+    if (!flush()) return false;
+
+    lastCommitBytes = lastRefreshBytes;
+    totalCommitBytes += lastCommitBytes;
+    commitCount++;
+    return true;
+}
+
+void WatcherDisplay::queueDirtyRects() {
+    syncUpright();
+
+    const PAINT_RECT* rects;
+    uint8_t count = Paint_GetDirtyRects(&rects);
+    for (uint8_t i = 0; i < count; i++) {
+        PAINT_RECT r = uprightActive ? uprightToScreen(rects[i]) : rects[i];
+        queueRegion(UIRegion(r.X1, r.Y1, r.X2 - r.X1 + 1, r.Y2 - r.Y1 + 1));
+    }
+    Paint_ClearDirty();
+}
+
+// ========== Update Coalescing ==========
+
+bool WatcherDisplay::markDirty(const UIRegion& region, uint16_t latencyMs) {
+    if (!queueRegion(region)) return false;
+    schedule(latencyMs);
+    return true;
+}
+
+void WatcherDisplay::markDirty(uint16_t latencyMs) {
+    if (!initialized || !screenBuffer) return;
+
+    queueDirtyRects();
+    schedule(latencyMs);
+}
+
+void WatcherDisplay::schedule(uint16_t latencyMs) {
+    // Keep the earliest deadline; later budgets are met by the same refresh
+    unsigned long deadline = millis() + latencyMs;
+    if (!updatesPending || (long)(deadline - updateDeadlineMs) < 0) {
+        updateDeadlineMs = deadline;
+    }
+    updatesPending = true;
+}
+
+bool WatcherDisplay::serviceUpdates() {
+    if (!updatesPending) return false;
+    if ((long)(millis() - updateDeadlineMs) < 0) return false;
+    if (poll()) return false;  // Due, but the panel is busy: as soon as it isn't
+
+    updatesPending = false;
+
+    // The diff covers every marked region, down to the changed bytes
+    if (shadowBuffer && shadowValid) {
+        queuedCount = 0;
+        return updateChanged();
+    }
+    return flush();
+}
+
+bool WatcherDisplay::beginPartialWindows(const UIRegion* regions, uint8_t count) {
+    waitForRefresh();
+
+    // The 4-gray LUT only has a full waveform
+    if (grayscale) {
+        return beginFullRefresh();
+    }
+
+    // Without a committed shadow RAM 0x26 would be loaded with garbage
+    if (differentialEnabled && !shadowValid) {
+        Serial.println("Shadow not in sync, promoting partial to full refresh");
+        return beginFullRefresh();
+    }
+    syncUpright();
+
+    // Let the policy fold this update into a full-screen waveform
+    if (refreshPolicy) {
+        RefreshUpdate update = { 0, 0, estimateCost(regions, count) / 1000 };
+        for (uint8_t i = 0; i < count; i++) {
+            update.area += (uint32_t)regions[i].width * regions[i].height;
+            update.flipped += countFlips(regions[i]);
+        }
+        RefreshWaveform waveform = refreshPolicy->decide(update);
+        if (waveform == WAVEFORM_FULL) return beginFullRefresh();
+        if (waveform == WAVEFORM_FAST_FULL) return beginFastFullRefresh();
+    }
+
+    chargeTiles(regions, count);
+
+    // Controller RAM keeps each window's data, so load them all and let a
+    // single waveform show every change. Rows stream straight out of the
+    // screen (and shadow) buffer, no per-window copy.
+    const UBYTE* oldBase = differentialEnabled ? shadowBuffer : nullptr;
+    unsigned long loadStartUs = micros();
+    EPD_4IN2_V2_PartialBegin();
+    UIRegion covered = regions[0];
+    lastRefreshBytes = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        const UIRegion& region = regions[i];
+        lastRefreshBytes += (uint32_t)(region.width / 8) * region.height * (differentialEnabled ? 2 : 1);
+        EPD_4IN2_V2_PartialLoadWindow_Strided(oldBase, screenBuffer, DISPLAY_WIDTH / 8,
+                                              region.x, region.y,
+                                              region.right(), region.bottom());
+        covered = covered.unionWith(region);
+    }
+    lastLoadUs = micros() - loadStartUs;
+    lastLoadWindows = count;
+
+    armRefresh();
+    EPD_4IN2_V2_SetAsync(1);
+    EPD_4IN2_V2_PartialUpdate();
+    EPD_4IN2_V2_SetAsync(0);
+
+    for (uint8_t i = 0; i < count; i++) {
+        stageShadow(regions[i]);
+    }
+
+    activeRegion = covered;
+    startRefresh(REFRESH_PARTIAL_RUNNING);
+    return true;
+}
+
+bool WatcherDisplay::poll() {
+    if (refreshState == REFRESH_IDLE) return false;
+
+    // The falling edge is latched by the interrupt; the level check covers
+    // edges that happened before the IRQ was armed
+    bool edge = DEV_Busy_TakeIRQ();
+    bool busy = EPD_4IN2_V2_IsBusy();
+    if (busy) busySeen = true;
+
+    // finishRefresh() may go straight on with the next half of a clean
+    if (edge || (busySeen && !busy)) {
+        finishRefresh(REFRESH_COMPLETED);
+        return refreshState != REFRESH_IDLE;
+    }
+
+    uint32_t timeout = (refreshState == REFRESH_FULL_RUNNING) ?
+                       fullRefreshTimeoutMs : partialRefreshTimeoutMs;
+    if (millis() - refreshStartMs > timeout) {
+        Serial.printf("Refresh timed out after %lu ms\n", millis() - refreshStartMs);
+        finishRefresh(REFRESH_TIMED_OUT);
+        return refreshState != REFRESH_IDLE;
+    }
+
+    return true;
+}
+
+bool WatcherDisplay::waitForRefresh() {
+    if (refreshState == REFRESH_IDLE) return true;
+
+    while (poll()) {
+        DEV_Delay_ms(1);
+    }
+    return lastRefreshResult == REFRESH_COMPLETED;
 }
 
 void WatcherDisplay::maintainDisplay() {
-    if (autoFullRefreshEnabled && partialRefreshCount >= fullRefreshInterval) {
+    if (deferredMaintenance) {
+        // Scheduler tick: note when a clean became due, start it once the
+        // app is idle or it has waited long enough
+        if (idleWindowOpen && (long)(idleUntilMs - millis()) <= 0) idleWindowOpen = false;
+        if (!initialized || poll()) return;
+        if (updatesPending) return;  // A clean now would blow their budget
+        if (!needsMaintenance()) {
+            maintenanceDue = false;
+            return;
+        }
+
+        unsigned long now = millis();
+        if (!maintenanceDue) {
+            maintenanceDue = true;
+            maintenanceDueMs = now;
+        }
+        bool overdue = now - maintenanceDueMs >= maintenanceMaxDeferMs;
+        if (!overdue && !isIdle()) return;
+        if (overdue) {
+            Serial.printf("Maintenance overdue (%lu ms), cleaning now\n", now - maintenanceDueMs);
+        }
+
+        maintenanceDue = false;
+        if (tileCleaning) {
+            cleanGhostedTiles();
+        } else {
+            beginFullRefresh();
+        }
+    } else if (tileCleaning) {
+        if (cleanGhostedTiles()) waitForRefresh();
+    } else if (!refreshPolicy && autoFullRefreshEnabled && fullRefreshInterval > 0 &&
+               partialRefreshCount >= fullRefreshInterval) {
         fullRefresh();
     }
 }
 
+void WatcherDisplay::setDeferredMaintenance(bool enabled, uint32_t maxDeferMs) {
+    deferredMaintenance = enabled;
+    maintenanceMaxDeferMs = maxDeferMs;
+    maintenanceDue = false;
+}
+
+void WatcherDisplay::declareIdleWindow(uint32_t durationMs) {
+    idleWindowOpen = true;
+    idleUntilMs = millis() + durationMs;
+}
+
+bool WatcherDisplay::isIdle() const {
+    return idleHeld || (idleWindowOpen && (long)(idleUntilMs - millis()) > 0);
+}
+
+bool WatcherDisplay::needsMaintenance() const {
+    if (tileCleaning) {
+        UIRegion windows[MAX_QUEUED_REGIONS];
+        return findGhostedTiles(windows) > 0;
+    }
+    return !refreshPolicy && autoFullRefreshEnabled && fullRefreshInterval > 0 &&
+           partialRefreshCount >= fullRefreshInterval;
+}
+
+// ========== Tile Cleaning ==========
+
+bool WatcherDisplay::setTileCleaning(bool enabled, uint16_t partialLimit, uint16_t flipLimit) {
+    if (enabled && grayscale) {
+        Serial.println("No tile cleaning in grayscale mode");
+        return false;
+    }
+
+    tileCleaning = enabled;
+    tilePartialLimit = partialLimit;
+    tileFlipLimit = flipLimit;
+    return true;
+}
+
+uint8_t WatcherDisplay::findGhostedTiles(UIRegion* windows) const {
+    UIRegion tiles[GHOST_TILES_X * GHOST_TILES_Y];
+    uint8_t n = 0;
+    for (uint8_t ty = 0; ty < GHOST_TILES_Y; ty++) {
+        for (uint8_t tx = 0; tx < GHOST_TILES_X; tx++) {
+            const GhostTile& tile = ghostTiles[ty][tx];
+            if ((tilePartialLimit && tile.partials >= tilePartialLimit) ||
+                (tileFlipLimit && tile.flips >= tileFlipLimit)) {
+                tiles[n++] = UIRegion(tx * GHOST_TILE_SIZE, ty * GHOST_TILE_SIZE,
+                                      GHOST_TILE_SIZE, GHOST_TILE_SIZE);
+            }
+        }
+    }
+
+    // Neighbouring tiles share a window (and edge tiles are clamped);
+    // merged windows also clean the tiles in between
+    return n ? planRegions(tiles, n, windows) : 0;
+}
+
+bool WatcherDisplay::cleanGhostedTiles() {
+    UIRegion windows[MAX_QUEUED_REGIONS];
+    uint8_t count = findGhostedTiles(windows);
+    if (count == 0) return false;
+    return beginCleanWindows(windows, count);
+}
+
+bool WatcherDisplay::beginCleanRegion(const UIRegion& region) {
+    if (!initialized || !screenBuffer) return false;
+
+    UIRegion aligned;
+    if (!alignRegion(region, aligned)) {
+        Serial.println("Invalid region coordinates");
+        return false;
+    }
+
+    return beginCleanWindows(&aligned, 1);
+}
+
+void WatcherDisplay::cleanRegion(const UIRegion& region) {
+    unsigned long startTime = millis();
+    if (!beginCleanRegion(region)) return;
+    waitForRefresh();
+
+    unsigned long elapsed = millis() - startTime;
+    Serial.printf("Clean [%d,%d,%d,%d] complete (%lu ms)\n",
+                  region.x, region.y, region.width, region.height, elapsed);
+}
+
+bool WatcherDisplay::beginCleanWindows(const UIRegion* regions, uint8_t count) {
+    if (!initialized || !screenBuffer || count == 0) return false;
+
+    waitForRefresh();
+    if (grayscale) {
+        Serial.println("No inverted flash in grayscale mode");
+        return false;
+    }
+
+    // Redraw what the panel shows: the shadow when it is in sync
+    cleanFromShadow = shadowBuffer && shadowValid;
+    memcpy(cleanWindows, regions, count * sizeof(UIRegion));
+    cleanCount = count;
+
+    UIRegion covered = regions[0];
+    for (uint8_t i = 1; i < count; i++) {
+        covered = covered.unionWith(regions[i]);
+    }
+    activeRegion = covered;
+
+    loadCleanWindows(true);
+    return true;
+}
+
+void WatcherDisplay::loadCleanWindows(bool inverted) {
+    const UBYTE* shown = cleanFromShadow ? shadowBuffer : screenBuffer;
+
+    EPD_4IN2_V2_PartialBegin();
+    lastRefreshBytes = 0;
+    for (uint8_t i = 0; i < cleanCount; i++) {
+        const UIRegion& window = cleanWindows[i];
+        lastRefreshBytes += 2UL * (window.width / 8) * window.height;
+        EPD_4IN2_V2_PartialLoadWindow_Inverted(shown, DISPLAY_WIDTH / 8, inverted ? 1 : 0,
+                                               window.x, window.y,
+                                               window.right(), window.bottom());
+    }
+
+    armRefresh();
+    EPD_4IN2_V2_SetAsync(1);
+    EPD_4IN2_V2_PartialUpdate();
+    EPD_4IN2_V2_SetAsync(0);
+
+    cleanInverted = inverted;
+    startRefresh(REFRESH_CLEAN_RUNNING);
+}
+
+void WatcherDisplay::chargeTiles(const UIRegion* regions, uint8_t count) {
+    // Windows are byte-aligned and tiles are whole bytes wide, so every
+    // overlap can be counted with countFlips()
+    for (uint8_t ty = 0; ty < GHOST_TILES_Y; ty++) {
+        for (uint8_t tx = 0; tx < GHOST_TILES_X; tx++) {
+            uint16_t tileX = tx * GHOST_TILE_SIZE;
+            uint16_t tileY = ty * GHOST_TILE_SIZE;
+            bool touched = false;
+            uint32_t flips = 0;
+            for (uint8_t i = 0; i < count; i++) {
+                const UIRegion& r = regions[i];
+                uint16_t x0 = r.x > tileX ? r.x : tileX;
+                uint16_t y0 = r.y > tileY ? r.y : tileY;
+                uint16_t x1 = r.right() < tileX + GHOST_TILE_SIZE ? r.right() : tileX + GHOST_TILE_SIZE;
+                uint16_t y1 = r.bottom() < tileY + GHOST_TILE_SIZE ? r.bottom() : tileY + GHOST_TILE_SIZE;
+                if (x0 >= x1 || y0 >= y1) continue;
+                touched = true;
+                flips += countFlips(UIRegion(x0, y0, x1 - x0, y1 - y0));
+            }
+            if (!touched) continue;
+
+            GhostTile& tile = ghostTiles[ty][tx];
+            if (tile.partials < UINT16_MAX) tile.partials++;
+            flips += tile.flips;
+            tile.flips = (flips > UINT16_MAX) ? UINT16_MAX : flips;
+        }
+    }
+}
+
+void WatcherDisplay::resetTiles(const UIRegion& region) {
+    // Only tiles the region covers entirely (up to the panel edge) are clean
+    for (uint8_t ty = 0; ty < GHOST_TILES_Y; ty++) {
+        for (uint8_t tx = 0; tx < GHOST_TILES_X; tx++) {
+            uint16_t tileX = tx * GHOST_TILE_SIZE;
+            uint16_t tileY = ty * GHOST_TILE_SIZE;
+            uint16_t tileRight = (tileX + GHOST_TILE_SIZE < DISPLAY_WIDTH) ?
+                                 tileX + GHOST_TILE_SIZE : DISPLAY_WIDTH;
+            uint16_t tileBottom = (tileY + GHOST_TILE_SIZE < DISPLAY_HEIGHT) ?
+                                  tileY + GHOST_TILE_SIZE : DISPLAY_HEIGHT;
+            if (region.x <= tileX && region.y <= tileY &&
+                region.right() >= tileRight && region.bottom() >= tileBottom) {
+                ghostTiles[ty][tx].partials = 0;
+                ghostTiles[ty][tx].flips = 0;
+            }
+        }
+    }
+}
+
+void WatcherDisplay::relieveTiles(uint8_t divisor) {
+    // A full waveform cleans every tile; the fast one leaves 1/divisor behind
+    for (uint8_t ty = 0; ty < GHOST_TILES_Y; ty++) {
+        for (uint8_t tx = 0; tx < GHOST_TILES_X; tx++) {
+            GhostTile& tile = ghostTiles[ty][tx];
+            tile.partials = (divisor > 1) ? tile.partials / divisor : 0;
+            tile.flips = (divisor > 1) ? tile.flips / divisor : 0;
+        }
+    }
+}
+
 void WatcherDisplay::resetRefreshCounter() {
     partialRefreshCount = 0;
 }
 
+bool WatcherDisplay::setDifferentialRefresh(bool enabled, uint8_t interval) {
+    waitForRefresh();
+
+    // The shadow outlives disabling: updateChanged() may still use it
+    if (enabled && !ensureShadow()) {
+        return false;
+    }
+
+    differentialEnabled = enabled;
+    fullRefreshInterval = enabled ? interval : DEFAULT_FULL_REFRESH_INTERVAL;
+    return true;
+}
+
+bool WatcherDisplay::ensureShadow() {
+    if (shadowBuffer) return true;
+    if (grayscale) {
+        Serial.println("No shadow buffer in grayscale mode");
+        return false;
+    }
+
+    shadowBuffer = (UBYTE*)malloc(BUFFER_SIZE);
+    if (!shadowBuffer) {
+        Serial.println("Failed to allocate shadow buffer!");
+        return false;
+    }
+    shadowValid = false;  // Synced by the next full refresh
+    return true;
+}
+
+// ========== Upright Rendering ==========
+
+// Transpose an 8x8 bit matrix: in[i] is row i (MSB = column 0), out[j] is
+// column j (MSB = row 0). Hacker's Delight, transpose8rS32.
+static inline void transpose8(const UBYTE in[8], UBYTE out[8]) {
+    uint32_t x = ((uint32_t)in[0] << 24) | ((uint32_t)in[1] << 16) | ((uint32_t)in[2] << 8) | in[3];
+    uint32_t y = ((uint32_t)in[4] << 24) | ((uint32_t)in[5] << 16) | ((uint32_t)in[6] << 8) | in[7];
+    uint32_t t;
+
+    t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+    t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+    y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+    x = t;
+
+    out[0] = x >> 24; out[1] = x >> 16; out[2] = x >> 8; out[3] = x;
+    out[4] = y >> 24; out[5] = y >> 16; out[6] = y >> 8; out[7] = y;
+}
+
+// Rotate the 1bpp pixels of src inside rect (src coordinates, inclusive)
+// by 90 degrees into dst. Clockwise maps (x, y) to (srcH - 1 - y, x),
+// counter-clockwise to (y, srcW - 1 - x). Each destination byte is eight
+// source rows of one source byte, so the work is one transpose per 8x8
+// block; pixels outside rect are left untouched in dst.
+static void rotateBlit(const UBYTE* src, uint16_t srcStride, uint16_t srcW, uint16_t srcH,
+                       UBYTE* dst, uint16_t dstStride, bool clockwise, const PAINT_RECT& rect) {
+    int32_t firstX = clockwise ? srcH - 1 - rect.Y2 : rect.Y1;
+    int32_t lastX = clockwise ? srcH - 1 - rect.Y1 : rect.Y2;
+
+    for (uint16_t j = firstX / 8; j <= lastX / 8; j++) {
+        // Source rows feeding bits 7..0 of destination byte j
+        const UBYTE* rows[8];
+        UBYTE mask = 0;
+        for (uint8_t p = 0; p < 8; p++) {
+            int32_t y = clockwise ? (int32_t)srcH - 1 - (8 * j + p) : 8 * j + p;
+            if (y >= rect.Y1 && y <= rect.Y2) {
+                rows[p] = src + (uint32_t)y * srcStride;
+                mask |= 0x80 >> p;
+            } else {
+                rows[p] = nullptr;
+            }
+        }
+
+        for (uint16_t bx = rect.X1 / 8; bx <= rect.X2 / 8; bx++) {
+            UBYTE in[8], out[8];
+            for (uint8_t p = 0; p < 8; p++) {
+                in[p] = rows[p] ? rows[p][bx] : 0;
+            }
+            transpose8(in, out);
+
+            for (uint8_t k = 0; k < 8; k++) {
+                uint16_t x = bx * 8 + k;
+                if (x < rect.X1 || x > rect.X2) continue;
+                uint16_t dy = clockwise ? x : srcW - 1 - x;
+                UBYTE* d = dst + (uint32_t)dy * dstStride + j;
+                *d = (*d & ~mask) | (out[k] & mask);
+            }
+        }
+    }
+}
+
+PAINT_RECT WatcherDisplay::uprightToScreen(const PAINT_RECT& r) const {
+    // 270: screen (y, H-1-x); 90: screen (W-1-y, x)
+    PAINT_RECT s;
+    if (rotation == ROTATE_270) {
+        s.X1 = r.Y1; s.X2 = r.Y2;
+        s.Y1 = DISPLAY_HEIGHT - 1 - r.X2; s.Y2 = DISPLAY_HEIGHT - 1 - r.X1;
+    } else {
+        s.X1 = DISPLAY_WIDTH - 1 - r.Y2; s.X2 = DISPLAY_WIDTH - 1 - r.Y1;
+        s.Y1 = r.X1; s.Y2 = r.X2;
+    }
+    return s;
+}
+
+PAINT_RECT WatcherDisplay::screenToUpright(const PAINT_RECT& s) const {
+    PAINT_RECT r;
+    if (rotation == ROTATE_270) {
+        r.X1 = DISPLAY_HEIGHT - 1 - s.Y2; r.X2 = DISPLAY_HEIGHT - 1 - s.Y1;
+        r.Y1 = s.X1; r.Y2 = s.X2;
+    } else {
+        r.X1 = s.Y1; r.X2 = s.Y2;
+        r.Y1 = DISPLAY_WIDTH - 1 - s.X2; r.Y2 = DISPLAY_WIDTH - 1 - s.X1;
+    }
+    return r;
+}
+
+bool WatcherDisplay::setUprightRendering(bool enabled) {
+    if (!initialized || !screenBuffer) return false;
+    if (enabled == (uprightBuffer != nullptr)) return true;
+
+    if (enabled && grayscale) {
+        Serial.println("Upright rendering needs a 1bpp screen buffer");
+        return false;
+    }
+    if (enabled && rotation != ROTATE_90 && rotation != ROTATE_270) {
+        Serial.println("Upright rendering needs rotation 90 or 270");
+        return false;
+    }
+
+    if (enabled) {
+        uprightBuffer = (UBYTE*)malloc(UPRIGHT_BUFFER_SIZE);
+        if (!uprightBuffer) {
+            Serial.println("Failed to allocate upright canvas!");
+            return false;
+        }
+        // The whole screen is new to the canvas; the first frame draws upright
+        uprightStale = { 0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1 };
+        uprightStaleValid = true;
+        Paint_ResetSpanStats();
+        switchCanvas(true);
+    } else {
+        syncUpright();
+        if (uprightActive) switchCanvas(false);
+        free(uprightBuffer);
+        uprightBuffer = nullptr;
+        uprightStaleValid = false;
+    }
+    return true;
+}
+
+void WatcherDisplay::switchCanvas(bool upright) {
+    // Dirty rects live in the coordinates of the image being drawn, so they
+    // are carried over to the new canvas, as is the (logical) clip region
+    PAINT_RECT pending[PAINT_MAX_DIRTY];
+    const PAINT_RECT* rects;
+    uint8_t count = Paint_GetDirtyRects(&rects);
+    memcpy(pending, rects, count * sizeof(PAINT_RECT));
+    bool clipped = Paint.clippingEnabled;
+    UWORD clipX1 = Paint.clipX1, clipY1 = Paint.clipY1;
+    UWORD clipX2 = Paint.clipX2, clipY2 = Paint.clipY2;
+
+    if (upright) {
+        // Catch the canvas up with what was drawn straight to the screen
+        if (uprightStaleValid) {
+            rotateBlit(screenBuffer, DISPLAY_WIDTH / 8, DISPLAY_WIDTH, DISPLAY_HEIGHT,
+                       uprightBuffer, UPRIGHT_WIDTH_BYTES, rotation == ROTATE_270, uprightStale);
+            uprightStaleValid = false;
+        }
+        Paint_NewImage(uprightBuffer, DISPLAY_HEIGHT, DISPLAY_WIDTH, ROTATE_0, UNCOLORED);
+    } else {
+        Paint_NewImage(screenBuffer, DISPLAY_WIDTH, DISPLAY_HEIGHT, rotation, UNCOLORED);
+    }
+    uprightActive = upright;
+
+    for (uint8_t i = 0; i < count; i++) {
+        PAINT_RECT r = upright ? screenToUpright(pending[i]) : uprightToScreen(pending[i]);
+        Paint_MarkDirty(r.X1, r.Y1, r.X2, r.Y2);
+    }
+    if (clipped) Paint_SetClipRegion(clipX1, clipY1, clipX2, clipY2);
+}
+
+void WatcherDisplay::selectCanvas() {
+    if (captureBuffer) {
+        // cacheShape() owns the Paint state until its callback returns
+        Paint_SelectImage(captureBuffer);
+        return;
+    }
+    Paint_SelectImage(uprightActive ? uprightBuffer : screenBuffer);
+}
+
+void WatcherDisplay::syncUpright() {
+    if (!uprightBuffer) return;
+
+    // Rects stay listed (commit() still needs them); rotating one twice is
+    // harmless since the canvas is the master copy
+    const PAINT_RECT* rects;
+    uint8_t count = Paint_GetDirtyRects(&rects);
+    PAINT_RECT all = uprightActive ? PAINT_RECT{ 0, 0, DISPLAY_HEIGHT - 1, DISPLAY_WIDTH - 1 }
+                                   : PAINT_RECT{ 0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1 };
+    if (!Paint.dirtyEnabled) {
+        rects = &all;
+        count = 1;
+    }
+
+    uint32_t blocks = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        const PAINT_RECT& r = rects[i];
+        blocks += (uint32_t)((r.X2 - r.X1) / 8 + 1) * ((r.Y2 - r.Y1) / 8 + 1);
+        if (uprightActive) {
+            rotateBlit(uprightBuffer, UPRIGHT_WIDTH_BYTES, DISPLAY_HEIGHT, DISPLAY_WIDTH,
+                       screenBuffer, DISPLAY_WIDTH / 8, rotation == ROTATE_90, r);
+        } else if (uprightStaleValid) {
+            // Drawn on the screen only: the canvas needs it before it is
+            // drawn on again
+            if (r.X1 < uprightStale.X1) uprightStale.X1 = r.X1;
+            if (r.Y1 < uprightStale.Y1) uprightStale.Y1 = r.Y1;
+            if (r.X2 > uprightStale.X2) uprightStale.X2 = r.X2;
+            if (r.Y2 > uprightStale.Y2) uprightStale.Y2 = r.Y2;
+        } else {
+            uprightStale = r;
+            uprightStaleValid = true;
+        }
+    }
+
+    // Pick the canvas for the next frame by what this one cost: the
+    // column walks it did on the screen (or would have done, drawn
+    // upright) against the rotation its dirty rects need. Nothing drawn
+    // since the last sync (or no dirty tracking) keeps the canvas as is.
+    if (!Paint.dirtyEnabled || count == 0) return;
+    UDOUBLE narrowRows, flatPixels;
+    Paint_GetSpanStats(&narrowRows, &flatPixels);
+    Paint_ResetSpanStats();
+    UDOUBLE walks = uprightActive ? flatPixels : narrowRows;
+    bool upright = walks > blocks * UPRIGHT_BLOCK_WALKS;
+    if (upright != uprightActive) switchCanvas(upright);
+}
+
+// ========== Framebuffer Diff ==========
+
+// First/last byte in [from, to) where a and b differ, compared a 32-bit word
+// at a time once the pointers are word aligned; returns -1 if equal
+static int16_t firstDiffByte(const UBYTE* a, const UBYTE* b, uint16_t from, uint16_t to) {
+    uint16_t i = from;
+    while (i < to && ((uintptr_t)(a + i) & 3)) {
+        if (a[i] != b[i]) return i;
+        i++;
+    }
+    while (i + 4 <= to && *(const uint32_t*)(a + i) == *(const uint32_t*)(b + i)) {
+        i += 4;
+    }
+    for (; i < to; i++) {
+        if (a[i] != b[i]) return i;
+    }
+    return -1;
+}
+
+static int16_t lastDiffByte(const UBYTE* a, const UBYTE* b, uint16_t from, uint16_t to) {
+    uint16_t i = to;
+    while (i > from && ((uintptr_t)(a + i) & 3)) {
+        if (a[i - 1] != b[i - 1]) return i - 1;
+        i--;
+    }
+    while (i >= from + 4 && *(const uint32_t*)(a + i - 4) == *(const uint32_t*)(b + i - 4)) {
+        i -= 4;
+    }
+    for (; i > from; i--) {
+        if (a[i - 1] != b[i - 1]) return i - 1;
+    }
+    return -1;
+}
+
+uint8_t WatcherDisplay::findChangedRegions(UIRegion* regions, uint8_t maxRegions) {
+    if (!screenBuffer || !shadowBuffer || maxRegions == 0) return 0;
+    syncUpright();
+
+    // Screen and shadow share their allocation alignment, so both pointers
+    // reach word alignment at the same offsets
+    const uint16_t bytesPerRow = DISPLAY_WIDTH / 8;
+
+    // Rects still growing downwards, in bytes (x0..x1 inclusive)
+    struct Band { uint16_t x0, x1, y0, y1; };
+    Band open[DIFF_MAX_SPANS];
+    uint8_t openCount = 0;
+    uint8_t count = 0;
+
+    for (uint16_t y = 0; y <= DISPLAY_HEIGHT; y++) {
+        Band spans[DIFF_MAX_SPANS];
+        uint8_t spanCount = 0;
+
+        if (y < DISPLAY_HEIGHT) {
+            const UBYTE* a = screenBuffer + (uint32_t)y * bytesPerRow;
+            const UBYTE* b = shadowBuffer + (uint32_t)y * bytesPerRow;
+
+            // Most rows are untouched
+            if (memcmp(a, b, bytesPerRow) != 0) {
+                // Split the row into spans separated by long unchanged runs
+                int16_t x = firstDiffByte(a, b, 0, bytesPerRow);
+                int16_t end = lastDiffByte(a, b, 0, bytesPerRow);
+                while (x >= 0) {
+                    int16_t x1 = x;
+                    int16_t next = x1 + 1 <= end ? firstDiffByte(a, b, x1 + 1, end + 1) : -1;
+                    while (next >= 0 && next - x1 <= DIFF_SPLIT_GAP_BYTES) {
+                        x1 = next;
+                        next = x1 + 1 <= end ? firstDiffByte(a, b, x1 + 1, end + 1) : -1;
+                    }
+                    if (spanCount < DIFF_MAX_SPANS) {
+                        spans[spanCount++] = Band{(uint16_t)x, (uint16_t)x1, y, y};
+                    } else {
+                        spans[spanCount - 1].x1 = x1;
+                    }
+                    x = next;
+                }
+            }
+        }
+
+        // Extend open bands with overlapping spans, close the rest
+        bool extended[DIFF_MAX_SPANS] = {false};
+        for (uint8_t s = 0; s < spanCount; s++) {
+            bool merged = false;
+            for (uint8_t o = 0; o < openCount; o++) {
+                if (spans[s].x0 <= open[o].x1 + 1 && open[o].x0 <= spans[s].x1 + 1) {
+                    if (spans[s].x0 < open[o].x0) open[o].x0 = spans[s].x0;
+                    if (spans[s].x1 > open[o].x1) open[o].x1 = spans[s].x1;
+                    open[o].y1 = y;
+                    extended[o] = true;
+                    merged = true;
+                    break;
+                }
+            }
+            if (!merged) {
+                if (openCount < DIFF_MAX_SPANS) {
+                    extended[openCount] = true;
+                    open[openCount++] = spans[s];
+                } else {
+                    // Out of bands: widen the last one
+                    Band& last = open[openCount - 1];
+                    if (spans[s].x0 < last.x0) last.x0 = spans[s].x0;
+                    if (spans[s].x1 > last.x1) last.x1 = spans[s].x1;
+                    last.y1 = y;
+                    extended[openCount - 1] = true;
+                }
+            }
+        }
+
+        for (uint8_t o = 0; o < openCount; ) {
+            if (extended[o]) {
+                o++;
+                continue;
+            }
+            UIRegion closed(open[o].x0 * 8, open[o].y0,
+                            (open[o].x1 - open[o].x0 + 1) * 8, open[o].y1 - open[o].y0 + 1);
+            if (count < maxRegions) {
+                regions[count++] = closed;
+            } else {
+                regions[maxRegions - 1] = regions[maxRegions - 1].unionWith(closed);
+            }
+            open[o] = open[--openCount];
+            extended[o] = extended[openCount];
+        }
+    }
+    return count;
+}
+
+bool WatcherDisplay::updateChanged() {
+    if (!initialized || !screenBuffer) return false;
+    if (poll()) return false;  // Try again once the panel is idle
+    if (!ensureShadow()) return false;
+
+    // Without a committed shadow the panel contents are unknown
+    if (!shadowValid) {
+        Serial.println("Shadow not in sync, full refresh");
+        return beginFullRefresh();
+    }
+
+    UIRegion changed[DIFF_MAX_REGIONS];
+    uint8_t count = findChangedRegions(changed, DIFF_MAX_REGIONS);
+    Paint_ClearDirty();
+    if (count == 0) return false;
+
+    for (uint8_t i = 0; i < count; i++) {
+        queueRegion(changed[i]);
+    }
+    return flush();
+}
+
 // ========== Drawing Methods ==========
 
 void WatcherDisplay::setPixel(uint16_t x, uint16_t y, uint16_t color) {
     if (!initialized || !screenBuffer) return;
-    Paint_SelectImage(screenBuffer);
+    selectCanvas();
     Paint_SetPixel(x, y, color);
 }
 
 void WatcherDisplay::drawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color) {
     if (!initialized || !screenBuffer) return;
-    Paint_SelectImage(screenBuffer);
+    selectCanvas();
     Paint_DrawLine(x1, y1, x2, y2, color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
 }
 
 void WatcherDisplay::drawRect(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
                               uint16_t color, bool filled) {
     if (!initialized || !screenBuffer) return;
-    Paint_SelectImage(screenBuffer);
+    selectCanvas();
 
     if (filled) {
         Paint_DrawRectangle(x, y, x + width, y + height, color, DOT_PIXEL_1X1, DRAW_FILL_FULL);
@@ -187,7 +1186,7 @@ void WatcherDisplay::drawRect(uint16_t x, uint16_t y, uint16_t width, uint16_t h
 
 void WatcherDisplay::drawCircle(uint16_t x, uint16_t y, uint16_t radius, uint16_t color, bool filled) {
     if (!initialized || !screenBuffer) return;
-    Paint_SelectImage(screenBuffer);
+    selectCanvas();
 
     if (filled) {
         Paint_DrawCircle(x, y, radius, color, DOT_PIXEL_1X1, DRAW_FILL_FULL);
@@ -198,7 +1197,7 @@ void WatcherDisplay::drawCircle(uint16_t x, uint16_t y, uint16_t radius, uint16_
 
 uint16_t WatcherDisplay::drawText(uint16_t x, uint16_t y, const char* text, sFONT* font, bool colored) {
     if (!initialized || !screenBuffer) return 0;
-    Paint_SelectImage(screenBuffer);
+    selectCanvas();
 
     uint16_t color = colored ? COLORED : UNCOLORED;
     Paint_DrawString_EN(x, y, text, font, UNCOLORED, color);
@@ -221,8 +1220,8 @@ void WatcherDisplay::clearRegion(uint16_t x, uint16_t y, uint16_t width, uint16_
 
 void WatcherDisplay::fillRegion(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color) {
     if (!initialized || !screenBuffer) return;
-    Paint_SelectImage(screenBuffer);
-    Paint_DrawRectangle(x, y, x + width, y + height, color, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+    selectCanvas();
+    Paint_FillRect(x, y, width, height, color);
 }
 
 // ========== Advanced Drawing Methods ==========
@@ -233,7 +1232,7 @@ void WatcherDisplay::draw7SegmentDigit(uint16_t x, uint16_t y, uint8_t digit,
     if (!initialized || !screenBuffer) return;
     if (digit > 9) return;
 
-    Paint_SelectImage(screenBuffer);
+    selectCanvas();
 
     // 7-segment layout:
     //     A
@@ -301,7 +1300,7 @@ void WatcherDisplay::drawProgressBar(uint16_t x, uint16_t y, uint16_t width, uin
     if (!initialized || !screenBuffer) return;
     if (progress > 100) progress = 100;
 
-    Paint_SelectImage(screenBuffer);
+    selectCanvas();
 
     // Draw outer border
     Paint_DrawRectangle(x, y, x + width, y + height, COLORED, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
@@ -332,10 +1331,80 @@ void WatcherDisplay::drawProgressBar(uint16_t x, uint16_t y, uint16_t width, uin
 void WatcherDisplay::drawBitmap(uint16_t x, uint16_t y, const unsigned char* bitmap,
                                 uint16_t width, uint16_t height) {
     if (!initialized || !screenBuffer) return;
-    Paint_SelectImage(screenBuffer);
+    selectCanvas();
     Paint_DrawImage(bitmap, x, y, width, height);
 }
 
+// ========== Shape Cache ==========
+
+struct ShapeCapture {
+    ShapeDrawCallback draw;
+    void* context;
+};
+
+static void captureShape(void* context) {
+    ShapeCapture* capture = (ShapeCapture*)context;
+    capture->draw(capture->context);
+}
+
+int8_t WatcherDisplay::cacheShape(uint16_t width, uint16_t height,
+                                  ShapeDrawCallback draw, void* context) {
+    if (!draw || width == 0 || height == 0) return -1;
+
+    int8_t shape = -1;
+    for (uint8_t i = 0; i < MAX_CACHED_SHAPES; i++) {
+        if (!cachedShapes[i].bits) {
+            shape = i;
+            break;
+        }
+    }
+    if (shape < 0) {
+        Serial.println("Shape cache full!");
+        return -1;
+    }
+
+    uint32_t spriteSize = (uint32_t)((width + 7) / 8) * height;
+    UBYTE* bits = regionPool.isReady() ? regionPool.allocate(spriteSize)
+                                       : (UBYTE*)malloc(spriteSize);
+    if (!bits) {
+        Serial.println("Failed to allocate shape sprite!");
+        return -1;
+    }
+
+    // Sprites are captured upright; drawCached() rotates them like glyphs
+    ShapeCapture capture = { draw, context };
+    captureBuffer = bits;
+    Paint_CaptureSprite(bits, width, height, captureShape, &capture);
+    captureBuffer = nullptr;
+
+    cachedShapes[shape].bits = bits;
+    cachedShapes[shape].width = width;
+    cachedShapes[shape].height = height;
+    Serial.printf("Shape %d cached: %dx%d (%d bytes)\n", shape, width, height, spriteSize);
+    return shape;
+}
+
+bool WatcherDisplay::drawCached(int8_t shape, uint16_t x, uint16_t y, uint16_t color) {
+    if (shape < 0 || shape >= MAX_CACHED_SHAPES || !cachedShapes[shape].bits) return false;
+
+    const CachedShape& cached = cachedShapes[shape];
+    return blitBits(x, y, cached.bits, cached.width, cached.height, color);
+}
+
+bool WatcherDisplay::blitBits(uint16_t x, uint16_t y, const UBYTE* bits,
+                              uint16_t width, uint16_t height, uint16_t color) {
+    if (!initialized || !screenBuffer) return false;
+    selectCanvas();
+    Paint_BlitGlyph(x, y, bits, width, height, color, FONT_BACKGROUND);
+    return true;
+}
+
+void WatcherDisplay::releaseCached(int8_t shape) {
+    if (shape < 0 || shape >= MAX_CACHED_SHAPES || !cachedShapes[shape].bits) return;
+    releaseSubBuffer(cachedShapes[shape].bits);
+    cachedShapes[shape].bits = nullptr;
+}
+
 // ========== Buffer Management ==========
 
 UBYTE* WatcherDisplay::createSubBuffer(uint16_t width, uint16_t height) {
@@ -345,7 +1414,8 @@ UBYTE* WatcherDisplay::createSubBuffer(uint16_t width, uint16_t height) {
     }
 
     uint32_t bufferSize = (width / 8) * height;
-    UBYTE* buffer = (UBYTE*)malloc(bufferSize);
+    UBYTE* buffer = regionPool.isReady() ? regionPool.allocate(bufferSize)
+                                         : (UBYTE*)malloc(bufferSize);
 
     if (buffer) {
         memset(buffer, 0xFF, bufferSize); // Initialize to white
@@ -357,12 +1427,28 @@ UBYTE* WatcherDisplay::createSubBuffer(uint16_t width, uint16_t height) {
     return buffer;
 }
 
+void WatcherDisplay::releaseSubBuffer(UBYTE* buffer) {
+    if (!buffer) return;
+    if (!regionPool.release(buffer)) {
+        free(buffer);
+    }
+}
+
 void WatcherDisplay::copySubBuffer(const UBYTE* subBuffer,
                                   uint16_t srcX, uint16_t srcY,
                                   uint16_t width, uint16_t height,
                                   uint16_t destX, uint16_t destY) {
     if (!initialized || !screenBuffer || !subBuffer) return;
 
+    if (width == 0 || height == 0) return;
+    if (grayscale) {
+        Serial.println("copySubBuffer needs a 1bpp screen buffer");
+        return;
+    }
+
+    // Pending canvas drawing must reach the screen before it is overwritten
+    syncUpright();
+
     // Calculate buffer parameters
     uint16_t subBufferBytesPerRow = width / 8;
     uint16_t screenBytesPerRow = DISPLAY_WIDTH / 8;
@@ -381,41 +1467,142 @@ void WatcherDisplay::copySubBuffer(const UBYTE* subBuffer,
         // Copy bytes
         memcpy(&screenBuffer[destOffset], &subBuffer[srcOffset], width / 8);
     }
+
+    // memcpy bypasses Paint, so record the area for commit() here; with an
+    // upright canvas the copy is rotated back into it to keep it the master
+    PAINT_RECT area = { destX, destY, (UWORD)(destX + width - 1), (UWORD)(destY + height - 1) };
+    if (area.X2 >= DISPLAY_WIDTH) area.X2 = DISPLAY_WIDTH - 1;
+    if (area.Y2 >= DISPLAY_HEIGHT) area.Y2 = DISPLAY_HEIGHT - 1;
+    if (uprightActive) {
+        rotateBlit(screenBuffer, DISPLAY_WIDTH / 8, DISPLAY_WIDTH, DISPLAY_HEIGHT,
+                   uprightBuffer, UPRIGHT_WIDTH_BYTES, rotation == ROTATE_270, area);
+        area = screenToUpright(area);
+    }
+    Paint_MarkDirty(area.X1, area.Y1, area.X2, area.Y2);
 }
 
 // ========== Private Helper Methods ==========
 
-void WatcherDisplay::extractRegionBuffer(const UIRegion& region, UBYTE* destBuffer) {
-    if (!screenBuffer || !destBuffer) return;
+bool WatcherDisplay::alignRegion(const UIRegion& region, UIRegion& aligned) const {
+    // Get byte-aligned region
+    aligned = region.getByteAligned();
 
-    uint16_t screenBytesPerRow = DISPLAY_WIDTH / 8;
-    uint16_t regionBytesPerRow = region.width / 8;
+    // Validate coordinates
+    if (aligned.x >= DISPLAY_WIDTH || aligned.y >= DISPLAY_HEIGHT ||
+        aligned.width == 0 || aligned.height == 0) {
+        return false;
+    }
 
-    // Extract region row by row
-    for (uint16_t row = 0; row < region.height; row++) {
-        uint16_t screenY = region.y + row;
-        if (screenY >= DISPLAY_HEIGHT) break;
+    // Clamp to display bounds
+    if (aligned.right() > DISPLAY_WIDTH) {
+        aligned.width = DISPLAY_WIDTH - aligned.x;
+    }
+    if (aligned.bottom() > DISPLAY_HEIGHT) {
+        aligned.height = DISPLAY_HEIGHT - aligned.y;
+    }
+    return true;
+}
 
-        // Calculate offsets
-        uint32_t srcOffset = (screenY * screenBytesPerRow) + (region.x / 8);
-        uint32_t destOffset = row * regionBytesPerRow;
+void WatcherDisplay::armRefresh() {
+    // Drop edges left over from earlier blocking BUSY waits
+    DEV_Busy_TakeIRQ();
+}
 
-        // Copy row
-        memcpy(&destBuffer[destOffset], &screenBuffer[srcOffset], regionBytesPerRow);
+void WatcherDisplay::startRefresh(RefreshState kind) {
+    refreshState = kind;
+    refreshStartMs = millis();
+    busySeen = EPD_4IN2_V2_IsBusy();
+}
+
+void WatcherDisplay::finishRefresh(RefreshResult result) {
+    RefreshState kind = refreshState;
+    refreshState = REFRESH_IDLE;
+    lastRefreshResult = result;
+
+    // Commit the staged shadow; a timeout leaves the panel state unknown and
+    // the next partial is promoted to a full refresh. A clean redraws the
+    // shadow, so it is only in sync if it was before.
+    if (kind == REFRESH_CLEAN_RUNNING) {
+        shadowValid = cleanFromShadow && result == REFRESH_COMPLETED;
+    } else {
+        shadowValid = shadowBuffer && result == REFRESH_COMPLETED;
+    }
+
+    if (kind == REFRESH_FULL_RUNNING) {
+        partialRefreshCount = 0;
+        if (refreshPolicy && result == REFRESH_COMPLETED) {
+            refreshPolicy->noteWaveformTime(fastFullRunning ? WAVEFORM_FAST_FULL : WAVEFORM_FULL,
+                                            millis() - refreshStartMs);
+        }
+    } else if (kind == REFRESH_PARTIAL_RUNNING) {
+        if (partialRefreshCount < UINT8_MAX) partialRefreshCount++;
+        if (costCalibration && result == REFRESH_COMPLETED) {
+            calibrateCostModel(millis() - refreshStartMs);
+        }
+    } else if (kind == REFRESH_CLEAN_RUNNING && result == REFRESH_COMPLETED) {
+        if (cleanInverted) {
+            // First half done: drive the windows back, the callback waits
+            // for the whole clean
+            loadCleanWindows(false);
+            return;
+        }
+
+        // Leave 0x24 and 0x26 both holding the image, as after a partial
+        const UBYTE* shown = cleanFromShadow ? shadowBuffer : screenBuffer;
+        for (uint8_t i = 0; i < cleanCount; i++) {
+            const UIRegion& window = cleanWindows[i];
+            EPD_4IN2_V2_PartialLoadWindow_Strided(shown, shown, DISPLAY_WIDTH / 8,
+                                                  window.x, window.y,
+                                                  window.right(), window.bottom());
+            resetTiles(window);
+        }
+    }
+
+    if (refreshCallback) {
+        refreshCallback(result, kind, refreshCallbackContext);
     }
 }
 
-void WatcherDisplay::partialRefreshRaw(const UIRegion& region, const UBYTE* regionBuffer) {
-    if (!regionBuffer) return;
+void WatcherDisplay::calibrateCostModel(unsigned long waveformMs) {
+    // Exponential moving average (1/4 weight) of the measured waveform time
+    // and of the SPI time per byte left after the per-window overhead
+    int32_t fixedSample = (int32_t)(waveformMs * 1000);
+    costModel.fixedUs += (fixedSample - (int32_t)costModel.fixedUs) / 4;
+
+    uint32_t passes = differentialEnabled ? 2 : 1;
+    uint32_t overheadUs = passes * lastLoadWindows * costModel.perWindowUs;
+    if (lastRefreshBytes > 0 && lastLoadUs > overheadUs) {
+        int32_t byteSample = (int32_t)((uint64_t)(lastLoadUs - overheadUs) * 1000 / lastRefreshBytes);
+        costModel.perByteNs += (byteSample - (int32_t)costModel.perByteNs) / 4;
+    }
+}
+
+uint32_t WatcherDisplay::countFlips(const UIRegion& region) const {
+    // Without the last frame every pixel of the window may flip
+    if (!shadowBuffer || !shadowValid) return (uint32_t)region.width * region.height;
+
+    uint16_t screenBytesPerRow = DISPLAY_WIDTH / 8;
+    uint32_t flips = 0;
+    for (uint16_t row = 0; row < region.height; row++) {
+        uint32_t offset = (uint32_t)(region.y + row) * screenBytesPerRow + region.x / 8;
+        for (uint16_t i = 0; i < region.width / 8; i++) {
+            flips += __builtin_popcount(screenBuffer[offset + i] ^ shadowBuffer[offset + i]);
+        }
+    }
+    return flips;
+}
+
+void WatcherDisplay::stageShadow(const UIRegion& region) {
+    if (!shadowBuffer) return;
 
-    // Call Waveshare partial display function
-    EPD_4IN2_V2_PartialDisplay(
-        (UBYTE*)regionBuffer,
-        region.x,
-        region.y,
-        region.right(),
-        region.bottom()
-    );
+    // The controller latched this data when it was sent; it only becomes
+    // the committed panel state once the waveform completes (finishRefresh)
+    shadowValid = false;
+    uint16_t screenBytesPerRow = DISPLAY_WIDTH / 8;
+    for (uint16_t row = 0; row < region.height; row++) {
+        uint32_t offset = (uint32_t)(region.y + row) * screenBytesPerRow + region.x / 8;
+        memcpy(&shadowBuffer[offset], &screenBuffer[offset], region.width / 8);
+    }
 }
 
 // ========== Custom Font Methods ==========
@@ -451,32 +1638,15 @@ void WatcherDisplay::drawTriangle(uint16_t x0, uint16_t y0,
                                  uint16_t x2, uint16_t y2,
                                  uint16_t color, bool filled) {
     if (!initialized || !screenBuffer) return;
-    Paint_SelectImage(screenBuffer);
+    selectCanvas();
 
     if (filled) {
-        // Fill triangle using scan-line algorithm
-        // Sort vertices by y-coordinate (bubble sort for 3 elements)
-        if (y0 > y1) { uint16_t tmp = y0; y0 = y1; y1 = tmp; tmp = x0; x0 = x1; x1 = tmp; }
-        if (y1 > y2) { uint16_t tmp = y1; y1 = y2; y2 = tmp; tmp = x1; x1 = x2; x2 = tmp; }
-        if (y0 > y1) { uint16_t tmp = y0; y0 = y1; y1 = tmp; tmp = x0; x0 = x1; x1 = tmp; }
-
-        // Draw filled triangle
-        for (uint16_t y = y0; y <= y2; y++) {
-            // Calculate x bounds for this scanline
-            int16_t xa = x0 + (y - y0) * (int32_t)(x2 - x0) / (y2 - y0 + 1);
-            int16_t xb;
-
-            if (y < y1) {
-                xb = x0 + (y - y0) * (int32_t)(x1 - x0) / (y1 - y0 + 1);
-            } else {
-                xb = x1 + (y - y1) * (int32_t)(x2 - x1) / (y2 - y1 + 1);
-            }
-
-            if (xa > xb) { int16_t tmp = xa; xa = xb; xb = tmp; }
-
-            // Draw horizontal line
-            Paint_DrawLine(xa, y, xb, y, color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
-        }
+        // Same scanline fill as drawPolygon(), so a triangle inside a
+        // polygon covers the same pixels
+        const int16_t xs[3] = { (int16_t)x0, (int16_t)x1, (int16_t)x2 };
+        const int16_t ys[3] = { (int16_t)y0, (int16_t)y1, (int16_t)y2 };
+        PAINT_EDGE edges[3];
+        Paint_FillPolygon(xs, ys, 3, color, FILL_RULE_EVEN_ODD, edges, 3);
     } else {
         // Draw triangle outline
         Paint_DrawLine(x0, y0, x1, y1, color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
@@ -486,20 +1656,52 @@ void WatcherDisplay::drawTriangle(uint16_t x0, uint16_t y0,
 }
 
 void WatcherDisplay::drawPolygon(const uint16_t* points, uint8_t numPoints,
-                                uint16_t color, bool filled) {
+                                uint16_t color, bool filled, FILL_RULE rule) {
     if (!initialized || !screenBuffer || !points || numPoints < 3) return;
-    Paint_SelectImage(screenBuffer);
+    selectCanvas();
 
     if (filled) {
-        // Simple fill using triangulation from first vertex
-        for (uint8_t i = 1; i < numPoints - 1; i++) {
-            drawTriangle(
-                points[0], points[1],
-                points[i*2], points[i*2+1],
-                points[(i+1)*2], points[(i+1)*2+1],
-                color, true
-            );
+        // One scanline pass over the whole outline: concave shapes fill
+        // correctly and shared edges are drawn once
+        int16_t xsStack[PAINT_POLYGON_STACK_EDGES], ysStack[PAINT_POLYGON_STACK_EDGES];
+        PAINT_EDGE edgesStack[PAINT_POLYGON_STACK_EDGES];
+        int16_t* xs = xsStack;
+        int16_t* ys = ysStack;
+        PAINT_EDGE* edges = edgesStack;
+        void* borrowed = nullptr;
+        if (numPoints > PAINT_POLYGON_STACK_EDGES) {
+            // Borrow a pool slot rather than touch the heap on every large
+            // polygon; without one, grow a scratch buffer and keep it
+            const uint32_t bytes = numPoints * (2 * sizeof(int16_t) + sizeof(PAINT_EDGE));
+            UBYTE* scratch = polygonScratch;
+            if (numPoints > polygonScratchPoints) {
+                if (regionPool.isReady() && regionPool.getSlotSize() >= bytes) {
+                    borrowed = regionPool.allocate(bytes);
+                }
+                if (borrowed) {
+                    scratch = (UBYTE*)borrowed;
+                } else {
+                    free(polygonScratch);
+                    polygonScratch = (UBYTE*)malloc(bytes);
+                    polygonScratchPoints = polygonScratch ? numPoints : 0;
+                    if (!polygonScratch) {
+                        Serial.println("Failed to allocate polygon edges!");
+                        return;
+                    }
+                    scratch = polygonScratch;
+                }
+            }
+            edges = (PAINT_EDGE*)scratch;
+            xs = (int16_t*)(edges + numPoints);
+            ys = xs + numPoints;
         }
+
+        for (uint8_t i = 0; i < numPoints; i++) {
+            xs[i] = points[i * 2];
+            ys[i] = points[i * 2 + 1];
+        }
+        Paint_FillPolygon(xs, ys, numPoints, color, rule, edges, numPoints);
+        if (borrowed) regionPool.release(borrowed);
     } else {
         // Draw polygon outline
         for (uint8_t i = 0; i < numPoints; i++) {
@@ -516,167 +1718,43 @@ void WatcherDisplay::drawPolygon(const uint16_t* points, uint8_t numPoints,
 void WatcherDisplay::drawArc(uint16_t x, uint16_t y, uint16_t radius,
                             int16_t startAngle, int16_t endAngle, uint16_t color) {
     if (!initialized || !screenBuffer || radius == 0) return;
-    Paint_SelectImage(screenBuffer);
-
-    // Normalize angles to 0-360
-    while (startAngle < 0) startAngle += 360;
-    while (endAngle < 0) endAngle += 360;
-    startAngle %= 360;
-    endAngle %= 360;
-
-    // Handle wrap-around
-    if (endAngle < startAngle) endAngle += 360;
-
-    // Draw arc using Bresenham-like algorithm
-    int16_t prevX = -1, prevY = -1;
-    for (int16_t angle = startAngle; angle <= endAngle; angle++) {
-        float rad = angle * PI / 180.0;
-        int16_t px = x + radius * cos(rad);
-        int16_t py = y - radius * sin(rad);  // Negative because Y increases downward
-
-        if (prevX != -1) {
-            Paint_DrawLine(prevX, prevY, px, py, color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
-        }
-
-        prevX = px;
-        prevY = py;
-    }
+    selectCanvas();
+    Paint_DrawArc(x, y, radius, startAngle, endAngle, color);
 }
 
 void WatcherDisplay::drawEllipse(uint16_t x, uint16_t y,
                                 uint16_t radiusX, uint16_t radiusY,
                                 uint16_t color, bool filled) {
     if (!initialized || !screenBuffer) return;
-    Paint_SelectImage(screenBuffer);
-
-    // Midpoint ellipse algorithm
-    int32_t rx = radiusX;
-    int32_t ry = radiusY;
-    int32_t x1 = 0;
-    int32_t y1 = ry;
-
-    // Region 1
-    int32_t rx2 = rx * rx;
-    int32_t ry2 = ry * ry;
-    int32_t p = ry2 - (rx2 * ry) + (rx2 / 4);
-
-    while ((ry2 * x1) < (rx2 * y1)) {
-        if (filled) {
-            Paint_DrawLine(x - x1, y + y1, x + x1, y + y1, color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
-            Paint_DrawLine(x - x1, y - y1, x + x1, y - y1, color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
-        } else {
-            Paint_SetPixel(x + x1, y + y1, color);
-            Paint_SetPixel(x - x1, y + y1, color);
-            Paint_SetPixel(x + x1, y - y1, color);
-            Paint_SetPixel(x - x1, y - y1, color);
-        }
-
-        x1++;
-        if (p < 0) {
-            p = p + (ry2 * 2 * x1) + ry2;
-        } else {
-            y1--;
-            p = p + (ry2 * 2 * x1) - (rx2 * 2 * y1) + ry2;
-        }
-    }
+    selectCanvas();
 
-    // Region 2
-    p = (ry2 * (x1 * x1 + x1)) + (rx2 * (y1 - 1) * (y1 - 1)) - (rx2 * ry2);
-
-    while (y1 >= 0) {
-        if (filled) {
-            Paint_DrawLine(x - x1, y + y1, x + x1, y + y1, color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
-            Paint_DrawLine(x - x1, y - y1, x + x1, y - y1, color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
-        } else {
-            Paint_SetPixel(x + x1, y + y1, color);
-            Paint_SetPixel(x - x1, y + y1, color);
-            Paint_SetPixel(x + x1, y - y1, color);
-            Paint_SetPixel(x - x1, y - y1, color);
-        }
-
-        y1--;
-        if (p > 0) {
-            p = p - (rx2 * 2 * y1) + rx2;
-        } else {
-            x1++;
-            p = p + (ry2 * 2 * x1) - (rx2 * 2 * y1) + rx2;
-        }
-    }
+    Paint_DrawEllipse(x, y, radiusX, radiusY, color, filled ? DRAW_FILL_FULL : DRAW_FILL_EMPTY);
 }
 
 void WatcherDisplay::drawRoundRect(uint16_t x, uint16_t y,
                                   uint16_t width, uint16_t height,
                                   uint16_t radius, uint16_t color, bool filled) {
     if (!initialized || !screenBuffer) return;
-    Paint_SelectImage(screenBuffer);
-
-    // Clamp radius to half of smallest dimension
-    if (radius > width / 2) radius = width / 2;
-    if (radius > height / 2) radius = height / 2;
-
-    if (filled) {
-        // Fill center rectangle
-        Paint_DrawRectangle(x + radius, y, x + width - radius, y + height,
-                          color, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-        Paint_DrawRectangle(x, y + radius, x + radius, y + height - radius,
-                          color, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-        Paint_DrawRectangle(x + width - radius, y + radius, x + width, y + height - radius,
-                          color, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+    selectCanvas();
 
-        // Fill corners with circles
-        drawCircle(x + radius, y + radius, radius, color, true);
-        drawCircle(x + width - radius - 1, y + radius, radius, color, true);
-        drawCircle(x + radius, y + height - radius - 1, radius, color, true);
-        drawCircle(x + width - radius - 1, y + height - radius - 1, radius, color, true);
-    } else {
-        // Draw straight edges
-        Paint_DrawLine(x + radius, y, x + width - radius, y,
-                      color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
-        Paint_DrawLine(x + radius, y + height - 1, x + width - radius, y + height - 1,
-                      color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
-        Paint_DrawLine(x, y + radius, x, y + height - radius,
-                      color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
-        Paint_DrawLine(x + width - 1, y + radius, x + width - 1, y + height - radius,
-                      color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+    if (width == 0 || height == 0) return;
 
-        // Draw corner arcs
-        drawArc(x + radius, y + radius, radius, 180, 270, color);
-        drawArc(x + width - radius - 1, y + radius, radius, 270, 360, color);
-        drawArc(x + radius, y + height - radius - 1, radius, 90, 180, color);
-        drawArc(x + width - radius - 1, y + height - radius - 1, radius, 0, 90, color);
-    }
+    // Radius is clamped to half the shorter side
+    Paint_DrawRoundRect(x, y, x + width - 1, y + height - 1, radius, color,
+                        filled ? DRAW_FILL_FULL : DRAW_FILL_EMPTY);
 }
 
 void WatcherDisplay::drawThickLine(uint16_t x0, uint16_t y0,
                                   uint16_t x1, uint16_t y1,
-                                  uint16_t thickness, uint16_t color) {
+                                  uint16_t thickness, uint16_t color, LINE_CAP cap) {
     if (!initialized || !screenBuffer || thickness == 0) return;
-    Paint_SelectImage(screenBuffer);
+    selectCanvas();
 
     if (thickness == 1) {
         Paint_DrawLine(x0, y0, x1, y1, color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
         return;
     }
-
-    // Calculate perpendicular offset
-    int16_t dx = x1 - x0;
-    int16_t dy = y1 - y0;
-    float len = sqrt(dx * dx + dy * dy);
-
-    if (len == 0) return;
-
-    float offsetX = -dy * thickness / (2.0 * len);
-    float offsetY = dx * thickness / (2.0 * len);
-
-    // Draw filled polygon for thick line
-    uint16_t points[8] = {
-        (uint16_t)(x0 + offsetX), (uint16_t)(y0 + offsetY),
-        (uint16_t)(x0 - offsetX), (uint16_t)(y0 - offsetY),
-        (uint16_t)(x1 - offsetX), (uint16_t)(y1 - offsetY),
-        (uint16_t)(x1 + offsetX), (uint16_t)(y1 + offsetY)
-    };
-
-    drawPolygon(points, 4, color, true);
+    Paint_DrawThickLine(x0, y0, x1, y1, thickness, color, cap);
 }
 
 void WatcherDisplay::drawBezier(uint16_t x0, uint16_t y0,
@@ -684,46 +1762,46 @@ void WatcherDisplay::drawBezier(uint16_t x0, uint16_t y0,
                                uint16_t x2, uint16_t y2,
                                uint16_t color) {
     if (!initialized || !screenBuffer) return;
-    Paint_SelectImage(screenBuffer);
-
-    // Quadratic Bezier curve using parametric equation
-    uint16_t prevX = x0, prevY = y0;
+    selectCanvas();
 
-    for (float t = 0.0; t <= 1.0; t += 0.02) {
-        float t2 = t * t;
-        float mt = 1.0 - t;
-        float mt2 = mt * mt;
-
-        uint16_t x = mt2 * x0 + 2 * mt * t * x1 + t2 * x2;
-        uint16_t y = mt2 * y0 + 2 * mt * t * y1 + t2 * y2;
+    const int16_t xs[3] = { (int16_t)x0, (int16_t)x1, (int16_t)x2 };
+    const int16_t ys[3] = { (int16_t)y0, (int16_t)y1, (int16_t)y2 };
+    Paint_DrawBezier(xs, ys, 3, color);
+}
 
-        Paint_DrawLine(prevX, prevY, x, y, color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+void WatcherDisplay::drawBezier(uint16_t x0, uint16_t y0,
+                               uint16_t x1, uint16_t y1,
+                               uint16_t x2, uint16_t y2,
+                               uint16_t x3, uint16_t y3,
+                               uint16_t color) {
+    if (!initialized || !screenBuffer) return;
+    selectCanvas();
 
-        prevX = x;
-        prevY = y;
-    }
+    const int16_t xs[4] = { (int16_t)x0, (int16_t)x1, (int16_t)x2, (int16_t)x3 };
+    const int16_t ys[4] = { (int16_t)y0, (int16_t)y1, (int16_t)y2, (int16_t)y3 };
+    Paint_DrawBezier(xs, ys, 4, color);
 }
 
 void WatcherDisplay::drawStar(uint16_t x, uint16_t y,
                              uint16_t outerRadius, uint16_t innerRadius,
                              uint8_t numPoints, uint16_t color, bool filled) {
     if (!initialized || !screenBuffer || numPoints < 3) return;
-    Paint_SelectImage(screenBuffer);
+    selectCanvas();
 
     uint16_t points[20 * 2];  // Max 10 points (20 coordinates)
     if (numPoints > 10) numPoints = 10;
 
     uint8_t totalVertices = numPoints * 2;
-    float angleStep = 2.0 * PI / totalVertices;
-    float angleOffset = -PI / 2.0;  // Start at top
+    const int32_t turn = (int32_t)360 << PAINT_ANGLE_FRAC_BITS;
+    const int32_t top = -((int32_t)90 << PAINT_ANGLE_FRAC_BITS);
 
-    // Generate star vertices (alternating outer/inner)
+    // Generate star vertices (alternating outer/inner) with the Q15 table
     for (uint8_t i = 0; i < totalVertices; i++) {
-        float angle = angleOffset + i * angleStep;
-        uint16_t radius = (i % 2 == 0) ? outerRadius : innerRadius;
+        int32_t angle = top + (i * turn + totalVertices / 2) / totalVertices;
+        int32_t radius = (i % 2 == 0) ? outerRadius : innerRadius;
 
-        points[i * 2] = x + radius * cos(angle);
-        points[i * 2 + 1] = y + radius * sin(angle);
+        points[i * 2] = x + ((radius * Paint_Cos(angle) + 0x4000) >> 15);
+        points[i * 2 + 1] = y + ((radius * Paint_Sin(angle) + 0x4000) >> 15);
     }
 
     drawPolygon(points, totalVertices, color, filled);
@@ -734,40 +1812,52 @@ void WatcherDisplay::drawHexagon(uint16_t x, uint16_t y, uint16_t radius,
     if (!initialized || !screenBuffer) return;
 
     uint16_t points[12];
-    float angleStep = PI / 3.0;  // 60 degrees
 
+    // Every 60 degrees, with the Q15 table
     for (uint8_t i = 0; i < 6; i++) {
-        float angle = i * angleStep;
-        points[i * 2] = x + radius * cos(angle);
-        points[i * 2 + 1] = y + radius * sin(angle);
+        int32_t angle = (int32_t)i * (60 << PAINT_ANGLE_FRAC_BITS);
+        points[i * 2] = x + (((int32_t)radius * Paint_Cos(angle) + 0x4000) >> 15);
+        points[i * 2 + 1] = y + (((int32_t)radius * Paint_Sin(angle) + 0x4000) >> 15);
     }
 
     drawPolygon(points, 6, color, filled);
 }
 
-void WatcherDisplay::floodFill(uint16_t x, uint16_t y, uint16_t color, uint16_t boundary) {
-    if (!initialized || !screenBuffer) return;
-
-    // Simple recursive flood fill (warning: can be slow and stack-intensive)
-    // Get current pixel color
-    uint16_t currentColor = UNCOLORED;
-    uint32_t byteIndex = (y * (DISPLAY_WIDTH / 8)) + (x / 8);
-    uint8_t bitPosition = 7 - (x % 8);
+bool WatcherDisplay::floodFill(uint16_t x, uint16_t y, uint16_t color, uint16_t boundary) {
+    if (!initialized || !screenBuffer) return false;
 
-    if (byteIndex >= BUFFER_SIZE) return;
+    // With two colours the seed is either the fill colour or the boundary
+    // unless they are the same, so only that case has anything to fill
+    if (boundary != color) return true;
 
-    currentColor = (screenBuffer[byteIndex] & (1 << bitPosition)) ? UNCOLORED : COLORED;
+    // Borrow a pool slot rather than touch the heap on every fill; without
+    // one, allocate a seed buffer once and keep it
+    const uint32_t seedBytes = FLOOD_FILL_MAX_SEEDS * sizeof(PAINT_FILL_SEED);
+    PAINT_FILL_SEED* seeds = floodSeeds;
+    if (!seeds && regionPool.isReady() && regionPool.getSlotSize() >= seedBytes) {
+        seeds = (PAINT_FILL_SEED*)regionPool.allocate(seedBytes);
+    }
+    if (!seeds) {
+        floodSeeds = (PAINT_FILL_SEED*)malloc(seedBytes);
+        if (!floodSeeds) {
+            Serial.println("Failed to allocate flood fill seeds!");
+            return false;
+        }
+        seeds = floodSeeds;
+    }
 
-    // Stop if already the target color or hit boundary
-    if (currentColor == color || currentColor == boundary) return;
+    bool complete = floodFill(x, y, color, boundary, seeds, FLOOD_FILL_MAX_SEEDS);
+    if (seeds != floodSeeds) regionPool.release(seeds);
+    return complete;
+}
 
-    // Fill this pixel
-    Paint_SelectImage(screenBuffer);
-    Paint_SetPixel(x, y, color);
+bool WatcherDisplay::floodFill(uint16_t x, uint16_t y, uint16_t color, uint16_t boundary,
+                               PAINT_FILL_SEED* seeds, uint16_t seedCount) {
+    if (!initialized || !screenBuffer || !seeds || seedCount == 0) return false;
+    if (boundary != color) return true;
+    selectCanvas();
 
-    // Recursive fill (4-way)
-    if (x > 0) floodFill(x - 1, y, color, boundary);
-    if (x < DISPLAY_WIDTH - 1) floodFill(x + 1, y, color, boundary);
-    if (y > 0) floodFill(x, y - 1, color, boundary);
-    if (y < DISPLAY_HEIGHT - 1) floodFill(x, y + 1, color, boundary);
+    bool complete = Paint_FloodFill(x, y, color, seeds, seedCount);
+    if (!complete) Serial.println("Flood fill ran out of seeds, region partly filled");
+    return complete;
 }
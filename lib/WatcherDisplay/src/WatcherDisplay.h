@@ -26,14 +26,80 @@
 #include "DEV_Config.h"
 #include "GUI_Paint.h"
 #include "FontHandler.h"
+#include "RegionPool.h"
+#include "RefreshPolicy.h"
+
+// Compile-time UI asset; sketches that draw them include VectorAsset.h
+template <uint16_t W, uint16_t H> struct VectorAsset;
 
 // Display constants
 #define DISPLAY_WIDTH  400
 #define DISPLAY_HEIGHT 300
 #define BUFFER_SIZE    15000  // (400/8) * 300 = 50 * 300
+#define GRAY_BUFFER_SIZE 30000  // (400/4) * 300, begin(..., grayscale)
+
+// Pixel values of the 2bpp grayscale buffer, as the 4-gray waveform shows
+// them (see EPD_4IN2_V2_Display_4Gray); WHITE and BLACK also work
+#define GRAY_LEVEL_WHITE 0x03
+#define GRAY_LEVEL_LIGHT 0x01
+#define GRAY_LEVEL_DARK  0x02
+#define GRAY_LEVEL_BLACK 0x00
+
+// Colors used by the WatcherDisplay API
+#ifndef COLORED
+#define COLORED   BLACK
+#endif
+#ifndef UNCOLORED
+#define UNCOLORED WHITE
+#endif
 
 // Default refresh strategy
 #define DEFAULT_FULL_REFRESH_INTERVAL 5  // Full refresh every N partial updates
+#define DEFAULT_DIFF_FULL_REFRESH_INTERVAL 60  // Same, with differential partials (0 = never)
+
+// Latency budgets for markDirty(): how late a change may reach the panel
+#define LATENCY_IMMEDIATE_MS    0     // Next serviceUpdates()
+#define LATENCY_INTERACTIVE_MS  50    // Button feedback
+#define LATENCY_PROGRESS_MS     1000  // Clocks, progress bars
+
+// Deferred maintenance (setDeferredMaintenance)
+#define DEFAULT_MAINTENANCE_MAX_DEFER_MS 300000  // Longest a due clean waits for an idle window
+
+// Asynchronous refresh timeouts (BUSY never dropping means the panel is stuck)
+#define DEFAULT_FULL_REFRESH_TIMEOUT_MS    6000
+#define DEFAULT_PARTIAL_REFRESH_TIMEOUT_MS 2000
+
+// Batched partial refresh
+#define MAX_QUEUED_REGIONS 8  // Windows per flush(); beyond that the cheapest pair is merged
+
+// Framebuffer diff (updateChanged)
+#define DIFF_MAX_SPANS        8   // Column spans per row, and open row bands
+#define DIFF_MAX_REGIONS      32  // Changed rects collected before planning
+#define DIFF_SPLIT_GAP_BYTES  4   // Unchanged bytes that split a row into spans
+
+// Partial refresh cost model defaults (see RefreshCostModel)
+#define DEFAULT_COST_FIXED_US       350000  // Partial waveform + BUSY wait
+#define DEFAULT_COST_PER_WINDOW_US  150     // Window/cursor commands, one byte per transaction
+#define DEFAULT_COST_PER_BYTE_NS    500     // Streamed image data at 20MHz SPI plus overhead
+
+// Per-tile ghosting (setTileCleaning), 7x5 tiles on the 400x300 panel
+#define GHOST_TILE_SIZE  64  // Tile edge in pixels (8 bytes of a row)
+#define GHOST_TILES_X    ((DISPLAY_WIDTH + GHOST_TILE_SIZE - 1) / GHOST_TILE_SIZE)
+#define GHOST_TILES_Y    ((DISPLAY_HEIGHT + GHOST_TILE_SIZE - 1) / GHOST_TILE_SIZE)
+#define DEFAULT_TILE_PARTIAL_LIMIT 60    // Partials over a tile before it is cleaned
+#define DEFAULT_TILE_FLIP_LIMIT    8192  // Flipped pixels in a tile (2x its area) before it is cleaned
+
+// Pending spans of floodFill(), 8 bytes each. A perfect maze of 1px
+// corridors over the whole screen needs ~1600.
+#define FLOOD_FILL_MAX_SEEDS 2048
+
+// Shape cache (cacheShape/drawCached)
+#define MAX_CACHED_SHAPES 16
+
+// Upright canvas (setUprightRendering), one logical row per buffer row
+#define UPRIGHT_WIDTH_BYTES  ((DISPLAY_HEIGHT + 7) / 8)
+#define UPRIGHT_BUFFER_SIZE  (UPRIGHT_WIDTH_BYTES * DISPLAY_WIDTH)  // 38 * 400
+#define UPRIGHT_BLOCK_WALKS  16  // Column-walk byte writes that cost one 8x8 rotation
 
 /**
  * UIRegion - Represents a rectangular region on the display
@@ -53,15 +119,84 @@ struct UIRegion {
         UIRegion aligned;
         aligned.x = (x / 8) * 8;
         aligned.y = y;
-        aligned.width = ((width + 7) / 8) * 8;
+        aligned.width = ((right() + 7) / 8) * 8 - aligned.x;
         aligned.height = height;
         return aligned;
     }
 
     uint16_t right() const { return x + width; }
     uint16_t bottom() const { return y + height; }
+
+    // Smallest region covering both
+    UIRegion unionWith(const UIRegion& other) const {
+        uint16_t x0 = x < other.x ? x : other.x;
+        uint16_t y0 = y < other.y ? y : other.y;
+        uint16_t x1 = right() > other.right() ? right() : other.right();
+        uint16_t y1 = bottom() > other.bottom() ? bottom() : other.bottom();
+        return UIRegion(x0, y0, x1 - x0, y1 - y0);
+    }
+};
+
+/**
+ * RefreshState - What the panel is doing right now
+ */
+enum RefreshState {
+    REFRESH_IDLE = 0,
+    REFRESH_FULL_RUNNING,
+    REFRESH_PARTIAL_RUNNING,
+    REFRESH_CLEAN_RUNNING    // Inverted flash of some windows (beginCleanRegion())
+};
+
+/**
+ * RefreshResult - How an asynchronous refresh ended
+ */
+enum RefreshResult {
+    REFRESH_COMPLETED = 0,
+    REFRESH_TIMED_OUT
+};
+
+/**
+ * RefreshCostModel - Estimated time of a partial refresh, used to plan windows
+ * cost = fixedUs + sum over windows of (perWindowUs + bytes * perByteNs / 1000)
+ * (window terms count twice with differential refresh: 0x26 and 0x24)
+ */
+struct RefreshCostModel {
+    uint32_t fixedUs;      // Paid once per refresh
+    uint32_t perWindowUs;  // Paid per RAM window
+    uint32_t perByteNs;    // Paid per image byte
+};
+
+/**
+ * GhostTile - Ghosting accumulated by one GHOST_TILE_SIZE tile since it was
+ * last cleaned (both counters saturate)
+ */
+struct GhostTile {
+    uint16_t partials;  // Partial refreshes that touched the tile
+    uint16_t flips;     // Pixels they flipped (the whole overlap without a shadow)
+};
+
+/**
+ * BatchMode - How flush() loads queued regions into the controller
+ */
+enum BatchMode {
+    BATCH_MULTI_WINDOW = 0,  // One RAM window per region, single update
+    BATCH_UNION_WINDOW       // One window covering all regions (controllers
+                             // that don't retain RAM between windows)
 };
 
+/**
+ * Completion callback for asynchronous refreshes
+ * Called from poll() (never from the interrupt), so it may draw or start
+ * the next refresh.
+ */
+typedef void (*RefreshCallback)(RefreshResult result, RefreshState kind, void* context);
+
+/**
+ * Draws a shape for cacheShape(), origin at the shape's top-left corner
+ * Use COLORED for ink; Paint_* calls and draw* methods both work.
+ */
+typedef void (*ShapeDrawCallback)(void* context);
+
 /**
  * WatcherDisplay - Main display controller class
  */
@@ -76,9 +211,26 @@ public:
     /**
      * Initialize the display hardware and clear screen
      * @param fastInit Use fast initialization mode (default: false)
+     * @param rotation Paint rotation of the screen buffer (default: 270, portrait)
+     * @param poolSlotSize Largest sub-buffer, in bytes (0 = no region pool,
+     *                     sub-buffers come from the heap)
+     * @param poolSlots Number of sub-buffers available at once
+     * @param poolInPsram Place the region pool in PSRAM (BOARD_HAS_PSRAM only)
+     * @param grayscale 2bpp screen buffer (GRAY_BUFFER_SIZE) shown with the
+     *                  4-gray waveform; fastInit is ignored. The panel has no
+     *                  4-gray partial waveform, so every refresh is a full one,
+     *                  and differential refresh, upright rendering and
+     *                  copySubBuffer() are not available
      * @return true if successful
      */
-    bool begin(bool fastInit = false);
+    bool begin(bool fastInit = false, UWORD rotation = ROTATE_270,
+               uint32_t poolSlotSize = 0, uint8_t poolSlots = 0,
+               bool poolInPsram = false, bool grayscale = false);
+
+    /**
+     * Check whether the screen buffer is 2bpp (see begin())
+     */
+    bool isGrayscale() const { return grayscale; }
 
     /**
      * Clear the entire display and reset buffers
@@ -121,12 +273,367 @@ public:
      */
     void partialRefresh(const UIRegion& region);
 
+    // ========== Asynchronous Refresh ==========
+
+    /**
+     * Start a full refresh and return immediately
+     * The waveform runs while the caller keeps working; call poll() from
+     * loop() to observe completion. Waits for any refresh already running.
+     * @return true if the refresh was started
+     */
+    bool beginFullRefresh();
+
+    /**
+     * Start a full refresh with the fast LUT (~1.5s) and return immediately
+     * Re-runs EPD_4IN2_V2_Init_Fast first; partials keep working after it.
+     * Cleans less than beginFullRefresh() (see GhostBudgetPolicy).
+     * Falls back to beginFullRefresh() in grayscale mode.
+     * @return true if the refresh was started
+     */
+    bool beginFastFullRefresh();
+
+    /**
+     * Start a partial refresh of a region and return immediately
+     * @param region The region to update
+     * @return true if the refresh was started
+     */
+    bool beginPartialRefresh(const UIRegion& region);
+
+    /**
+     * Queue a region for the next flush()
+     * Lets several regions share one partial waveform instead of paying a
+     * full update cycle each. Regions are byte-aligned when queued; if the
+     * queue is full they are merged into a single union window.
+     * @param region The region to queue
+     * @return false if the region is invalid
+     */
+    bool queueRegion(const UIRegion& region);
+    bool queueRegion(uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+
+    /**
+     * Load every queued region and start one partial refresh (asynchronous)
+     * @return true if a refresh was started, false if nothing was queued
+     */
+    bool flush();
+
+    /**
+     * Get the number of regions waiting for flush()
+     */
+    uint8_t getQueuedRegionCount() const { return queuedCount; }
+
+    /**
+     * Select how flush() loads queued regions (default: BATCH_MULTI_WINDOW)
+     */
+    void setBatchMode(BatchMode mode) { batchMode = mode; }
+
+    /**
+     * Plan the cheapest set of byte-aligned windows covering some regions
+     * Regions are merged greedily while the cost model says a union is no
+     * dearer than sending both; at most MAX_QUEUED_REGIONS are returned.
+     * flush() runs this on the queue in BATCH_MULTI_WINDOW mode.
+     * @param regions Input regions (any alignment; invalid ones are skipped)
+     * @param count Number of input regions
+     * @param planned Output, room for MAX_QUEUED_REGIONS windows
+     * @return Number of planned windows
+     */
+    uint8_t planRegions(const UIRegion* regions, uint8_t count, UIRegion* planned) const;
+
+    /**
+     * Estimate the time of one refresh showing these regions as separate windows
+     * @return Cost in microseconds (0 for no regions)
+     */
+    uint32_t estimateCost(const UIRegion* regions, uint8_t count) const;
+
+    /**
+     * Set or get the cost model used for planning
+     */
+    void setCostModel(const RefreshCostModel& model) { costModel = model; }
+    const RefreshCostModel& getCostModel() const { return costModel; }
+
+    /**
+     * Refine the cost model from measured refresh timings (default: on)
+     */
+    void setCostCalibration(bool enabled) { costCalibration = enabled; }
+
+    /**
+     * Refresh everything drawn since the last refresh (asynchronous)
+     * Every Paint_* primitive and draw* method records the area it touched,
+     * so callers no longer compute refresh rectangles by hand. The recorded
+     * areas are byte-aligned, merged and flushed as one partial refresh.
+     * @return true if a refresh was started, false if nothing was drawn
+     */
+    bool commit();
+
+    /**
+     * Refresh exactly what changed since the last refresh (asynchronous)
+     * Compares the screen buffer against a shadow of the last frame sent,
+     * a word at a time with a per-row early-out, and refreshes the changed
+     * row bands/column spans through the planner. Allocates the 15KB
+     * shadow on first use (that call does a full refresh to sync it).
+     * @return true if a refresh was started; false if nothing changed or
+     *         a refresh is still running (call again later)
+     */
+    bool updateChanged();
+
+    /**
+     * Find the byte-aligned rects where the screen differs from the shadow
+     * @param regions Output array
+     * @param maxRegions Capacity; extra rects are merged into the last one
+     * @return Number of rects (0 if nothing changed or there is no shadow)
+     */
+    uint8_t findChangedRegions(UIRegion* regions, uint8_t maxRegions);
+
+    /**
+     * Mark a region as changed, to be shown within a latency budget
+     * Nothing is sent yet: serviceUpdates() waits until the earliest
+     * pending deadline and then shows everything marked so far with one
+     * partial refresh. Changes with loose budgets ride along with urgent
+     * ones instead of paying a waveform each.
+     * @param region The region that changed
+     * @param latencyMs Budget from now (LATENCY_INTERACTIVE_MS, LATENCY_PROGRESS_MS, ...)
+     * @return false if the region is invalid
+     */
+    bool markDirty(const UIRegion& region, uint16_t latencyMs);
+
+    /**
+     * Mark everything drawn since the last refresh (the dirty rects, as
+     * commit() uses them) with a latency budget
+     */
+    void markDirty(uint16_t latencyMs);
+
+    /**
+     * Scheduler tick for markDirty(); call from loop()
+     * Once the earliest deadline has passed and the panel is idle, shows
+     * every pending change in one refresh: through updateChanged() when
+     * the shadow is in sync (only the changed bytes), otherwise by
+     * flushing the marked regions.
+     * @return true if a refresh was started
+     */
+    bool serviceUpdates();
+
+    /**
+     * Check whether marked changes are waiting, and until when at most
+     */
+    bool hasPendingUpdates() const { return updatesPending; }
+    unsigned long getUpdateDeadline() const { return updateDeadlineMs; }
+
+    /**
+     * Payload bytes sent to the panel by the last commit() (0 if nothing was drawn)
+     */
+    uint32_t getLastCommitBytes() const { return lastCommitBytes; }
+
+    /**
+     * Payload bytes sent by all commits, and the number of commits that refreshed
+     */
+    uint32_t getTotalCommitBytes() const { return totalCommitBytes; }
+    uint32_t getCommitCount() const { return commitCount; }
+
+    /**
+     * Advance the refresh state machine
+     * Consumes the BUSY-pin edge latched by the interrupt, applies the
+     * timeout and fires the completion callback.
+     * @return true while a refresh is still running
+     */
+    bool poll();
+
+    /**
+     * Check whether a refresh is still running (polls the state machine)
+     */
+    bool isBusy() { return poll(); }
+
+    /**
+     * Block until the running refresh (if any) has finished
+     * @return false if it timed out
+     */
+    bool waitForRefresh();
+
+    /**
+     * Get the current refresh state
+     */
+    RefreshState getRefreshState() const { return refreshState; }
+
+    /**
+     * Set a callback fired when an asynchronous refresh completes or times out
+     */
+    void setRefreshCallback(RefreshCallback callback, void* context = nullptr) {
+        refreshCallback = callback;
+        refreshCallbackContext = context;
+    }
+
+    /**
+     * Set the BUSY timeouts for full and partial refreshes
+     */
+    void setRefreshTimeout(uint32_t fullMs, uint32_t partialMs) {
+        fullRefreshTimeoutMs = fullMs;
+        partialRefreshTimeoutMs = partialMs;
+    }
+
     /**
      * Force a full refresh if too many partial updates have occurred
      * Call this periodically if you're managing updates manually
+     * (does nothing with a refresh policy, which cleans as it goes).
+     * With tile cleaning on, cleans the ghosted tiles instead.
+     * With deferred maintenance on, this is the scheduler tick: it never
+     * blocks, and starts the clean asynchronously once the app is idle
+     * or the clean is overdue. Call it from loop(), after serviceUpdates();
+     * it waits while markDirty() changes are pending.
      */
     void maintainDisplay();
 
+    /**
+     * Postpone cleaning (full refresh or tile clean) to idle moments
+     * Once a clean is due it waits until the app declares itself idle
+     * (setIdle(), declareIdleWindow()), and runs anyway after maxDeferMs.
+     * updateRegion() no longer cleans inline; maintainDisplay() does.
+     * Choices of a refresh policy are not deferred.
+     * @param enabled true to enable
+     * @param maxDeferMs Hard upper bound on the wait, from when the clean
+     *                   became due
+     */
+    void setDeferredMaintenance(bool enabled,
+                                uint32_t maxDeferMs = DEFAULT_MAINTENANCE_MAX_DEFER_MS);
+    bool isDeferredMaintenance() const { return deferredMaintenance; }
+
+    /**
+     * Declare the app idle until further notice (paused, menu, finished)
+     * A flash now costs the user nothing.
+     */
+    void setIdle(bool idle) { idleHeld = idle; }
+
+    /**
+     * Declare a quiet window starting now (e.g. a minute boundary)
+     * A due clean may start any time before it closes; updates drawn
+     * meanwhile wait for the clean.
+     * @param durationMs Length of the window
+     */
+    void declareIdleWindow(uint32_t durationMs);
+
+    /**
+     * Check whether the app is idle (setIdle() or inside a window)
+     */
+    bool isIdle() const;
+
+    /**
+     * Check whether a clean is waiting for an idle moment
+     */
+    bool isMaintenanceDue() const { return maintenanceDue; }
+
+    /**
+     * Clean ghosted tiles with inverted flashes instead of full refreshes
+     * Every partial is charged to the GHOST_TILE_SIZE tiles it touches (one
+     * partial, plus the pixels it flips). A tile past either limit is cleaned
+     * on its own: updateRegion() and maintainDisplay() call
+     * cleanGhostedTiles(), which flashes just those windows, and the fixed
+     * full refresh interval is no longer used. A refresh policy still
+     * chooses full waveforms if one is set.
+     * @param enabled true to enable
+     * @param partialLimit Partials per tile before cleaning (0 = no limit)
+     * @param flipLimit Flipped pixels per tile before cleaning (0 = no limit)
+     * @return false in grayscale mode (no partial waveform)
+     */
+    bool setTileCleaning(bool enabled,
+                         uint16_t partialLimit = DEFAULT_TILE_PARTIAL_LIMIT,
+                         uint16_t flipLimit = DEFAULT_TILE_FLIP_LIMIT);
+    bool isTileCleaning() const { return tileCleaning; }
+
+    /**
+     * Get the ghosting of a tile (counted whether or not cleaning is on)
+     * @param tx Tile column, 0..GHOST_TILES_X-1
+     * @param ty Tile row, 0..GHOST_TILES_Y-1
+     */
+    const GhostTile& getGhostTile(uint8_t tx, uint8_t ty) const { return ghostTiles[ty][tx]; }
+
+    /**
+     * Plan the windows covering every tile past its limit
+     * @param windows Output, room for MAX_QUEUED_REGIONS windows
+     * @return Number of windows (0 if no tile needs cleaning)
+     */
+    uint8_t findGhostedTiles(UIRegion* windows) const;
+
+    /**
+     * Start cleaning the tiles past their limit (asynchronous)
+     * @return true if a clean was started, false if no tile needs one
+     */
+    bool cleanGhostedTiles();
+
+    /**
+     * Clean the ghosting of one region without flashing the rest of the screen
+     * Two partial waveforms: the first drives every pixel of the window to
+     * its inverse, the second drives it back, so each pixel takes a full
+     * black/white swing (~2x a partial refresh). Reports completion once,
+     * as REFRESH_CLEAN_RUNNING. Tiles the region covers are reset. The
+     * window shows the shadow when it is in sync, otherwise the screen
+     * buffer, which should not be drawn into until the clean finishes.
+     * @param region The region to clean (byte-aligned like partials)
+     * @return true if the clean was started
+     */
+    bool beginCleanRegion(const UIRegion& region);
+
+    /**
+     * Clean a region and wait for it (blocking beginCleanRegion())
+     */
+    void cleanRegion(const UIRegion& region);
+
+    /**
+     * Let a policy choose the waveform of every partial update
+     * Each partial (updateRegion(), flush(), commit(), updateChanged()) is
+     * described to the policy by its area, the pixels it flips (counted
+     * against the shadow when it is in sync, otherwise the whole area) and
+     * its estimated cost; the policy answers partial, fast-full or full.
+     * Replaces the fixed full refresh interval. The policy is not owned.
+     * @param policy Policy, or nullptr for the fixed interval
+     */
+    void setRefreshPolicy(RefreshPolicy* policy) { refreshPolicy = policy; }
+    RefreshPolicy* getRefreshPolicy() const { return refreshPolicy; }
+
+    /**
+     * Enable differential partial refresh
+     * Keeps a shadow of what the panel shows and writes it to the controller's
+     * "previous image" RAM (0x26) with every partial, so partials stop ghosting
+     * and the forced full refresh can be rare or disabled. Costs a second
+     * 15KB buffer. The first partial after enabling is promoted to a full
+     * refresh to bring the shadow in sync.
+     * @param enabled true to enable
+     * @param fullRefreshInterval New forced full refresh cadence (0 = never)
+     * @return false if the shadow buffer could not be allocated
+     */
+    bool setDifferentialRefresh(bool enabled,
+                                uint8_t fullRefreshInterval = DEFAULT_DIFF_FULL_REFRESH_INTERVAL);
+
+    /**
+     * Check whether differential partial refresh is enabled
+     */
+    bool isDifferentialRefresh() const { return differentialEnabled; }
+
+    /**
+     * Draw into an upright (logical orientation) canvas when it pays
+     * At rotation 90/270 every logical row is a column walk in the screen
+     * buffer. With this on, Paint can draw into a second 15KB buffer in
+     * logical orientation, and only the dirty rects are rotated into the
+     * screen buffer (8x8 bit transposes) right before a refresh.
+     * The rotation costs about as much as the drawing saves only when
+     * a frame is mostly thin horizontal spans, so each refresh picks the
+     * canvas for the next frame: upright while the column walks a frame
+     * did (or would have done) outweigh the blocks its dirty rects take
+     * to rotate, straight into the screen buffer otherwise (small
+     * regions, text, rectangle fills).
+     * The screen buffer stays in panel layout, so regions passed to
+     * updateRegion()/queueRegion() keep using panel (memory) coordinates.
+     * @param enabled true to enable
+     * @return false if the rotation is 0/180 or the canvas could not be allocated
+     */
+    bool setUprightRendering(bool enabled);
+
+    /**
+     * Check whether upright rendering is on
+     */
+    bool isUprightRendering() const { return uprightBuffer != nullptr; }
+
+    /**
+     * Check whether the current frame draws into the upright canvas
+     */
+    bool isDrawingUpright() const { return uprightActive; }
+
     /**
      * Reset the partial refresh counter (call after manual full refresh)
      */
@@ -279,9 +786,11 @@ public:
      * @param numPoints Number of vertices (minimum 3)
      * @param color Line color
      * @param filled true to fill, false for outline only
+     * @param rule Fill rule for concave or self-intersecting outlines
      */
     void drawPolygon(const uint16_t* points, uint8_t numPoints,
-                    uint16_t color, bool filled = false);
+                    uint16_t color, bool filled = false,
+                    FILL_RULE rule = FILL_RULE_EVEN_ODD);
 
     /**
      * Draw an arc (portion of a circle)
@@ -328,10 +837,12 @@ public:
      * @param x1, y1 End point
      * @param thickness Line thickness in pixels
      * @param color Line color
+     * @param cap LINE_CAP_BUTT (square ends) or LINE_CAP_ROUND
      */
     void drawThickLine(uint16_t x0, uint16_t y0,
                       uint16_t x1, uint16_t y1,
-                      uint16_t thickness, uint16_t color);
+                      uint16_t thickness, uint16_t color,
+                      LINE_CAP cap = LINE_CAP_BUTT);
 
     /**
      * Draw a quadratic Bezier curve
@@ -345,6 +856,20 @@ public:
                    uint16_t x2, uint16_t y2,
                    uint16_t color);
 
+    /**
+     * Draw a cubic Bezier curve
+     * @param x0, y0 Start point
+     * @param x1, y1 First control point
+     * @param x2, y2 Second control point
+     * @param x3, y3 End point
+     * @param color Curve color
+     */
+    void drawBezier(uint16_t x0, uint16_t y0,
+                   uint16_t x1, uint16_t y1,
+                   uint16_t x2, uint16_t y2,
+                   uint16_t x3, uint16_t y3,
+                   uint16_t color);
+
     /**
      * Draw a star
      * @param x Center X coordinate
@@ -376,14 +901,82 @@ public:
      * @param y Starting Y coordinate
      * @param color Fill color
      * @param boundary Boundary color (stops filling at this color)
-     * WARNING: Can be slow and memory-intensive, use with caution
+     * @return false if the region was too complex for FLOOD_FILL_MAX_SEEDS
+     *         (it is then only partly filled) or the seeds could not be allocated
+     * Scanline fill: pending spans live in a FLOOD_FILL_MAX_SEEDS array, so
+     * stack use no longer grows with the area. The array is a free region
+     * pool slot when one is big enough, otherwise a buffer allocated on the
+     * first fill and kept for the next ones.
+     */
+    bool floodFill(uint16_t x, uint16_t y, uint16_t color, uint16_t boundary);
+
+    /**
+     * Flood fill with caller-provided seed storage
+     * @param seeds Scratch for pending spans
+     * @param seedCount Entries in seeds; the fill stops (partly done,
+     *        returns false) when they run out
+     */
+    bool floodFill(uint16_t x, uint16_t y, uint16_t color, uint16_t boundary,
+                   PAINT_FILL_SEED* seeds, uint16_t seedCount);
+
+    // ========== Shape Cache ==========
+
+    /**
+     * Rasterize an expensive vector element once into a 1bpp sprite
+     * The callback draws on a white, upright width x height canvas;
+     * everything it inks becomes the sprite, which drawCached() then
+     * blits in the screen's rotation. The
+     * sprite is width x height bits (~1.2KB for a 70x130 digit) and comes
+     * from the region pool when there is one, the heap otherwise.
+     * @param width Sprite width in pixels
+     * @param height Sprite height in pixels
+     * @param draw Draws the element at (0, 0)
+     * @param context Passed to draw
+     * @return Shape handle, or -1 if all MAX_CACHED_SHAPES slots are used
+     *         or the sprite could not be allocated
+     */
+    int8_t cacheShape(uint16_t width, uint16_t height,
+                      ShapeDrawCallback draw, void* context = nullptr);
+
+    /**
+     * Draw a cached shape (byte-wide row blits, no rasterizing)
+     * Pixels outside the shape's ink are left alone.
+     * @param shape Handle from cacheShape()
+     * @param x X coordinate of the top-left corner
+     * @param y Y coordinate of the top-left corner
+     * @param color Ink color
+     * @return false if the handle is not a cached shape
+     */
+    bool drawCached(int8_t shape, uint16_t x, uint16_t y, uint16_t color = COLORED);
+
+    /**
+     * Free a cached shape's sprite and its slot
+     */
+    void releaseCached(int8_t shape);
+
+    /**
+     * Draw a compile-time rasterized asset from flash (see VectorAsset.h)
+     * Pixels outside the asset's ink are left alone.
+     * @param x X coordinate of the asset's top-left corner
+     * @param y Y coordinate of the asset's top-left corner
+     * @param asset Asset built with vectorRasterize() or vectorRasterizePolygons()
+     * @param color Ink color
+     * @return The ink bounding box at (x, y) in drawing coordinates (panel
+     *         coordinates at ROTATE_0), ready for updateRegion()/queueRegion()
      */
-    void floodFill(uint16_t x, uint16_t y, uint16_t color, uint16_t boundary);
+    template <uint16_t W, uint16_t H>
+    UIRegion drawAsset(uint16_t x, uint16_t y, const VectorAsset<W, H>& asset,
+                       uint16_t color = COLORED) {
+        blitBits(x, y, asset.bits, W, H, color);
+        return UIRegion(x + asset.inkX, y + asset.inkY, asset.inkW, asset.inkH);
+    }
 
     // ========== Buffer Management ==========
 
     /**
      * Get direct access to the main screen buffer (for advanced use)
+     * With upright rendering on, the screen buffer only catches up with
+     * drawing at the next refresh
      * @return Pointer to 15KB screen buffer
      */
     UBYTE* getBuffer() { return screenBuffer; }
@@ -393,10 +986,21 @@ public:
      * Useful for complex UI elements that need their own buffer
      * @param width Buffer width (must be multiple of 8)
      * @param height Buffer height
-     * @return Pointer to allocated buffer (caller must free())
+     * @return Pointer to allocated buffer (release with releaseSubBuffer())
+     *         or nullptr if the region pool is exhausted
      */
     UBYTE* createSubBuffer(uint16_t width, uint16_t height);
 
+    /**
+     * Return a sub-buffer to the region pool (or the heap)
+     */
+    void releaseSubBuffer(UBYTE* buffer);
+
+    /**
+     * Get the region pool configured in begin() (statistics, high-water mark)
+     */
+    const RegionPool& getRegionPool() const { return regionPool; }
+
     /**
      * Copy a sub-buffer region to the main screen buffer
      * @param subBuffer Source buffer
@@ -416,7 +1020,7 @@ public:
 
     /**
      * Set the full refresh interval
-     * @param interval Number of partial updates before forcing full refresh
+     * @param interval Number of partial updates before forcing full refresh (0 = never)
      */
     void setFullRefreshInterval(uint8_t interval) { fullRefreshInterval = interval; }
 
@@ -433,15 +1037,127 @@ public:
 
 private:
     // Display state
-    UBYTE* screenBuffer;           // Main 15KB screen buffer
+    UBYTE* screenBuffer;           // Main 15KB screen buffer (30KB in grayscale)
     uint8_t partialRefreshCount;   // Counter for hybrid refresh strategy
     uint8_t fullRefreshInterval;   // Partial updates before full refresh
     bool autoFullRefreshEnabled;   // Auto-refresh enabled flag
     bool initialized;              // Initialization state
+    bool grayscale;                // 2bpp buffer, 4-gray waveform
+
+    // Differential refresh / diff state
+    UBYTE* shadowBuffer;           // Last frame sent to the panel
+    bool differentialEnabled;      // Write shadow to RAM 0x26 on partials
+    bool shadowValid;              // Shadow committed by a completed refresh
+
+    // Upright rendering (see setUprightRendering())
+    UWORD rotation;                // Rotation passed to begin()
+    UBYTE* uprightBuffer;          // Logical-orientation canvas, or nullptr
+    bool uprightActive;            // Paint draws into the canvas this frame
+    bool uprightStaleValid;        // Screen drawn since the canvas last matched
+    PAINT_RECT uprightStale;       // Bounds of that drawing, panel coordinates
+
+    // Asynchronous refresh state
+    RefreshState refreshState;     // What is running on the panel
+    RefreshResult lastRefreshResult; // How the last refresh ended
+    UIRegion activeRegion;         // Region of the running partial refresh
+    unsigned long refreshStartMs;  // When the running refresh was triggered
+    bool busySeen;                 // BUSY observed high since the trigger
+    uint32_t fullRefreshTimeoutMs;
+    uint32_t partialRefreshTimeoutMs;
+    RefreshCallback refreshCallback;
+    void* refreshCallbackContext;
+
+    // Batched partial refresh state
+    UIRegion queuedRegions[MAX_QUEUED_REGIONS];
+    uint8_t queuedCount;
+    BatchMode batchMode;
+
+    // Waveform choice (see setRefreshPolicy())
+    RefreshPolicy* refreshPolicy;
+    bool fastFullRunning;          // The running full refresh uses the fast LUT
+
+    // Per-tile ghosting (see setTileCleaning())
+    GhostTile ghostTiles[GHOST_TILES_Y][GHOST_TILES_X];
+    bool tileCleaning;
+    uint16_t tilePartialLimit;
+    uint16_t tileFlipLimit;
+    UIRegion cleanWindows[MAX_QUEUED_REGIONS];  // Windows of the running clean
+    uint8_t cleanCount;
+    bool cleanInverted;            // The running clean shows the inverse
+    bool cleanFromShadow;          // The clean redraws the shadow, not the screen buffer
+
+    // Deferred maintenance (see setDeferredMaintenance())
+    bool deferredMaintenance;
+    uint32_t maintenanceMaxDeferMs;
+    bool maintenanceDue;           // A clean is waiting for an idle moment
+    unsigned long maintenanceDueMs; // Since when
+    bool idleHeld;                 // setIdle(true)
+    bool idleWindowOpen;           // declareIdleWindow() until idleUntilMs
+    unsigned long idleUntilMs;
+
+    // Refresh planning
+    RefreshCostModel costModel;
+    bool costCalibration;
+    unsigned long lastLoadUs;      // SPI time of the last partial's windows
+    uint8_t lastLoadWindows;
+
+    // Sub-buffer arena (see begin())
+    RegionPool regionPool;
+
+    // Shape cache: sprites in sFONT layout, set bit = ink
+    struct CachedShape {
+        UBYTE* bits;
+        uint16_t width;
+        uint16_t height;
+    };
+    CachedShape cachedShapes[MAX_CACHED_SHAPES];
+    UBYTE* captureBuffer;          // Sprite being rendered by cacheShape()
+
+    // floodFill() seeds when the pool has no slot for them, kept once allocated
+    PAINT_FILL_SEED* floodSeeds;
+
+    // drawPolygon() edges past PAINT_POLYGON_STACK_EDGES when the pool has
+    // no slot for them, grown to the largest polygon and kept
+    UBYTE* polygonScratch;
+    uint8_t polygonScratchPoints;
+
+    // Update coalescing (see markDirty())
+    bool updatesPending;
+    unsigned long updateDeadlineMs; // Earliest deadline among pending changes
+
+    // Commit statistics
+    uint32_t lastRefreshBytes;     // Image payload of the last refresh started
+    uint32_t lastCommitBytes;
+    uint32_t totalCommitBytes;
+    uint32_t commitCount;
 
     // Internal helper methods
-    void extractRegionBuffer(const UIRegion& region, UBYTE* destBuffer);
-    void partialRefreshRaw(const UIRegion& region, const UBYTE* regionBuffer);
+    void stageShadow(const UIRegion& region);
+    bool ensureShadow();
+    bool alignRegion(const UIRegion& region, UIRegion& aligned) const;
+    bool beginPartialWindows(const UIRegion* regions, uint8_t count);
+    bool startFullWaveform(bool fast);
+    uint32_t countFlips(const UIRegion& region) const;
+    bool beginCleanWindows(const UIRegion* regions, uint8_t count);
+    void loadCleanWindows(bool inverted);
+    void chargeTiles(const UIRegion* regions, uint8_t count);
+    void resetTiles(const UIRegion& region);
+    void relieveTiles(uint8_t divisor);
+    bool needsMaintenance() const;
+    void queueDirtyRects();
+    void schedule(uint16_t latencyMs);
+    void selectCanvas();
+    bool blitBits(uint16_t x, uint16_t y, const UBYTE* bits,
+                  uint16_t width, uint16_t height, uint16_t color);
+    void syncUpright();
+    void switchCanvas(bool upright);
+    PAINT_RECT uprightToScreen(const PAINT_RECT& rect) const;
+    PAINT_RECT screenToUpright(const PAINT_RECT& rect) const;
+    uint32_t windowCostUs(const UIRegion& window) const;
+    void calibrateCostModel(unsigned long waveformMs);
+    void armRefresh();
+    void startRefresh(RefreshState kind);
+    void finishRefresh(RefreshResult result);
 };
 
 #endif // WATCHER_DISPLAY_H
@@ -28,6 +28,7 @@
 #
 ******************************************************************************/
 #include "DEV_Config.h"
+#include <string.h>
 
 SPIClass *devSpi = &SPI;
 SPISettings devSpiSettings = SPISettings(20000000, MSBFIRST, SPI_MODE0); // up to 40MHz; reduce if unstable
@@ -35,6 +36,16 @@ SPISettings devSpiSettings = SPISettings(20000000, MSBFIRST, SPI_MODE0); // up t
 /* Internal flag to track if we own transaction */
 static bool dev_in_transaction = false;
 
+/* Transfer accounting */
+static DEV_SPI_STATS dev_spi_stats = {0, 0};
+
+/* Set from the BUSY falling-edge ISR, cleared by DEV_Busy_TakeIRQ() */
+static volatile bool dev_busy_edge = false;
+static bool dev_busy_irq_attached = false;
+
+/* Chunk size used when streaming a repeated byte */
+#define DEV_SPI_FILL_CHUNK 64
+
 void GPIO_Config(void)
 {
     pinMode(EPD_BUSY_PIN,  INPUT);
@@ -88,6 +99,7 @@ void DEV_SPI_BeginTransaction(void)
         devSpi->beginTransaction(devSpiSettings);
         digitalWrite(EPD_CS_PIN, LOW);
         dev_in_transaction = true;
+        dev_spi_stats.transactions++;
     }
 }
 
@@ -119,6 +131,8 @@ void DEV_SPI_WriteByte(UBYTE data)
     devSpi->transfer(data);
     digitalWrite(EPD_CS_PIN, HIGH);
     devSpi->endTransaction();
+    dev_spi_stats.transactions++;
+    dev_spi_stats.bytes++;
     // //SPI.beginTransaction(spi_settings);
     // digitalWrite(EPD_CS_PIN, GPIO_PIN_RESET);
 
@@ -145,6 +159,8 @@ UBYTE DEV_SPI_ReadByte()
     val = devSpi->transfer(0x00);
     digitalWrite(EPD_CS_PIN, HIGH);
     devSpi->endTransaction();
+    dev_spi_stats.transactions++;
+    dev_spi_stats.bytes++;
     return val;
     // UBYTE j=0xff;
     // GPIO_Mode(EPD_MOSI_PIN, 0);
@@ -163,10 +179,11 @@ UBYTE DEV_SPI_ReadByte()
     // return j;
 }
 
-void DEV_SPI_Write_nByte(UBYTE *pData, UDOUBLE len)
+void DEV_SPI_Write_nByte(const UBYTE *pData, UDOUBLE len)
 {
     if (len == 0 || pData == NULL) return;
 
+    dev_spi_stats.bytes += len;
     if (!dev_in_transaction) {
         // local single transaction for this bulk write
         devSpi->beginTransaction(devSpiSettings);
@@ -174,6 +191,7 @@ void DEV_SPI_Write_nByte(UBYTE *pData, UDOUBLE len)
         devSpi->transferBytes(pData, NULL, (size_t)len);
         digitalWrite(EPD_CS_PIN, HIGH);
         devSpi->endTransaction();
+        dev_spi_stats.transactions++;
     } else {
         // we are inside a transaction already, do not toggle CS or transaction
         devSpi->transferBytes(pData, NULL, (size_t)len);
@@ -181,3 +199,94 @@ void DEV_SPI_Write_nByte(UBYTE *pData, UDOUBLE len)
     // for (int i = 0; i < len; i++)
     //     DEV_SPI_WriteByte(pData[i]);
 }
+
+/******************************************************************************
+function:	Command + payload streaming
+Info:
+    DEV_SPI_StreamBegin() sends the command byte with DC low, then raises DC
+    and opens one transaction with CS held low. Every StreamWrite/StreamFill
+    after that goes out as payload without touching DC or CS, until
+    DEV_SPI_StreamEnd() releases the bus.
+******************************************************************************/
+void DEV_SPI_StreamBegin(UBYTE Reg)
+{
+    digitalWrite(EPD_DC_PIN, LOW);
+    DEV_SPI_WriteByte(Reg);
+    digitalWrite(EPD_DC_PIN, HIGH);
+    DEV_SPI_BeginTransaction();
+}
+
+void DEV_SPI_StreamWrite(const UBYTE *pData, UDOUBLE len)
+{
+    DEV_SPI_Write_nByte(pData, len);
+}
+
+void DEV_SPI_StreamFill(UBYTE value, UDOUBLE len)
+{
+    UBYTE chunk[DEV_SPI_FILL_CHUNK];
+    memset(chunk, value, sizeof(chunk));
+
+    while (len > 0) {
+        UDOUBLE n = (len > sizeof(chunk)) ? sizeof(chunk) : len;
+        DEV_SPI_Write_nByte(chunk, n);
+        len -= n;
+    }
+}
+
+void DEV_SPI_StreamEnd(void)
+{
+    DEV_SPI_EndTransaction();
+}
+
+/******************************************************************************
+function:	BUSY pin interrupt
+Info:
+    The panel holds BUSY high while a waveform runs and drops it when done.
+    The ISR only latches that edge; all bookkeeping happens in the caller's
+    poll loop.
+******************************************************************************/
+static void IRAM_ATTR DEV_Busy_ISR(void)
+{
+    dev_busy_edge = true;
+}
+
+void DEV_Busy_AttachIRQ(void)
+{
+    if (dev_busy_irq_attached) return;
+    dev_busy_edge = false;
+    attachInterrupt(digitalPinToInterrupt(EPD_BUSY_PIN), DEV_Busy_ISR, FALLING);
+    dev_busy_irq_attached = true;
+}
+
+void DEV_Busy_DetachIRQ(void)
+{
+    if (!dev_busy_irq_attached) return;
+    detachInterrupt(digitalPinToInterrupt(EPD_BUSY_PIN));
+    dev_busy_irq_attached = false;
+    dev_busy_edge = false;
+}
+
+UBYTE DEV_Busy_TakeIRQ(void)
+{
+    if (!dev_busy_edge) return 0;
+    dev_busy_edge = false;
+    return 1;
+}
+
+/******************************************************************************
+function:	Transfer accounting
+Info:
+    bytes counts every byte clocked out, transactions counts every
+    beginTransaction. Reset before a frame and read back afterwards to see
+    what a refresh path actually costs on the bus.
+******************************************************************************/
+void DEV_SPI_ResetStats(void)
+{
+    dev_spi_stats.bytes = 0;
+    dev_spi_stats.transactions = 0;
+}
+
+DEV_SPI_STATS DEV_SPI_GetStats(void)
+{
+    return dev_spi_stats;
+}
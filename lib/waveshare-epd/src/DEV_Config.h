@@ -53,7 +53,7 @@ UBYTE DEV_Module_Init(void);
 void GPIO_Mode(UWORD GPIO_Pin, UWORD Mode);
 void DEV_SPI_WriteByte(UBYTE data);
 UBYTE DEV_SPI_ReadByte();
-void DEV_SPI_Write_nByte(UBYTE *pData, UDOUBLE len);
+void DEV_SPI_Write_nByte(const UBYTE *pData, UDOUBLE len);
 
 /* New helpers to control CS / transactions across multiple writes */
 void DEV_SPI_BeginTransaction(void);   // beginTransaction + assert CS
@@ -61,6 +61,28 @@ void DEV_SPI_EndTransaction(void);     // deassert CS + endTransaction
 void DEV_CS_Assert(void);
 void DEV_CS_Release(void);
 
+/* Command + payload streaming: DC is set once and CS is held for the whole
+   payload, so a frame costs a handful of transactions instead of one per byte */
+void DEV_SPI_StreamBegin(UBYTE Reg);                  // send command, then DC high + CS low
+void DEV_SPI_StreamWrite(const UBYTE *pData, UDOUBLE len);
+void DEV_SPI_StreamFill(UBYTE value, UDOUBLE len);    // repeat one byte (clear screens)
+void DEV_SPI_StreamEnd(void);                         // CS high + endTransaction
+
+/* BUSY pin edge interrupt: latches the busy->idle (falling) edge so callers
+   can poll for refresh completion without spinning on the pin */
+void DEV_Busy_AttachIRQ(void);
+void DEV_Busy_DetachIRQ(void);
+UBYTE DEV_Busy_TakeIRQ(void);                         // returns 1 once per latched edge
+
+/* Transfer accounting (bytes on the wire and beginTransaction count) */
+typedef struct {
+    UDOUBLE bytes;
+    UDOUBLE transactions;
+} DEV_SPI_STATS;
+
+void DEV_SPI_ResetStats(void);
+DEV_SPI_STATS DEV_SPI_GetStats(void);
+
 extern SPIClass *devSpi;
 extern SPISettings devSpiSettings;
 
@@ -168,28 +168,16 @@ void GUI_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
 
 void GUI_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
                              int16_t r, uint16_t color) {
-    // Draw rectangle with rounded corners (simplified)
-    drawRect(x + r, y, w - 2*r, h, color);
-    drawRect(x, y + r, w, h - 2*r, color);
-
-    // Draw corner circles
-    drawCircle(x + r, y + r, r, color);
-    drawCircle(x + w - r - 1, y + r, r, color);
-    drawCircle(x + r, y + h - r - 1, r, color);
-    drawCircle(x + w - r - 1, y + h - r - 1, r, color);
+    if (w <= 0 || h <= 0) return;
+    UWORD paint_color = _colorTo1Bit(color);
+    Paint_DrawRoundRect(x, y, x + w - 1, y + h - 1, r < 0 ? 0 : r, paint_color, DRAW_FILL_EMPTY);
 }
 
 void GUI_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
                               int16_t r, uint16_t color) {
-    // Fill rectangle with rounded corners
-    fillRect(x + r, y, w - 2*r, h, color);
-    fillRect(x, y + r, w, h - 2*r, color);
-
-    // Fill corner circles
-    fillCircle(x + r, y + r, r, color);
-    fillCircle(x + w - r - 1, y + r, r, color);
-    fillCircle(x + r, y + h - r - 1, r, color);
-    fillCircle(x + w - r - 1, y + h - r - 1, r, color);
+    if (w <= 0 || h <= 0) return;
+    UWORD paint_color = _colorTo1Bit(color);
+    Paint_DrawRoundRect(x, y, x + w - 1, y + h - 1, r < 0 ? 0 : r, paint_color, DRAW_FILL_FULL);
 }
 
 // ========== Text Drawing ==========
@@ -83,6 +83,121 @@
 
 PAINT Paint;
 
+/******************************************************************************
+function: Write one pixel for a fixed rotation/mirror/scale
+parameter:
+    Xpoint, Ypoint : Logical point inside Paint.win*
+    Color          : Painted color
+info:
+    Rotation and mirroring always reduce to an optional X/Y swap followed by
+    optional X and Y flips of memory coordinates; each combination gets its
+    own instantiation so the per-pixel path has no switches left.
+******************************************************************************/
+template<bool Swap, bool FlipX, bool FlipY, UBYTE Bpp>
+static void Paint_WritePixel(UWORD Xpoint, UWORD Ypoint, UWORD Color)
+{
+    UWORD X = Swap ? Ypoint : Xpoint;
+    UWORD Y = Swap ? Xpoint : Ypoint;
+    if(FlipX) X = Paint.WidthMemory - X - 1;
+    if(FlipY) Y = Paint.HeightMemory - Y - 1;
+
+    // Most pixels land in the rect the previous one grew
+    if(Paint.dirtyEnabled) {
+        const PAINT_RECT *r = &Paint.dirty[Paint.dirtyLast];
+        if(Paint.dirtyCount == 0 || X < r->X1 || X > r->X2 || Y < r->Y1 || Y > r->Y2)
+            Paint_MarkDirty(X, Y, X, Y);
+    }
+
+    UBYTE *Byte = Paint.Image + (UDOUBLE)Y * Paint.WidthByte + X / (8 / Bpp);
+    if(Bpp == 1) {
+        UBYTE bitMask = 0x80 >> (X % 8);
+        if(Color == BLACK)
+            *Byte &= ~bitMask;
+        else
+            *Byte |= bitMask;
+    } else if(Bpp == 2) {
+        UBYTE shift = (3 - (X % 4)) * 2;
+        *Byte = (*Byte & ~(0x03 << shift)) | ((Color % 4) << shift);
+    } else {
+        UBYTE shift = (1 - (X % 2)) * 4;
+        *Byte = (*Byte & ~(0x0F << shift)) | ((Color & 0x0F) << shift);
+    }
+}
+
+#define PAINT_WRITERS(Bpp) { \
+    Paint_WritePixel<false, false, false, Bpp>, Paint_WritePixel<false, false, true, Bpp>, \
+    Paint_WritePixel<false, true,  false, Bpp>, Paint_WritePixel<false, true,  true, Bpp>, \
+    Paint_WritePixel<true,  false, false, Bpp>, Paint_WritePixel<true,  false, true, Bpp>, \
+    Paint_WritePixel<true,  true,  false, Bpp>, Paint_WritePixel<true,  true,  true, Bpp> }
+
+// [bpp index][Swap << 2 | FlipX << 1 | FlipY]
+static const PAINT_WRITER Paint_Writers[3][8] = {
+    PAINT_WRITERS(1), PAINT_WRITERS(2), PAINT_WRITERS(4)
+};
+
+/******************************************************************************
+function: Pick the pixel writer and drawable window for the current state
+info:
+    Called whenever rotation, mirroring, scale, image size or the clip
+    region change. The window is the logical image, cut to what maps inside
+    memory and to the clip region, so the writer needs no bounds checks.
+******************************************************************************/
+static void Paint_SelectWriter(void)
+{
+    bool Swap, FlipX, FlipY;
+    switch(Paint.Rotate) {
+    case 0:   Swap = false; FlipX = false; FlipY = false; break;
+    case 90:  Swap = true;  FlipX = true;  FlipY = false; break;
+    case 180: Swap = false; FlipX = true;  FlipY = true;  break;
+    case 270: Swap = true;  FlipX = false; FlipY = true;  break;
+    default:
+        Paint.Writer = NULL;
+        Paint.Transform = 0;
+        Paint.winW = Paint.winH = 0;
+        return;
+    }
+    if(Paint.Mirror & MIRROR_HORIZONTAL) FlipX = !FlipX;
+    if(Paint.Mirror & MIRROR_VERTICAL) FlipY = !FlipY;
+
+    UBYTE Bpp = (Paint.Scale == 2) ? 0 : (Paint.Scale == 4) ? 1 : 2;
+    Paint.Transform = (Swap ? PAINT_XFORM_SWAP : 0) |
+                      (FlipX ? PAINT_XFORM_FLIP_X : 0) |
+                      (FlipY ? PAINT_XFORM_FLIP_Y : 0);
+    Paint.Writer = Paint_Writers[Bpp][Paint.Transform];
+
+    // Logical X walks memory Y when swapped, so bound it by that side too
+    UWORD XLimit = Swap ? Paint.HeightMemory : Paint.WidthMemory;
+    UWORD YLimit = Swap ? Paint.WidthMemory : Paint.HeightMemory;
+    if(Paint.Width < XLimit) XLimit = Paint.Width;
+    if(Paint.Height < YLimit) YLimit = Paint.Height;
+
+    UWORD X1 = 0, Y1 = 0;
+    UDOUBLE X2 = XLimit, Y2 = YLimit;  // Exclusive
+    if(Paint.clippingEnabled) {
+        X1 = Paint.clipX1;
+        Y1 = Paint.clipY1;
+        if((UDOUBLE)Paint.clipX2 + 1 < X2) X2 = (UDOUBLE)Paint.clipX2 + 1;
+        if((UDOUBLE)Paint.clipY2 + 1 < Y2) Y2 = (UDOUBLE)Paint.clipY2 + 1;
+    }
+    Paint.winX = X1;
+    Paint.winY = Y1;
+    Paint.winW = (X2 > X1) ? X2 - X1 : 0;
+    Paint.winH = (Y2 > Y1) ? Y2 - Y1 : 0;
+}
+
+/******************************************************************************
+function: Plot a pixel through the selected writer
+info:
+    One unsigned compare per axis covers image bounds and clipping
+******************************************************************************/
+static inline void Paint_Plot(UWORD Xpoint, UWORD Ypoint, UWORD Color)
+{
+    if((UWORD)(Xpoint - Paint.winX) >= Paint.winW ||
+       (UWORD)(Ypoint - Paint.winY) >= Paint.winH)
+        return;
+    Paint.Writer(Xpoint, Ypoint, Color);
+}
+
 /******************************************************************************
 function: Create Image
 parameter:
@@ -114,6 +229,10 @@ void Paint_NewImage(UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD
     Paint.clipY1 = 0;
     Paint.clipX2 = Width - 1;
     Paint.clipY2 = Height - 1;
+
+    // A new image starts clean (tracking setting is kept)
+    Paint.dirtyCount = 0;
+    Paint.dirtyLast = 0;
     
     if(Rotate == ROTATE_0 || Rotate == ROTATE_180) {
         Paint.Width = Width;
@@ -122,6 +241,8 @@ void Paint_NewImage(UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD
         Paint.Width = Height;
         Paint.Height = Width;
     }
+
+    Paint_SelectWriter();
 }
 
 /******************************************************************************
@@ -144,6 +265,7 @@ void Paint_SetRotate(UWORD Rotate)
     if(Rotate == ROTATE_0 || Rotate == ROTATE_90 || Rotate == ROTATE_180 || Rotate == ROTATE_270) {
         // Debug("Set image Rotate %d\r\n", Rotate);
         Paint.Rotate = Rotate;
+        Paint_SelectWriter();
     } else {
         Debug("rotate = 0, 90, 180, 270\r\n");
     }
@@ -159,6 +281,7 @@ void Paint_SetMirroring(UBYTE mirror){
         mirror == MIRROR_VERTICAL || mirror == MIRROR_ORIGIN) {
         // Debug("mirror image x:%s, y:%s\r\n",(mirror & 0x01)? "mirror":"none", ((mirror >> 1) & 0x01)? "mirror":"none");
         Paint.Mirror = mirror;
+        Paint_SelectWriter();
     } else {
         Debug("mirror should be MIRROR_NONE, MIRROR_HORIZONTAL, \
         MIRROR_VERTICAL or MIRROR_ORIGIN\r\n");
@@ -182,94 +305,71 @@ void Paint_SetScale(UBYTE scale)
 	else {
         Debug("Set Scale Input parameter error\r\n");
         Debug("Scale Only support: 2 4 7\r\n");
+        return;
     }
+    Paint_SelectWriter();
 }
 /******************************************************************************
-function: Draw Pixels
+function: Map a logical (rotated/mirrored) point to image memory coordinates
 parameter:
-    Xpoint : At point X
-    Ypoint : At point Y
-    Color  : Painted colors
+    Xpoint, Ypoint : Logical point, already checked against Paint.Width/Height
+    X, Y           : Resulting memory point
+return:
+    false if the point lands outside the image
 ******************************************************************************/
-void Paint_SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color)
+static inline bool Paint_MapToMemory(UWORD Xpoint, UWORD Ypoint, UWORD *X, UWORD *Y)
 {
-    // Bounds check
-    if(Xpoint >= Paint.Width || Ypoint >= Paint.Height){
-        return;
-    }
-    
-    // Clipping check (optimization)
-    if(Paint.clippingEnabled) {
-        if(Xpoint < Paint.clipX1 || Xpoint > Paint.clipX2 ||
-           Ypoint < Paint.clipY1 || Ypoint > Paint.clipY2) {
-            return;
-        }
-    }
-    
-    UWORD X, Y;
-    // Coordinate transformation
     switch(Paint.Rotate) {
     case 0:
-        X = Xpoint;
-        Y = Ypoint;  
+        *X = Xpoint;
+        *Y = Ypoint;  
         break;
     case 90:
-        X = Paint.WidthMemory - Ypoint - 1;
-        Y = Xpoint;
+        *X = Paint.WidthMemory - Ypoint - 1;
+        *Y = Xpoint;
         break;
     case 180:
-        X = Paint.WidthMemory - Xpoint - 1;
-        Y = Paint.HeightMemory - Ypoint - 1;
+        *X = Paint.WidthMemory - Xpoint - 1;
+        *Y = Paint.HeightMemory - Ypoint - 1;
         break;
     case 270:
-        X = Ypoint;
-        Y = Paint.HeightMemory - Xpoint - 1;
+        *X = Ypoint;
+        *Y = Paint.HeightMemory - Xpoint - 1;
         break;
     default:
-        return;
+        return false;
     }
     
     switch(Paint.Mirror) {
     case MIRROR_NONE:
         break;
     case MIRROR_HORIZONTAL:
-        X = Paint.WidthMemory - X - 1;
+        *X = Paint.WidthMemory - *X - 1;
         break;
     case MIRROR_VERTICAL:
-        Y = Paint.HeightMemory - Y - 1;
+        *Y = Paint.HeightMemory - *Y - 1;
         break;
     case MIRROR_ORIGIN:
-        X = Paint.WidthMemory - X - 1;
-        Y = Paint.HeightMemory - Y - 1;
+        *X = Paint.WidthMemory - *X - 1;
+        *Y = Paint.HeightMemory - *Y - 1;
         break;
     default:
-        return;
+        return false;
     }
 
-    if(X >= Paint.WidthMemory || Y >= Paint.HeightMemory){
-        return;
-    }
-    
-    // Optimized pixel setting based on scale
-    if(Paint.Scale == 2){
-        UDOUBLE Addr = X / 8 + Y * Paint.WidthByte;
-        UBYTE bitMask = 0x80 >> (X % 8);
-        if(Color == BLACK)
-            Paint.Image[Addr] &= ~bitMask;
-        else
-            Paint.Image[Addr] |= bitMask;
-    }else if(Paint.Scale == 4){
-        UDOUBLE Addr = X / 4 + Y * Paint.WidthByte;
-        Color = Color % 4;
-        UBYTE shift = (3 - (X % 4)) * 2;
-        UBYTE mask = ~(0x03 << shift);
-        Paint.Image[Addr] = (Paint.Image[Addr] & mask) | ((Color & 0x03) << shift);
-    }else if(Paint.Scale == 7 || Paint.Scale == 16){
-        UDOUBLE Addr = X / 2  + Y * Paint.WidthByte;
-        UBYTE shift = (1 - (X % 2)) * 4;
-        UBYTE mask = ~(0x0F << shift);
-        Paint.Image[Addr] = (Paint.Image[Addr] & mask) | ((Color & 0x0F) << shift);
-    }
+    return *X < Paint.WidthMemory && *Y < Paint.HeightMemory;
+}
+
+/******************************************************************************
+function: Draw Pixels
+parameter:
+    Xpoint : At point X
+    Ypoint : At point Y
+    Color  : Painted colors
+******************************************************************************/
+void Paint_SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color)
+{
+    Paint_Plot(Xpoint, Ypoint, Color);
 }
 
 /******************************************************************************
@@ -279,6 +379,11 @@ parameter:
 ******************************************************************************/
 void Paint_Clear(UWORD Color)
 {
+    if(Paint.dirtyEnabled) {
+        Paint.dirtyCount = 0;
+        Paint_MarkDirty(0, 0, Paint.WidthMemory - 1, Paint.HeightMemory - 1);
+    }
+
     if(Paint.Scale == 2) {
 		for (UWORD Y = 0; Y < Paint.HeightByte; Y++) {
 			for (UWORD X = 0; X < Paint.WidthByte; X++ ) {//8 pixel =  1 byte
@@ -303,6 +408,89 @@ void Paint_Clear(UWORD Color)
 	}
 }
 
+/******************************************************************************
+function: Fill a rectangle of image memory
+parameter:
+    X1, Y1, X2, Y2 : Memory coordinates, inclusive, inside the image
+    Color          : Painted color
+info:
+    Each row is a masked leading byte, memset for the middle and a masked
+    trailing byte, for 1bpp (scale 2), 2bpp (scale 4) and 4bpp (scale 7)
+******************************************************************************/
+static void Paint_FillMemoryRect(UWORD X1, UWORD Y1, UWORD X2, UWORD Y2, UWORD Color)
+{
+    UBYTE Bpp, Fill;
+    if(Paint.Scale == 2) {
+        Bpp = 1;
+        Fill = (Color == BLACK) ? 0x00 : 0xFF;
+    } else if(Paint.Scale == 4) {
+        Bpp = 2;
+        Fill = (Color % 4) * 0x55;
+    } else if(Paint.Scale == 7 || Paint.Scale == 16) {
+        Bpp = 4;
+        Fill = (Color & 0x0F) * 0x11;
+    } else {
+        return;
+    }
+
+    if(Paint.dirtyEnabled)
+        Paint_MarkDirty(X1, Y1, X2, Y2);
+
+    UBYTE PixelsPerByte = 8 / Bpp;
+    UWORD Byte1 = X1 / PixelsPerByte;
+    UWORD Byte2 = X2 / PixelsPerByte;
+    UBYTE Lead = 0xFF >> ((X1 % PixelsPerByte) * Bpp);
+    UBYTE Trail = (UBYTE)(0xFF << ((PixelsPerByte - 1 - X2 % PixelsPerByte) * Bpp));
+    if(Byte1 == Byte2)
+        Lead &= Trail;
+
+    // One byte per row here, or per column if the image were rotated
+    if(Byte1 == Byte2)
+        Paint.narrowRows += Y2 - Y1 + 1;
+    if(Y1 / 8 == Y2 / 8)
+        Paint.flatPixels += X2 - X1 + 1;
+
+    UBYTE *Row = Paint.Image + (UDOUBLE)Y1 * Paint.WidthByte;
+    for(UWORD Y = Y1; Y <= Y2; Y++, Row += Paint.WidthByte) {
+        Row[Byte1] = (Row[Byte1] & ~Lead) | (Fill & Lead);
+        if(Byte2 > Byte1) {
+            memset(Row + Byte1 + 1, Fill, Byte2 - Byte1 - 1);
+            Row[Byte2] = (Row[Byte2] & ~Trail) | (Fill & Trail);
+        }
+    }
+}
+
+/******************************************************************************
+function: Fill a rectangle given in logical (drawing) coordinates
+parameter:
+    Xstart, Ystart, Xend, Yend : Corners, inclusive, may lie off the image
+    Color                      : Painted color
+info:
+    Clips once against the drawing window, then maps the rect
+    through rotation/mirroring once (an axis-aligned rect stays one) and
+    fills memory with byte spans. Pixels match per-pixel Paint_SetPixel.
+******************************************************************************/
+static void Paint_FillSpanRect(int Xstart, int Ystart, int Xend, int Yend, UWORD Color)
+{
+    int XMin = Paint.winX, YMin = Paint.winY;
+    int XMax = XMin + Paint.winW - 1, YMax = YMin + Paint.winH - 1;
+    if(Xstart < XMin) Xstart = XMin;
+    if(Ystart < YMin) Ystart = YMin;
+    if(Xend > XMax) Xend = XMax;
+    if(Yend > YMax) Yend = YMax;
+    if(Xstart > Xend || Ystart > Yend)
+        return;
+
+    UWORD X1, Y1, X2, Y2;
+    if(!Paint_MapToMemory(Xstart, Ystart, &X1, &Y1) ||
+       !Paint_MapToMemory(Xend, Yend, &X2, &Y2))
+        return;
+
+    if(X1 > X2) { UWORD T = X1; X1 = X2; X2 = T; }
+    if(Y1 > Y2) { UWORD T = Y1; Y1 = Y2; Y2 = T; }
+    Paint_FillMemoryRect(X1, Y1, X2, Y2, Color);
+}
+
 /******************************************************************************
 function: Clear the color of a window
 parameter:
@@ -314,12 +502,7 @@ parameter:
 ******************************************************************************/
 void Paint_ClearWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
 {
-    UWORD X, Y;
-    for (Y = Ystart; Y < Yend; Y++) {
-        for (X = Xstart; X < Xend; X++) {//8 pixel =  1 byte
-            Paint_SetPixel(X, Y, Color);
-        }
-    }
+    Paint_FillSpanRect(Xstart, Ystart, (int)Xend - 1, (int)Yend - 1, Color);
 }
 
 /******************************************************************************
@@ -346,18 +529,49 @@ void Paint_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color,
                 if(Xpoint + XDir_Num - Dot_Pixel < 0 || Ypoint + YDir_Num - Dot_Pixel < 0)
                     break;
                 // printf("x = %d, y = %d\r\n", Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel);
-                Paint_SetPixel(Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel, Color);
+                Paint_Plot(Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel, Color);
             }
         }
     } else {
         for (XDir_Num = 0; XDir_Num <  Dot_Pixel; XDir_Num++) {
             for (YDir_Num = 0; YDir_Num <  Dot_Pixel; YDir_Num++) {
-                Paint_SetPixel(Xpoint + XDir_Num - 1, Ypoint + YDir_Num - 1, Color);
+                Paint_Plot(Xpoint + XDir_Num - 1, Ypoint + YDir_Num - 1, Color);
             }
         }
     }
 }
 
+// Cohen-Sutherland region codes
+#define PAINT_OUT_LEFT   0x01
+#define PAINT_OUT_RIGHT  0x02
+#define PAINT_OUT_TOP    0x04
+#define PAINT_OUT_BOTTOM 0x08
+
+static inline UBYTE Paint_OutCode(int X, int Y, int XMin, int YMin, int XMax, int YMax)
+{
+    UBYTE Code = 0;
+    if (X < XMin)
+        Code |= PAINT_OUT_LEFT;
+    else if (X > XMax)
+        Code |= PAINT_OUT_RIGHT;
+    if (Y < YMin)
+        Code |= PAINT_OUT_TOP;
+    else if (Y > YMax)
+        Code |= PAINT_OUT_BOTTOM;
+    return Code;
+}
+
+// Integer division rounding toward -inf / +inf (D > 0)
+static inline int64_t Paint_FloorDiv(int64_t N, int64_t D)
+{
+    return (N >= 0) ? N / D : -((-N + D - 1) / D);
+}
+
+static inline int64_t Paint_CeilDiv(int64_t N, int64_t D)
+{
+    return (N >= 0) ? (N + D - 1) / D : -(-N / D);
+}
+
 /******************************************************************************
 function: Draw a line of arbitrary slope
 parameter:
@@ -368,50 +582,94 @@ parameter:
     Color  ：The color of the line segment
     Line_width : Line width
     Line_Style: Solid and dotted lines
+info:
+    Coordinates are read as signed, so a line running off any edge of the
+    image or clip region is clipped instead of dropped. Dots are placed
+    like Paint_DrawPoint ones: centred one pixel up-left of the point
+    given, 2 * Line_width - 1 pixels wide.
+    Solid horizontal and vertical lines are a single span fill. Other
+    lines step the major axis and put pixel K of the minor axis at
+    round(K * DN / DM), halves away from the start; the visible range of
+    K is solved exactly, so a clipped line keeps the pixels (and dot
+    phase) of the unclipped one.
 ******************************************************************************/
 void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
                     UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style)
 {
-    if (Xstart > Paint.Width || Ystart > Paint.Height ||
-        Xend > Paint.Width || Yend > Paint.Height) {
-        Debug("Paint_DrawLine Input exceeds the normal display range\r\n");
+    if (Paint.winW == 0 || Paint.winH == 0)
         return;
-    }
 
-    UWORD Xpoint = Xstart;
-    UWORD Ypoint = Ystart;
-    int dx = (int)Xend - (int)Xstart >= 0 ? Xend - Xstart : Xstart - Xend;
-    int dy = (int)Yend - (int)Ystart <= 0 ? Yend - Ystart : Ystart - Yend;
+    int X0 = (int16_t)Xstart - 1, Y0 = (int16_t)Ystart - 1;
+    int X1 = (int16_t)Xend - 1, Y1 = (int16_t)Yend - 1;
 
-    // Increment direction, 1 is positive, -1 is counter;
-    int XAddway = Xstart < Xend ? 1 : -1;
-    int YAddway = Ystart < Yend ? 1 : -1;
+    // A dot covers [X - Grow, X + Grow] x [Y - Grow, Y + Grow], the
+    // 2 * Line_width - 1 square of Paint_DrawPoint
+    int Grow = (int)Line_width - 1;
+    int XMin = (int)Paint.winX - Grow, XMax = (int)Paint.winX + Paint.winW - 1 + Grow;
+    int YMin = (int)Paint.winY - Grow, YMax = (int)Paint.winY + Paint.winH - 1 + Grow;
 
-    //Cumulative error
-    int Esp = dx + dy;
-    char Dotted_Len = 0;
+    UBYTE Code0 = Paint_OutCode(X0, Y0, XMin, YMin, XMax, YMax);
+    UBYTE Code1 = Paint_OutCode(X1, Y1, XMin, YMin, XMax, YMax);
+    if (Code0 & Code1)
+        return;  // Both ends beyond the same edge
 
-    for (;;) {
-        Dotted_Len++;
-        //Painted dotted line, 2 point is really virtual
-        if (Line_Style == LINE_STYLE_DOTTED && Dotted_Len % 3 == 0) {
-            //Debug("LINE_DOTTED\r\n");
-            Paint_DrawPoint(Xpoint, Ypoint, IMAGE_BACKGROUND, Line_width, DOT_STYLE_DFT);
-            Dotted_Len = 0;
+    if (Line_Style == LINE_STYLE_SOLID && (X0 == X1 || Y0 == Y1)) {
+        Paint_FillSpanRect((X0 < X1 ? X0 : X1) - Grow, (Y0 < Y1 ? Y0 : Y1) - Grow,
+                           (X0 > X1 ? X0 : X1) + Grow, (Y0 > Y1 ? Y0 : Y1) + Grow, Color);
+        return;
+    }
+
+    // Major axis M, minor axis N
+    bool Steep = abs(Y1 - Y0) > abs(X1 - X0);
+    int M0 = Steep ? Y0 : X0, M1 = Steep ? Y1 : X1;
+    int N0 = Steep ? X0 : Y0, N1 = Steep ? X1 : Y1;
+    int MMin = Steep ? YMin : XMin, MMax = Steep ? YMax : XMax;
+    int NMin = Steep ? XMin : YMin, NMax = Steep ? XMax : YMax;
+    int DM = abs(M1 - M0), DN = abs(N1 - N0);
+    int SM = (M1 >= M0) ? 1 : -1, SN = (N1 >= N0) ? 1 : -1;
+
+    // Visible pixels K in [KFirst, KLast]
+    int64_t KFirst = 0, KLast = DM;
+    if (Code0 | Code1) {
+        int64_t Lo = (SM > 0) ? MMin - M0 : M0 - MMax;
+        int64_t Hi = (SM > 0) ? MMax - M0 : M0 - MMin;
+        if (Lo > KFirst) KFirst = Lo;
+        if (Hi < KLast) KLast = Hi;
+
+        // Minor offset J(K) = (2 * DN * K + DM) / (2 * DM) never decreases
+        int64_t JLo = (SN > 0) ? NMin - N0 : N0 - NMax;
+        int64_t JHi = (SN > 0) ? NMax - N0 : N0 - NMin;
+        if (DN == 0) {
+            if (JLo > 0 || JHi < 0)
+                return;
         } else {
-            Paint_DrawPoint(Xpoint, Ypoint, Color, Line_width, DOT_STYLE_DFT);
+            Lo = Paint_CeilDiv(2 * DM * JLo - DM, 2 * DN);
+            Hi = Paint_FloorDiv(2 * DM * JHi + DM - 1, 2 * DN);
+            if (Lo > KFirst) KFirst = Lo;
+            if (Hi < KLast) KLast = Hi;
         }
-        if (2 * Esp >= dy) {
-            if (Xpoint == Xend)
-                break;
-            Esp += dy;
-            Xpoint += XAddway;
-        }
-        if (2 * Esp <= dx) {
-            if (Ypoint == Yend)
-                break;
-            Esp += dx;
-            Ypoint += YAddway;
+        if (KFirst > KLast)
+            return;
+    }
+
+    int64_t Num = 2 * DN * KFirst + DM;
+    int J = DM ? (int)(Num / (2 * DM)) : 0;
+    int Err = DM ? (int)(Num - (int64_t)J * 2 * DM) : 0;  // In [0, 2 * DM)
+    int M = M0 + SM * (int)KFirst, N = N0 + SN * J;
+    for (int K = (int)KFirst; K <= (int)KLast; K++) {
+        //Painted dotted line, 2 point is really virtual
+        UWORD Dot = (Line_Style == LINE_STYLE_DOTTED && K % 3 == 2) ? IMAGE_BACKGROUND : Color;
+        int X = Steep ? N : M, Y = Steep ? M : N;
+        if (Grow == 0)
+            Paint.Writer(X, Y, Dot);
+        else
+            Paint_FillSpanRect(X - Grow, Y - Grow, X + Grow, Y + Grow, Dot);
+
+        M += SM;
+        Err += 2 * DN;
+        if (Err >= 2 * DM) {
+            Err -= 2 * DM;
+            N += SN;
         }
     }
 }
@@ -436,7 +694,11 @@ void Paint_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
         return;
     }
 
-    if (Draw_Fill) {
+    if (Draw_Fill && Line_width == DOT_PIXEL_1X1) {
+        // Same pixels as the per-row lines below: a 1x1 dot lands one
+        // pixel up-left of its coordinate
+        Paint_FillSpanRect((int)Xstart - 1, (int)Ystart - 1, (int)Xend - 1, (int)Yend - 2, Color);
+    } else if (Draw_Fill) {
         UWORD Ypoint;
         for(Ypoint = Ystart; Ypoint < Yend; Ypoint++) {
             Paint_DrawLine(Xstart, Ypoint, Xend, Ypoint, Color , Line_width, LINE_STYLE_SOLID);
@@ -449,6 +711,146 @@ void Paint_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
     }
 }
 
+/******************************************************************************
+function: Fill the arc rows of a rounded box
+parameter:
+    Left, Top     : Centre of the top-left corner arc
+    Right, Bottom : Centre of the bottom-right corner arc (>= Left, Top)
+    Dy            : Row offset above Top and below Bottom
+    Half          : Arc half-width on that row
+    Color         : Painted color
+    Split         : Leave out the straight band Left..Right
+info:
+    One span per row, or with Split the two arc caps either side of the
+    band, which the caller fills once as a rect. Offset 0 is a single
+    row when Top == Bottom.
+******************************************************************************/
+static inline void Paint_FillRoundRows(int Left, int Top, int Right, int Bottom,
+                                       int Dy, int Half, UWORD Color, bool Split)
+{
+    bool Both = (Bottom + Dy != Top - Dy);
+    if (!Split) {
+        Paint_FillSpanRect(Left - Half, Top - Dy, Right + Half, Top - Dy, Color);
+        if (Both)
+            Paint_FillSpanRect(Left - Half, Bottom + Dy, Right + Half, Bottom + Dy, Color);
+    } else if (Half > 0) {
+        Paint_FillSpanRect(Left - Half, Top - Dy, Left - 1, Top - Dy, Color);
+        Paint_FillSpanRect(Right + 1, Top - Dy, Right + Half, Top - Dy, Color);
+        if (Both) {
+            Paint_FillSpanRect(Left - Half, Bottom + Dy, Left - 1, Bottom + Dy, Color);
+            Paint_FillSpanRect(Right + 1, Bottom + Dy, Right + Half, Bottom + Dy, Color);
+        }
+    }
+}
+
+/******************************************************************************
+function: Plot one arc point in each corner of a rounded box
+parameter:
+    Left, Top, Right, Bottom : Corner arc centres, as Paint_FillRoundRows
+    Dx, Dy                   : Arc point relative to its centre (>= 0)
+    Color                    : Painted color
+info:
+    Mirror images that land on the same pixel (Dx or Dy 0 on a
+    zero-width or zero-height box) are plotted once.
+******************************************************************************/
+static inline void Paint_PlotRoundPoints(int Left, int Top, int Right, int Bottom,
+                                         int Dx, int Dy, UWORD Color)
+{
+    bool TwoX = (Left - Dx != Right + Dx);
+    Paint_Plot(Right + Dx, Bottom + Dy, Color);
+    if (TwoX)
+        Paint_Plot(Left - Dx, Bottom + Dy, Color);
+    if (Top - Dy != Bottom + Dy) {
+        Paint_Plot(Right + Dx, Top - Dy, Color);
+        if (TwoX)
+            Paint_Plot(Left - Dx, Top - Dy, Color);
+    }
+}
+
+/******************************************************************************
+function: Fill a rounded box, one span per scanline
+parameter:
+    Left, Top, Right, Bottom : Corner arc centres, as Paint_FillRoundRows
+    Radius                   : Corner radius
+    Color                    : Painted color
+info:
+    Midpoint circle: row X spans +-Y every step, row Y spans +-X when Y
+    steps down. Row Y is skipped when it is also row X (X == Y), so every
+    arc row is filled once at its widest and the straight middle is one
+    rect. A circle is the box with Left == Right, Top == Bottom.
+    When the rotation swaps axes, logical rows are memory columns and a
+    long row costs a byte per pixel, so a wide box fills its straight
+    band as one rect and its arc rows only outside it.
+******************************************************************************/
+static void Paint_FillRoundBox(int Left, int Top, int Right, int Bottom,
+                               int Radius, UWORD Color)
+{
+    bool Split = (Left != Right) && (Paint.Transform & PAINT_XFORM_SWAP);
+    int XCurrent = 0, YCurrent = Radius;
+    int Esp = 3 - 2 * Radius;
+    while (XCurrent <= YCurrent) {
+        Paint_FillRoundRows(Left, Top, Right, Bottom, XCurrent, YCurrent, Color, Split);
+        if (Esp < 0)
+            Esp += 4 * XCurrent + 6;
+        else {
+            if (YCurrent != XCurrent)
+                Paint_FillRoundRows(Left, Top, Right, Bottom, YCurrent, XCurrent, Color, Split);
+            Esp += 10 + 4 * (XCurrent - YCurrent);
+            YCurrent--;
+        }
+        XCurrent++;
+    }
+
+    if (Split) {
+        Paint_FillSpanRect(Left, Top - Radius, Right, Bottom + Radius, Color);
+        if (Bottom - Top > 1) {
+            Paint_FillSpanRect(Left - Radius, Top + 1, Left - 1, Bottom - 1, Color);
+            Paint_FillSpanRect(Right + 1, Top + 1, Right + Radius, Bottom - 1, Color);
+        }
+    } else if (Bottom - Top > 1) {
+        Paint_FillSpanRect(Left - Radius, Top + 1, Right + Radius, Bottom - 1, Color);
+    }
+}
+
+/******************************************************************************
+function: Outline a rounded box, each boundary pixel once
+parameter:
+    Left, Top, Right, Bottom : Corner arc centres, as Paint_FillRoundRows
+    Radius                   : Corner radius
+    Color                    : Painted color
+info:
+    The octant point (X, Y) and its mirror (Y, X) are the same pixel only
+    when X == Y. The straight edges stop short of the arc end points.
+******************************************************************************/
+static void Paint_StrokeRoundBox(int Left, int Top, int Right, int Bottom,
+                                 int Radius, UWORD Color)
+{
+    int XCurrent = 0, YCurrent = Radius;
+    int Esp = 3 - 2 * Radius;
+    while (XCurrent <= YCurrent) {
+        Paint_PlotRoundPoints(Left, Top, Right, Bottom, XCurrent, YCurrent, Color);
+        if (XCurrent != YCurrent)
+            Paint_PlotRoundPoints(Left, Top, Right, Bottom, YCurrent, XCurrent, Color);
+        if (Esp < 0)
+            Esp += 4 * XCurrent + 6;
+        else {
+            Esp += 10 + 4 * (XCurrent - YCurrent);
+            YCurrent--;
+        }
+        XCurrent++;
+    }
+    if (Right - Left > 1) {
+        Paint_FillSpanRect(Left + 1, Top - Radius, Right - 1, Top - Radius, Color);
+        if (Bottom + Radius != Top - Radius)
+            Paint_FillSpanRect(Left + 1, Bottom + Radius, Right - 1, Bottom + Radius, Color);
+    }
+    if (Bottom - Top > 1) {
+        Paint_FillSpanRect(Left - Radius, Top + 1, Left - Radius, Bottom - 1, Color);
+        if (Right + Radius != Left - Radius)
+            Paint_FillSpanRect(Right + Radius, Top + 1, Right + Radius, Bottom - 1, Color);
+    }
+}
+
 /******************************************************************************
 function: Use the 8-point method to draw a circle of the
             specified size at the specified position->
@@ -459,6 +861,9 @@ parameter:
     Color     ：The color of the ：circle segment
     Line_width: Line width
     Draw_Fill : Whether to fill the inside of the Circle
+info:
+    Points are placed like 1x1 Paint_DrawPoint dots, one pixel up-left
+    of the centre given.
 ******************************************************************************/
 void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
                       UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
@@ -468,6 +873,16 @@ void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
         return;
     }
 
+    int Xc = (int)X_Center - 1, Yc = (int)Y_Center - 1;
+    if (Draw_Fill == DRAW_FILL_FULL) {
+        Paint_FillRoundBox(Xc, Yc, Xc, Yc, Radius, Color);
+        return;
+    }
+    if (Line_width == DOT_PIXEL_1X1) {
+        Paint_StrokeRoundBox(Xc, Yc, Xc, Yc, Radius, Color);
+        return;
+    }
+
     //Draw a circle from(0, R) as a starting point
     int16_t XCurrent, YCurrent;
     XCurrent = 0;
@@ -476,47 +891,804 @@ void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
     //Cumulative error,judge the next point of the logo
     int16_t Esp = 3 - (Radius << 1 );
 
-    int16_t sCountY;
-    if (Draw_Fill == DRAW_FILL_FULL) {
-        while (XCurrent <= YCurrent ) { //Realistic circles
-            for (sCountY = XCurrent; sCountY <= YCurrent; sCountY ++ ) {
-                Paint_DrawPoint(X_Center + XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//1
-                Paint_DrawPoint(X_Center - XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//2
-                Paint_DrawPoint(X_Center - sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//3
-                Paint_DrawPoint(X_Center - sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//4
-                Paint_DrawPoint(X_Center - XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//5
-                Paint_DrawPoint(X_Center + XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//6
-                Paint_DrawPoint(X_Center + sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//7
-                Paint_DrawPoint(X_Center + sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+    //Draw a hollow circle
+    while (XCurrent <= YCurrent ) {
+        Paint_DrawPoint(X_Center + XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);//1
+        Paint_DrawPoint(X_Center - XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);//2
+        Paint_DrawPoint(X_Center - YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);//3
+        Paint_DrawPoint(X_Center - YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);//4
+        Paint_DrawPoint(X_Center - XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);//5
+        Paint_DrawPoint(X_Center + XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);//6
+        Paint_DrawPoint(X_Center + YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);//7
+        Paint_DrawPoint(X_Center + YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);//0
+
+        if (Esp < 0 )
+            Esp += 4 * XCurrent + 6;
+        else {
+            Esp += 10 + 4 * (XCurrent - YCurrent );
+            YCurrent --;
+        }
+        XCurrent ++;
+    }
+}
+
+/******************************************************************************
+function: Draw an axis-aligned ellipse
+parameter:
+    X_Center, Y_Center : Centre
+    Radius_X, Radius_Y : Semi-axes
+    Color              : Painted color
+    Draw_Fill          : Whether to fill the inside of the ellipse
+info:
+    Midpoint algorithm over one quadrant. The fill keeps the widest point
+    of the current row and emits its span when the row changes, so each
+    scanline is filled once; the outline plots each quadrant point in the
+    four mirrors, axis points once.
+******************************************************************************/
+void Paint_DrawEllipse(UWORD X_Center, UWORD Y_Center, UWORD Radius_X, UWORD Radius_Y,
+                       UWORD Color, DRAW_FILL Draw_Fill)
+{
+    int Xc = X_Center, Yc = Y_Center;
+    int32_t Rx2 = (int32_t)Radius_X * Radius_X;
+    int32_t Ry2 = (int32_t)Radius_Y * Radius_Y;
+    int32_t XCurrent = 0, YCurrent = Radius_Y;
+    int32_t RowY = YCurrent, RowX = 0;  // Fill: widest point seen on row RowY
+    bool Fill = (Draw_Fill == DRAW_FILL_FULL);
+
+    // Quadrant points in order: X never decreases, Y never increases
+    auto Point = [&](int32_t X, int32_t Y) {
+        if (!Fill) {
+            Paint_PlotRoundPoints(Xc, Yc, Xc, Yc, X, Y, Color);
+        } else if (Y != RowY) {
+            Paint_FillRoundRows(Xc, Yc, Xc, Yc, RowY, RowX, Color, false);
+            RowY = Y;
+            RowX = X;
+        } else {
+            RowX = X;
+        }
+    };
+
+    // Region 1: slope above -1, step X
+    int32_t P = Ry2 - Rx2 * Radius_Y + Rx2 / 4;
+    while (Ry2 * XCurrent < Rx2 * YCurrent) {
+        Point(XCurrent, YCurrent);
+        XCurrent++;
+        if (P < 0) {
+            P += 2 * Ry2 * XCurrent + Ry2;
+        } else {
+            YCurrent--;
+            P += 2 * Ry2 * XCurrent - 2 * Rx2 * YCurrent + Ry2;
+        }
+    }
+
+    // Region 2: slope below -1, step Y
+    P = Ry2 * (XCurrent * XCurrent + XCurrent) +
+        Rx2 * (YCurrent - 1) * (YCurrent - 1) - Rx2 * Ry2;
+    while (YCurrent >= 0) {
+        Point(XCurrent, YCurrent);
+        YCurrent--;
+        if (P > 0) {
+            P += -2 * Rx2 * YCurrent + Rx2;
+        } else {
+            XCurrent++;
+            P += 2 * Ry2 * XCurrent - 2 * Rx2 * YCurrent + Rx2;
+        }
+    }
+
+    if (Fill)
+        Paint_FillRoundRows(Xc, Yc, Xc, Yc, RowY, RowX, Color, false);
+}
+
+/******************************************************************************
+function: Draw a rectangle with rounded corners
+parameter:
+    Xstart, Ystart : Top-left corner, may lie off the image
+    Xend, Yend     : Bottom-right corner, inclusive
+    Radius         : Corner radius, clamped to half the shorter side
+    Color          : Painted color
+    Draw_Fill      : Whether to fill the inside of the rectangle
+info:
+    The shape keeps its geometry when it is partly off the image: spans
+    are clipped to the drawing window, arc points are dropped one by one,
+    and a box wholly outside the window draws nothing.
+******************************************************************************/
+void Paint_DrawRoundRect(int16_t Xstart, int16_t Ystart, int16_t Xend, int16_t Yend,
+                         UWORD Radius, UWORD Color, DRAW_FILL Draw_Fill)
+{
+    if (Xstart > Xend || Ystart > Yend) {
+        Debug("Paint_DrawRoundRect Input exceeds the normal display range\r\n");
+        return;
+    }
+    if (Xend < (int)Paint.winX || Xstart >= (int)Paint.winX + Paint.winW ||
+        Yend < (int)Paint.winY || Ystart >= (int)Paint.winY + Paint.winH)
+        return;
+
+    int R = Radius;
+    if (R > (Xend - Xstart) / 2)
+        R = (Xend - Xstart) / 2;
+    if (R > (Yend - Ystart) / 2)
+        R = (Yend - Ystart) / 2;
+
+    int Left = Xstart + R, Top = Ystart + R;
+    int Right = Xend - R, Bottom = Yend - R;
+    if (Draw_Fill == DRAW_FILL_FULL)
+        Paint_FillRoundBox(Left, Top, Right, Bottom, R, Color);
+    else
+        Paint_StrokeRoundBox(Left, Top, Right, Bottom, R, Color);
+}
+
+// sin(0..90 degrees) in Q15
+static const int16_t Paint_SinQ15[91] = {
+        0,   572,  1144,  1715,  2286,  2856,  3425,  3993,  4560,  5126,
+     5690,  6252,  6813,  7371,  7927,  8481,  9032,  9580, 10126, 10668,
+    11207, 11743, 12275, 12803, 13328, 13848, 14365, 14876, 15384, 15886,
+    16384, 16877, 17364, 17847, 18324, 18795, 19261, 19720, 20174, 20622,
+    21063, 21498, 21926, 22348, 22763, 23170, 23571, 23965, 24351, 24730,
+    25102, 25466, 25822, 26170, 26510, 26842, 27166, 27482, 27789, 28088,
+    28378, 28660, 28932, 29197, 29452, 29698, 29935, 30163, 30382, 30592,
+    30792, 30983, 31164, 31336, 31499, 31651, 31795, 31928, 32052, 32166,
+    32270, 32365, 32449, 32524, 32588, 32643, 32688, 32723, 32748, 32763,
+    32767,
+};
+
+// Q15 sine of a whole angle in [0, 360)
+static int32_t Paint_SinDeg(int Angle)
+{
+    if (Angle < 90)  return Paint_SinQ15[Angle];
+    if (Angle < 180) return Paint_SinQ15[180 - Angle];
+    if (Angle < 270) return -Paint_SinQ15[Angle - 180];
+    return -Paint_SinQ15[360 - Angle];
+}
+
+static inline int32_t Paint_CosDeg(int Angle)
+{
+    return Paint_SinDeg(Angle < 270 ? Angle + 90 : Angle - 270);
+}
+
+/******************************************************************************
+function: Q15 sine and cosine of a fractional angle
+parameter:
+    Angle : Degrees in 1/256 steps (PAINT_ANGLE_FRAC_BITS), any sign
+info:
+    Interpolated linearly between the whole degrees of Paint_SinQ15, which
+    keeps the result within 2/32768 of the exact value.
+******************************************************************************/
+int32_t Paint_Sin(int32_t Angle)
+{
+    const int32_t Turn = (int32_t)360 << PAINT_ANGLE_FRAC_BITS;
+    Angle %= Turn;
+    if (Angle < 0) Angle += Turn;
+
+    int Deg = Angle >> PAINT_ANGLE_FRAC_BITS;
+    int32_t Frac = Angle & ((1 << PAINT_ANGLE_FRAC_BITS) - 1);
+    int32_t A = Paint_SinDeg(Deg);
+    int32_t B = Paint_SinDeg(Deg == 359 ? 0 : Deg + 1);
+    return A + (((B - A) * Frac + (1 << (PAINT_ANGLE_FRAC_BITS - 1))) >> PAINT_ANGLE_FRAC_BITS);
+}
+
+int32_t Paint_Cos(int32_t Angle)
+{
+    return Paint_Sin(Angle + ((int32_t)90 << PAINT_ANGLE_FRAC_BITS));
+}
+
+// Sweep of an arc as Q15 unit vectors, Y pointing down the screen
+typedef struct {
+    int32_t SX, SY;     // Start direction
+    int32_t EX, EY;     // End direction
+    UWORD Sweep;        // Degrees, 1 to 360
+} PAINT_ARC;
+
+static inline bool Paint_InArc(const PAINT_ARC *Arc, int DX, int DY)
+{
+    if (Arc->Sweep >= 360)
+        return true;
+    // Counterclockwise of the start, and the end counterclockwise of it
+    bool AfterStart = Arc->SX * DY - Arc->SY * DX <= 0;
+    bool BeforeEnd = DX * Arc->EY - DY * Arc->EX <= 0;
+    return (Arc->Sweep > 180) ? (AfterStart || BeforeEnd) : (AfterStart && BeforeEnd);
+}
+
+// The four mirrors of (DX, DY) inside the arc, axis points once
+static inline void Paint_PlotArcPoints(const PAINT_ARC *Arc, int Xc, int Yc,
+                                       int DX, int DY, UWORD Color)
+{
+    if (Paint_InArc(Arc, DX, DY))
+        Paint_Plot(Xc + DX, Yc + DY, Color);
+    if (DX != 0 && Paint_InArc(Arc, -DX, DY))
+        Paint_Plot(Xc - DX, Yc + DY, Color);
+    if (DY != 0) {
+        if (Paint_InArc(Arc, DX, -DY))
+            Paint_Plot(Xc + DX, Yc - DY, Color);
+        if (DX != 0 && Paint_InArc(Arc, -DX, -DY))
+            Paint_Plot(Xc - DX, Yc - DY, Color);
+    }
+}
+
+/******************************************************************************
+function: Draw an arc of a circle
+parameter:
+    X_Center, Y_Center : Centre, placed like Paint_DrawCircle
+    Radius             : Arc radius
+    Start_Angle        : Start, in degrees counterclockwise from 3 o'clock
+    End_Angle          : End, reached counterclockwise from the start
+    Color              : Painted color
+info:
+    Walks the midpoint circle of Paint_DrawCircle once and keeps the
+    points inside the sweep, tested with two cross products against the
+    start and end directions from a Q15 sine table: no trig per point and
+    each pixel plotted once. Start == End draws nothing, 0 to 360 the
+    whole circle.
+******************************************************************************/
+void Paint_DrawArc(UWORD X_Center, UWORD Y_Center, UWORD Radius,
+                   int16_t Start_Angle, int16_t End_Angle, UWORD Color)
+{
+    int Start = Start_Angle % 360, End = End_Angle % 360;
+    if (Start < 0) Start += 360;
+    if (End < 0) End += 360;
+
+    PAINT_ARC Arc;
+    Arc.Sweep = (End >= Start) ? End - Start : End - Start + 360;
+    if (Arc.Sweep == 0 && Start_Angle != End_Angle)
+        Arc.Sweep = 360;
+    if (Arc.Sweep == 0)
+        return;
+    Arc.SX = Paint_CosDeg(Start);
+    Arc.SY = -Paint_SinDeg(Start);
+    Arc.EX = Paint_CosDeg(End);
+    Arc.EY = -Paint_SinDeg(End);
+
+    int Xc = (int)X_Center - 1, Yc = (int)Y_Center - 1;
+    int XCurrent = 0, YCurrent = Radius;
+    int Esp = 3 - 2 * Radius;
+    while (XCurrent <= YCurrent) {
+        Paint_PlotArcPoints(&Arc, Xc, Yc, XCurrent, YCurrent, Color);
+        if (XCurrent != YCurrent)
+            Paint_PlotArcPoints(&Arc, Xc, Yc, YCurrent, XCurrent, Color);
+        if (Esp < 0)
+            Esp += 4 * XCurrent + 6;
+        else {
+            Esp += 10 + 4 * (XCurrent - YCurrent);
+            YCurrent--;
+        }
+        XCurrent++;
+    }
+}
+
+#define PAINT_THICK_LINE_MAX 1024  // Widest Paint_DrawThickLine, keeps its products in 64 bits
+
+// floor(sqrt(N))
+static uint32_t Paint_Isqrt(uint64_t N)
+{
+    uint64_t Root = 0, Bit = (uint64_t)1 << 62;
+    while (Bit > N)
+        Bit >>= 2;
+    while (Bit) {
+        if (N >= Root + Bit) {
+            N -= Root + Bit;
+            Root = (Root >> 1) + Bit;
+        } else {
+            Root >>= 1;
+        }
+        Bit >>= 2;
+    }
+    return (uint32_t)Root;
+}
+
+// Narrow [*Lo, *Hi] to the x with A * x + B >= 0
+static inline void Paint_ClampLinear(int64_t A, int64_t B, int64_t *Lo, int64_t *Hi)
+{
+    if (A > 0) {
+        int64_t X = Paint_CeilDiv(-B, A);
+        if (X > *Lo) *Lo = X;
+    } else if (A < 0) {
+        int64_t X = Paint_FloorDiv(B, -A);
+        if (X < *Hi) *Hi = X;
+    } else if (B < 0) {
+        *Lo = 1;
+        *Hi = 0;
+    }
+}
+
+/******************************************************************************
+function: Draw a line of any width, one span per scanline
+parameter:
+    Xstart, Ystart : Start point (signed, may lie off the image)
+    Xend, Yend     : End point
+    Width          : Line width in pixels
+    Color          : Painted color
+    Cap            : LINE_CAP_BUTT ends square at the end points,
+                     LINE_CAP_ROUND adds a half disc past each
+info:
+    Works in doubled coordinates, pixel (x, y) centred on (2x, 2y). The
+    body is the pixels whose centre projects onto the segment within
+    half the width of it; the side test is half-open so an even width
+    covers exactly Width rows of a horizontal line, and the caps are open
+    discs so they never stick out past that side. Both shapes are convex,
+    so each row is one span of the row's linear bounds.
+******************************************************************************/
+void Paint_DrawThickLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+                         UWORD Width, UWORD Color, LINE_CAP Cap)
+{
+    if (Width == 0 || Paint.winW == 0 || Paint.winH == 0)
+        return;
+    if (Width > PAINT_THICK_LINE_MAX)
+        Width = PAINT_THICK_LINE_MAX;
+
+    int64_t X0 = 2 * (int16_t)Xstart, Y0 = 2 * (int16_t)Ystart;
+    int64_t X1 = 2 * (int16_t)Xend, Y1 = 2 * (int16_t)Yend;
+    int64_t DX = X1 - X0, DY = Y1 - Y0;
+    int64_t L2 = DX * DX + DY * DY;
+    int64_t W = Width, W2 = W * W;  // Half width, doubled
+    if (L2 == 0 && Cap == LINE_CAP_BUTT)
+        return;
+
+    // Side distance times |D| lies in (-W|D|, W|D|]
+    int64_t Reach = Paint_Isqrt(W2 * L2);
+    int64_t ReachNeg = (Reach * Reach == W2 * L2) ? Reach - 1 : Reach;
+
+    int YFirst = (int)Paint_CeilDiv((Y0 < Y1 ? Y0 : Y1) - W, 2);
+    int YLast = (int)Paint_FloorDiv((Y0 > Y1 ? Y0 : Y1) + W, 2);
+    if (YFirst < Paint.winY)
+        YFirst = Paint.winY;
+    if (YLast > Paint.winY + Paint.winH - 1)
+        YLast = Paint.winY + Paint.winH - 1;
+
+    for (int Y = YFirst; Y <= YLast; Y++) {
+        int64_t QY = 2 * Y;
+        int64_t Lo = INT32_MAX, Hi = INT32_MIN;
+
+        if (L2 > 0) {
+            int64_t BLo = INT32_MIN, BHi = INT32_MAX;
+            // Projection (Q - P0) . D in [0, L2]
+            Paint_ClampLinear(2 * DX, (QY - Y0) * DY - X0 * DX, &BLo, &BHi);
+            Paint_ClampLinear(-2 * DX, L2 + X0 * DX - (QY - Y0) * DY, &BLo, &BHi);
+            // Side (Q - P0) x D in [-ReachNeg, Reach]
+            Paint_ClampLinear(-2 * DY, Reach + X0 * DY + (QY - Y0) * DX, &BLo, &BHi);
+            Paint_ClampLinear(2 * DY, ReachNeg - X0 * DY - (QY - Y0) * DX, &BLo, &BHi);
+            if (BLo <= BHi) {
+                Lo = BLo;
+                Hi = BHi;
             }
-            if (Esp < 0 )
-                Esp += 4 * XCurrent + 6;
-            else {
-                Esp += 10 + 4 * (XCurrent - YCurrent );
-                YCurrent --;
+        }
+
+        if (Cap == LINE_CAP_ROUND) {
+            for (int End = 0; End < 2; End++) {
+                int64_t PX = End ? X1 : X0, PY = End ? Y1 : Y0;
+                int64_t RY = QY - PY;
+                if (RY * RY >= W2)
+                    continue;
+                int64_t Half = Paint_Isqrt(W2 - RY * RY - 1);
+                int64_t DLo = Paint_CeilDiv(PX - Half, 2);
+                int64_t DHi = Paint_FloorDiv(PX + Half, 2);
+                if (DLo < Lo) Lo = DLo;
+                if (DHi > Hi) Hi = DHi;
             }
-            XCurrent ++;
         }
-    } else { //Draw a hollow circle
-        while (XCurrent <= YCurrent ) {
-            Paint_DrawPoint(X_Center + XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);//1
-            Paint_DrawPoint(X_Center - XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);//2
-            Paint_DrawPoint(X_Center - YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);//3
-            Paint_DrawPoint(X_Center - YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);//4
-            Paint_DrawPoint(X_Center - XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);//5
-            Paint_DrawPoint(X_Center + XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);//6
-            Paint_DrawPoint(X_Center + YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);//7
-            Paint_DrawPoint(X_Center + YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);//0
-
-            if (Esp < 0 )
-                Esp += 4 * XCurrent + 6;
-            else {
-                Esp += 10 + 4 * (XCurrent - YCurrent );
-                YCurrent --;
+
+        if (Lo <= Hi)
+            Paint_FillSpanRect((int)Lo, Y, (int)Hi, Y, Color);
+    }
+}
+
+#define PAINT_BEZIER_FRAC      24  // Fraction bits of the forward differences
+#define PAINT_BEZIER_STEP_PX   12  // Control polygon length per step
+#define PAINT_BEZIER_MAX_SHIFT 8   // 256 steps; cubic differences stay exact in FRAC bits
+
+/******************************************************************************
+function: Draw a quadratic or cubic Bezier curve
+parameter:
+    xPoints, yPoints : Start, control point(s) and end
+    numPoints        : 3 (quadratic) or 4 (cubic)
+    Color            : Painted color
+info:
+    Steps a power of two, about one per PAINT_BEZIER_STEP_PX of control
+    polygon, and evaluates them by forward differencing in fixed point:
+    adds only, and with h = 2^-k every difference is an exact shift of
+    the polynomial coefficients. The points are joined with
+    Paint_DrawLine.
+******************************************************************************/
+void Paint_DrawBezier(const int16_t* xPoints, const int16_t* yPoints,
+                      UWORD numPoints, UWORD Color)
+{
+    if (numPoints != 3 && numPoints != 4) {
+        Debug("Paint_DrawBezier needs 3 or 4 points\r\n");
+        return;
+    }
+
+    // Control polygon length, max + min / 2 per leg (within 12% of Euclidean)
+    UDOUBLE Length = 0;
+    for (UWORD i = 1; i < numPoints; i++) {
+        UDOUBLE DX = abs(xPoints[i] - xPoints[i - 1]);
+        UDOUBLE DY = abs(yPoints[i] - yPoints[i - 1]);
+        Length += (DX > DY) ? DX + DY / 2 : DY + DX / 2;
+    }
+    int Shift = 0;
+    while (Shift < PAINT_BEZIER_MAX_SHIFT && ((UDOUBLE)PAINT_BEZIER_STEP_PX << Shift) < Length)
+        Shift++;
+
+    // P(t) = P0 + B t + A t^2 + C t^3 and its differences for h = 2^-Shift
+    int64_t Pos[2], D1[2], D2[2], D3[2];
+    for (int Axis = 0; Axis < 2; Axis++) {
+        const int16_t *P = Axis ? yPoints : xPoints;
+        int64_t A, B, C;
+        if (numPoints == 3) {
+            B = 2 * (P[1] - P[0]);
+            A = P[0] - 2 * P[1] + P[2];
+            C = 0;
+        } else {
+            B = 3 * (P[1] - P[0]);
+            A = 3 * (P[0] - 2 * P[1] + P[2]);
+            C = -P[0] + 3 * P[1] - 3 * P[2] + P[3];
+        }
+        int64_t H1 = (int64_t)1 << (PAINT_BEZIER_FRAC - Shift);
+        int64_t H2 = (int64_t)1 << (PAINT_BEZIER_FRAC - 2 * Shift);
+        int64_t H3 = (int64_t)1 << (PAINT_BEZIER_FRAC - 3 * Shift);
+        Pos[Axis] = P[0] * ((int64_t)1 << PAINT_BEZIER_FRAC);
+        D1[Axis] = B * H1 + A * H2 + C * H3;
+        D2[Axis] = 2 * A * H2 + 6 * C * H3;
+        D3[Axis] = 6 * C * H3;
+    }
+
+    const int64_t Half = (int64_t)1 << (PAINT_BEZIER_FRAC - 1);
+    int PrevX = xPoints[0], PrevY = yPoints[0];
+    bool Drawn = false;
+    for (int Step = 1 << Shift; Step > 0; Step--) {
+        for (int Axis = 0; Axis < 2; Axis++) {
+            Pos[Axis] += D1[Axis];
+            D1[Axis] += D2[Axis];
+            D2[Axis] += D3[Axis];
+        }
+        int X = (int)((Pos[0] + Half) >> PAINT_BEZIER_FRAC);
+        int Y = (int)((Pos[1] + Half) >> PAINT_BEZIER_FRAC);
+        if (X == PrevX && Y == PrevY)
+            continue;
+        Paint_DrawLine(PrevX, PrevY, X, Y, Color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+        PrevX = X;
+        PrevY = Y;
+        Drawn = true;
+    }
+    if (!Drawn)
+        Paint_DrawLine(PrevX, PrevY, PrevX, PrevY, Color, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+}
+
+// Bit scans over a 1bpp row. Inv is 0x00 when the colour looked for is
+// white (set bits) and 0xFF when it is black, so Row ^ Inv has a 1 for
+// every pixel of that colour and Row ^ ~Inv for every other pixel.
+static inline int Paint_Clz8(UBYTE b) { return __builtin_clz((unsigned)b) - 24; }
+
+// Last X of the run that starts at X (a pixel of the colour), at most XMax
+static int Paint_RunRight(const UBYTE *Row, int X, int XMax, UBYTE Inv)
+{
+    int Byte = X >> 3;
+    UBYTE Stop = (UBYTE)((Row[Byte] ^ ~Inv) & (0xFF >> (X & 7)));
+    while (!Stop) {
+        if (Byte * 8 + 7 >= XMax)
+            return XMax;
+        Stop = (UBYTE)(Row[++Byte] ^ ~Inv);
+    }
+    int End = Byte * 8 + Paint_Clz8(Stop) - 1;
+    return (End < XMax) ? End : XMax;
+}
+
+// First X of the run that ends at X, at least XMin
+static int Paint_RunLeft(const UBYTE *Row, int X, int XMin, UBYTE Inv)
+{
+    int Byte = X >> 3;
+    UBYTE Stop = (UBYTE)((Row[Byte] ^ ~Inv) & (0xFF << (7 - (X & 7))));
+    while (!Stop) {
+        if (Byte * 8 <= XMin)
+            return XMin;
+        Stop = (UBYTE)(Row[--Byte] ^ ~Inv);
+    }
+    int Start = Byte * 8 + 8 - __builtin_ctz(Stop);
+    return (Start > XMin) ? Start : XMin;
+}
+
+// First X in [X, XMax] of the colour, XMax + 1 if there is none
+static int Paint_NextRun(const UBYTE *Row, int X, int XMax, UBYTE Inv)
+{
+    int Byte = X >> 3;
+    UBYTE Hit = (UBYTE)((Row[Byte] ^ Inv) & (0xFF >> (X & 7)));
+    while (!Hit) {
+        if (Byte * 8 + 7 >= XMax)
+            return XMax + 1;
+        Hit = (UBYTE)(Row[++Byte] ^ Inv);
+    }
+    int Found = Byte * 8 + Paint_Clz8(Hit);
+    return (Found <= XMax) ? Found : XMax + 1;
+}
+
+/******************************************************************************
+function: Flood fill the 4-connected region around a point
+parameter:
+    Xpoint, Ypoint : Seed point
+    Color          : Fill color
+    Stack          : Scratch for pending spans
+    StackSize      : Entries in Stack
+return:
+    false if Stack ran out (the region is then only partly filled) or the
+    image is not 1bpp, true otherwise
+info:
+    Fills the region of the seed's colour inside the drawing window.
+    Rotation and mirroring keep 4-neighbours, so the fill runs on memory
+    rows: each run is found with bit scans a byte at a time and written
+    as one span. Every filled run queues the row beyond it, plus the
+    parts of the row it came from that stick out past its parent, so
+    memory is bounded by StackSize instead of the call stack.
+******************************************************************************/
+bool Paint_FloodFill(UWORD Xpoint, UWORD Ypoint, UWORD Color,
+                     PAINT_FILL_SEED *Stack, UWORD StackSize)
+{
+    if (Paint.Scale != 2) {
+        Debug("Paint_FloodFill only supports 1bpp images\r\n");
+        return false;
+    }
+    if ((UWORD)(Xpoint - Paint.winX) >= Paint.winW ||
+        (UWORD)(Ypoint - Paint.winY) >= Paint.winH)
+        return true;
+
+    // Seed and window in memory coordinates
+    UWORD SX, SY, WX1, WY1, WX2, WY2;
+    if (!Paint_MapToMemory(Xpoint, Ypoint, &SX, &SY) ||
+        !Paint_MapToMemory(Paint.winX, Paint.winY, &WX1, &WY1) ||
+        !Paint_MapToMemory(Paint.winX + Paint.winW - 1, Paint.winY + Paint.winH - 1, &WX2, &WY2))
+        return false;
+    int XMin = (WX1 < WX2) ? WX1 : WX2, XMax = (WX1 < WX2) ? WX2 : WX1;
+    int YMin = (WY1 < WY2) ? WY1 : WY2, YMax = (WY1 < WY2) ? WY2 : WY1;
+
+    bool Target = (Paint.Image[(UDOUBLE)SY * Paint.WidthByte + SX / 8] >> (7 - SX % 8)) & 1;
+    if (Target == (Color != BLACK))
+        return true;  // Already the fill colour
+    UBYTE Inv = Target ? 0x00 : 0xFF;
+
+    UWORD Count = 0;
+    bool Complete = true;
+    auto Push = [&](int X1, int X2, int Y, int Dir) {
+        if (Y < YMin || Y > YMax)
+            return;
+        if (Count == StackSize) {
+            Complete = false;
+            return;
+        }
+        Stack[Count].X1 = X1;
+        Stack[Count].X2 = X2;
+        Stack[Count].Y = Y;
+        Stack[Count].Dir = Dir;
+        Count++;
+    };
+
+    Push(SX, SX, SY, 1);
+    Push(SX, SX, (int)SY - 1, -1);
+    while (Count) {
+        PAINT_FILL_SEED Seed = Stack[--Count];
+        const UBYTE *Row = Paint.Image + (UDOUBLE)Seed.Y * Paint.WidthByte;
+        int Y = Seed.Y, Dir = Seed.Dir;
+        int X = Seed.X1;
+
+        // The first run may reach back left of the parent span
+        if ((Row[X >> 3] ^ Inv) & (0x80 >> (X & 7))) {
+            int Start = Paint_RunLeft(Row, X, XMin, Inv);
+            int End = Paint_RunRight(Row, X, XMax, Inv);
+            Paint_FillMemoryRect(Start, Y, End, Y, Color);
+            Push(Start, End, Y + Dir, Dir);
+            if (Start < Seed.X1)
+                Push(Start, Seed.X1 - 1, Y - Dir, -Dir);
+            if (End > Seed.X2)
+                Push(Seed.X2 + 1, End, Y - Dir, -Dir);
+            X = End + 2;  // End + 1 is a boundary
+        }
+
+        // Further runs that start under the parent span
+        while (X <= Seed.X2) {
+            X = Paint_NextRun(Row, X, Seed.X2, Inv);
+            if (X > Seed.X2)
+                break;
+            int End = Paint_RunRight(Row, X, XMax, Inv);
+            Paint_FillMemoryRect(X, Y, End, Y, Color);
+            Push(X, End, Y + Dir, Dir);
+            if (End > Seed.X2)
+                Push(Seed.X2 + 1, End, Y - Dir, -Dir);
+            X = End + 2;
+        }
+    }
+    return Complete;
+}
+
+#define PAINT_BLIT_MAX_BITS 56  // Longest run Paint_BlitBits can shift into place
+#define PAINT_BLIT_TILE     48  // Tile side for larger glyphs, whole bytes of a glyph row
+
+static inline UBYTE Paint_ReverseByte(UBYTE b)
+{
+    b = (b & 0xF0) >> 4 | (b & 0x0F) << 4;
+    b = (b & 0xCC) >> 2 | (b & 0x33) << 2;
+    return (b & 0xAA) >> 1 | (b & 0x55) << 1;
+}
+
+/******************************************************************************
+function: Write a run of 1bpp pixels into one memory row
+parameter:
+    X0, Y    : Memory coordinates of the first pixel
+    Bits     : Pixels, MSB first, left aligned; bits past Count must be 0
+    Count    : Run length (<= PAINT_BLIT_MAX_BITS)
+    Fill     : Byte pattern for set bits
+    BackFill : Byte pattern for clear bits (opaque only)
+info:
+    The run is shifted to X0's bit offset once and written a byte at a
+    time with a mask, instead of one read-modify-write per pixel.
+******************************************************************************/
+static inline void Paint_BlitBits(UWORD X0, UWORD Y, uint64_t Bits, UBYTE Count,
+                                  UBYTE Fill, UBYTE BackFill, bool Opaque)
+{
+    UBYTE Shift = X0 % 8;
+    uint64_t Mask = (~(uint64_t)0 << (64 - Count)) >> Shift;
+    Bits >>= Shift;
+
+    UBYTE *Byte = Paint.Image + (UDOUBLE)Y * Paint.WidthByte + X0 / 8;
+    for(; Mask; Mask <<= 8, Bits <<= 8, Byte++) {
+        UBYTE M = Mask >> 56;
+        UBYTE G = Bits >> 56;
+        if(Opaque)
+            *Byte = (*Byte & ~M) | (((G & Fill) | (~G & BackFill)) & M);
+        else
+            *Byte = (*Byte & ~G) | (G & Fill);
+    }
+}
+
+/******************************************************************************
+function: Blit one tile of a 1bpp glyph (scale 2, inside the drawing window)
+parameter:
+    Xpoint, Ypoint : Top-left corner of the tile
+    Tile           : First byte of the tile's top row
+    Stride         : Bytes per glyph row
+    Width, Height  : Tile size (<= PAINT_BLIT_MAX_BITS)
+return:
+    OR of the glyph bytes read, 0 when the tile has no set bits
+******************************************************************************/
+static UBYTE Paint_BlitTile(UWORD Xpoint, UWORD Ypoint, const unsigned char *Tile, UWORD Stride,
+                            UWORD Width, UWORD Height, UBYTE Fill, UBYTE BackFill, bool Opaque)
+{
+    UWORD TileBytes = (Width + 7) / 8;
+    bool FlipX = Paint.Transform & PAINT_XFORM_FLIP_X;
+    bool FlipY = Paint.Transform & PAINT_XFORM_FLIP_Y;
+    UBYTE Inked = 0;
+
+    if (!(Paint.Transform & PAINT_XFORM_SWAP)) {
+        // Glyph rows run along memory rows
+        UWORD X0 = FlipX ? Paint.WidthMemory - Xpoint - Width : Xpoint;
+        UBYTE Pad = TileBytes * 8 - Width;
+        for (UWORD Page = 0; Page < Height; Page++) {
+            const unsigned char *Row = Tile + Page * Stride;
+            uint64_t Bits = 0;
+            for (UWORD b = 0; b < TileBytes; b++) {
+                Inked |= Row[b];
+                if (FlipX)
+                    Bits |= (uint64_t)Paint_ReverseByte(Row[b]) << (56 - 8 * (TileBytes - 1 - b));
+                else
+                    Bits |= (uint64_t)Row[b] << (56 - 8 * b);
+            }
+            // Drop the bits past the tile, which sit at the far end of the run
+            if (FlipX)
+                Bits <<= Pad;
+            else
+                Bits &= ~(uint64_t)0 << (64 - Width);
+            UWORD Y = FlipY ? Paint.HeightMemory - 1 - (Ypoint + Page) : Ypoint + Page;
+            Paint_BlitBits(X0, Y, Bits, Width, Fill, BackFill, Opaque);
+        }
+    } else {
+        // Glyph columns run along memory rows: transpose the set bits
+        uint64_t Columns[PAINT_BLIT_MAX_BITS] = {0};
+        for (UWORD Page = 0; Page < Height; Page++) {
+            const unsigned char *Row = Tile + Page * Stride;
+            uint64_t Bit = (uint64_t)1 << (63 - (FlipX ? Height - 1 - Page : Page));
+            for (UWORD b = 0; b < TileBytes; b++) {
+                UBYTE v = Row[b];
+                Inked |= v;
+                for (UBYTE k = 0; v; k++, v <<= 1) {
+                    if ((v & 0x80) && b * 8 + k < Width)
+                        Columns[b * 8 + k] |= Bit;
+                }
             }
-            XCurrent ++;
+        }
+        UWORD X0 = FlipX ? Paint.WidthMemory - Ypoint - Height : Ypoint;
+        for (UWORD Column = 0; Column < Width; Column++) {
+            UWORD Y = FlipY ? Paint.HeightMemory - 1 - (Xpoint + Column) : Xpoint + Column;
+            Paint_BlitBits(X0, Y, Columns[Column], Height, Fill, BackFill, Opaque);
         }
     }
+    return Inked;
+}
+
+/******************************************************************************
+function: Draw a 1bpp glyph or sprite
+parameter:
+    Xpoint, Ypoint   : Top-left corner
+    Glyph            : Rows of ceil(Width / 8) bytes, MSB first (sFONT layout)
+    Width, Height    : Glyph size in pixels
+    Color_Foreground : Color of set bits
+    Color_Background : Color of clear bits, FONT_BACKGROUND leaves them alone
+info:
+    At scale 2, with the glyph fully inside the drawing window, it is
+    blitted in tiles of up to PAINT_BLIT_TILE pixels a side with
+    Paint_BlitBits. For 0/180 a tile row is one memory row; for 90/270 the
+    tile is transposed so each glyph column becomes one memory row.
+    Anything else goes pixel by pixel.
+******************************************************************************/
+void Paint_BlitGlyph(UWORD Xpoint, UWORD Ypoint, const unsigned char *Glyph, UWORD Width, UWORD Height,
+                     UWORD Color_Foreground, UWORD Color_Background)
+{
+    UWORD RowBytes = (Width + 7) / 8;
+    bool Opaque = (Color_Background != FONT_BACKGROUND);
+
+    if (Paint.Scale != 2 || Width == 0 || Height == 0 ||
+        Xpoint < Paint.winX || (UDOUBLE)Xpoint + Width > (UDOUBLE)Paint.winX + Paint.winW ||
+        Ypoint < Paint.winY || (UDOUBLE)Ypoint + Height > (UDOUBLE)Paint.winY + Paint.winH) {
+        const unsigned char *ptr = Glyph;
+        for (UWORD Page = 0; Page < Height; Page ++ ) {
+            for (UWORD Column = 0; Column < Width; Column ++ ) {
+                if (ptr[Column / 8] & (0x80 >> (Column % 8)))
+                    Paint_Plot(Xpoint + Column, Ypoint + Page, Color_Foreground);
+                else if (Opaque)
+                    Paint_Plot(Xpoint + Column, Ypoint + Page, Color_Background);
+            }
+            ptr += RowBytes;
+        }
+        return;
+    }
+
+    UBYTE Fill = (Color_Foreground == BLACK) ? 0x00 : 0xFF;
+    UBYTE BackFill = (Color_Background == BLACK) ? 0x00 : 0xFF;
+    UBYTE Inked = 0;
+
+    // Font glyphs fit one tile; bigger sprites are cut on glyph row bytes
+    UWORD Side = (Width <= PAINT_BLIT_MAX_BITS && Height <= PAINT_BLIT_MAX_BITS) ?
+                 PAINT_BLIT_MAX_BITS : PAINT_BLIT_TILE;
+    for (UWORD Ty = 0; Ty < Height; Ty += Side) {
+        UWORD TileH = (Height - Ty < Side) ? Height - Ty : Side;
+        for (UWORD Tx = 0; Tx < Width; Tx += Side) {
+            UWORD TileW = (Width - Tx < Side) ? Width - Tx : Side;
+            Inked |= Paint_BlitTile(Xpoint + Tx, Ypoint + Ty, Glyph + Ty * RowBytes + Tx / 8, RowBytes,
+                                    TileW, TileH, Fill, BackFill, Opaque);
+        }
+    }
+
+    if (Paint.dirtyEnabled && (Opaque || Inked)) {
+        UWORD X1, Y1, X2, Y2;
+        if (!Paint_MapToMemory(Xpoint, Ypoint, &X1, &Y1) ||
+            !Paint_MapToMemory(Xpoint + Width - 1, Ypoint + Height - 1, &X2, &Y2))
+            return;
+        if (X1 > X2) { UWORD T = X1; X1 = X2; X2 = T; }
+        if (Y1 > Y2) { UWORD T = Y1; Y1 = Y2; Y2 = T; }
+        Paint_MarkDirty(X1, Y1, X2, Y2);
+    }
+}
+
+/******************************************************************************
+function: Rasterize a drawing once into a 1bpp sprite
+parameter:
+    Sprite        : Output, Height rows of ceil(Width / 8) bytes
+    Width, Height : Sprite size in pixels
+    Draw          : Paints the element in BLACK, origin at the sprite's corner
+    Context       : Passed to Draw
+info:
+    Draw runs against a white, unrotated canvas over Sprite; the Paint
+    state (image, rotation, clip, dirty rects) is restored afterwards.
+    The result has set bits where Draw inked, ready for Paint_BlitGlyph.
+******************************************************************************/
+void Paint_CaptureSprite(UBYTE *Sprite, UWORD Width, UWORD Height,
+                         void (*Draw)(void *Context), void *Context)
+{
+    PAINT Saved = Paint;
+
+    Paint_NewImage(Sprite, Width, Height, ROTATE_0, WHITE);
+    Paint.dirtyEnabled = false;
+    Paint_Clear(WHITE);
+    Draw(Context);
+
+    UDOUBLE Bytes = (UDOUBLE)Paint.WidthByte * Height;
+    for (UDOUBLE i = 0; i < Bytes; i++)
+        Sprite[i] = ~Sprite[i];
+
+    Paint = Saved;
 }
 
 /******************************************************************************
@@ -532,40 +1704,14 @@ parameter:
 void Paint_DrawChar(UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
                     sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
 {
-    UWORD Page, Column;
-
     if (Xpoint > Paint.Width || Ypoint > Paint.Height) {
         Debug("Paint_DrawChar Input exceeds the normal display range\r\n");
         return;
     }
 
     uint32_t Char_Offset = (Acsii_Char - ' ') * Font->Height * (Font->Width / 8 + (Font->Width % 8 ? 1 : 0));
-    const unsigned char *ptr = &Font->table[Char_Offset];
-
-    for (Page = 0; Page < Font->Height; Page ++ ) {
-        for (Column = 0; Column < Font->Width; Column ++ ) {
-
-            //To determine whether the font background color and screen background color is consistent
-            if (FONT_BACKGROUND == Color_Background) { //this process is to speed up the scan
-                if (*ptr & (0x80 >> (Column % 8)))
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Foreground);
-                    // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-            } else {
-                if (*ptr & (0x80 >> (Column % 8))) {
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Foreground);
-                    // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                } else {
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Background);
-                    // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Background, DOT_PIXEL_DFT, DOT_STYLE_DFT);
-                }
-            }
-            //One pixel is 8 bits
-            if (Column % 8 == 7)
-                ptr++;
-        }// Write a line
-        if (Font->Width % 8 != 0)
-            ptr++;
-    }// Write all
+    Paint_BlitGlyph(Xpoint, Ypoint, &Font->table[Char_Offset], Font->Width, Font->Height,
+                    Color_Foreground, Color_Background);
 }
 
 /******************************************************************************
@@ -694,6 +1840,9 @@ void Paint_DrawBitMap(const unsigned char* image_buffer)
     UWORD x, y;
     UDOUBLE Addr = 0;
 
+    if(Paint.dirtyEnabled)
+        Paint_MarkDirty(0, 0, Paint.WidthMemory - 1, Paint.HeightMemory - 1);
+
     for (y = 0; y < Paint.HeightByte; y++) {
         for (x = 0; x < Paint.WidthByte; x++) {//8 pixel =  1 byte
             Addr = x + y * Paint.WidthByte;
@@ -717,6 +1866,8 @@ void Paint_DrawImage(const unsigned char *image_buffer, UWORD xStart, UWORD ySta
 	UWORD w_byte=(W_Image%8)?(W_Image/8)+1:W_Image/8;
     UDOUBLE Addr = 0;
 	UDOUBLE pAddr = 0;
+    if(Paint.dirtyEnabled && W_Image > 0 && H_Image > 0)
+        Paint_MarkDirty((xStart / 8) * 8, yStart, (xStart / 8 + w_byte) * 8 - 1, yStart + H_Image - 1);
     for (y = 0; y < H_Image; y++) {
         for (x = 0; x < w_byte; x++) {//8 pixel =  1 byte
             Addr = x + y * w_byte;
@@ -738,72 +1889,6 @@ void Paint_DrawImage(const unsigned char *image_buffer, UWORD xStart, UWORD ySta
  * Date: 2024-11-20
  ******************************************************************************/
 
-// Internal edge structure for scanline algorithm
-typedef struct {
-    int16_t yMin, yMax;
-    float xAtYMin;
-    float slopeInverse;  // dx/dy
-} PolygonEdge;
-
-// Internal helper: Build edge table from polygon vertices
-static int buildEdgeTable(const int16_t* xPoints, const int16_t* yPoints, 
-                          UWORD numPoints, PolygonEdge* edges) {
-    int edgeCount = 0;
-    
-    for (UWORD i = 0; i < numPoints; i++) {
-        UWORD next = (i + 1) % numPoints;
-        
-        int16_t x1 = xPoints[i];
-        int16_t y1 = yPoints[i];
-        int16_t x2 = xPoints[next];
-        int16_t y2 = yPoints[next];
-        
-        // Skip horizontal edges
-        if (y1 == y2) continue;
-        
-        // Ensure y1 < y2
-        if (y1 > y2) {
-            int16_t temp;
-            temp = x1; x1 = x2; x2 = temp;
-            temp = y1; y1 = y2; y2 = temp;
-        }
-        
-        edges[edgeCount].yMin = y1;
-        edges[edgeCount].yMax = y2;
-        edges[edgeCount].xAtYMin = (float)x1;
-        edges[edgeCount].slopeInverse = (float)(x2 - x1) / (float)(y2 - y1);
-        edgeCount++;
-    }
-    
-    return edgeCount;
-}
-
-// Internal helper: Fill scanline between edge intersections
-static void fillScanline(int16_t y, float* xIntersections, int count, UWORD Color) {
-    // Sort intersections
-    for (int i = 0; i < count - 1; i++) {
-        for (int j = i + 1; j < count; j++) {
-            if (xIntersections[i] > xIntersections[j]) {
-                float temp = xIntersections[i];
-                xIntersections[i] = xIntersections[j];
-                xIntersections[j] = temp;
-            }
-        }
-    }
-    
-    // Fill between pairs
-    for (int i = 0; i < count; i += 2) {
-        if (i + 1 < count) {
-            int16_t xStart = (int16_t)(xIntersections[i] + 0.5f);
-            int16_t xEnd = (int16_t)(xIntersections[i + 1] + 0.5f);
-            
-            for (int16_t x = xStart; x <= xEnd; x++) {
-                Paint_SetPixel(x, y, Color);
-            }
-        }
-    }
-}
-
 /******************************************************************************
 function: Calculate bounding box of polygon (for partial refresh region)
 parameter:
@@ -833,6 +1918,128 @@ void Paint_GetPolygonBounds(const int16_t* xPoints, const int16_t* yPoints,
     *maxY = (UWORD)yMax;
 }
 
+/******************************************************************************
+function: Fill a polygon with an active edge table
+parameter:
+    xPoints, yPoints : Vertices (closed implicitly, any count, may be concave
+                       or self-intersecting)
+    numPoints        : Number of vertices
+    Color            : Fill color
+    Rule             : FILL_RULE_EVEN_ODD or FILL_RULE_NONZERO
+    Scratch          : Edge storage, at least numPoints entries
+    ScratchEdges     : Size of Scratch
+info:
+    Edges are sorted by top Y once and stepped in 16.16 fixed point.
+    Each scanline (sampled at integer y) keeps only the edges that cross
+    it, re-sorted by X with an insertion sort (they barely move between
+    lines), and emits one span per inside run into the span filler.
+******************************************************************************/
+void Paint_FillPolygon(const int16_t* xPoints, const int16_t* yPoints,
+                       UWORD numPoints, UWORD Color, FILL_RULE Rule,
+                       PAINT_EDGE* Scratch, UWORD ScratchEdges)
+{
+    if (numPoints < 3 || Scratch == NULL || ScratchEdges < numPoints) {
+        Debug("Paint_FillPolygon: need 3+ points and one scratch edge per point\r\n");
+        return;
+    }
+
+    // Edge table, horizontal edges dropped, sorted by YMin
+    UWORD n = 0;
+    for (UWORD i = 0; i < numPoints; i++) {
+        UWORD next = (i + 1 == numPoints) ? 0 : i + 1;
+        int16_t x1 = xPoints[i], y1 = yPoints[i];
+        int16_t x2 = xPoints[next], y2 = yPoints[next];
+        if (y1 == y2) continue;
+
+        PAINT_EDGE e;
+        e.Dir = (y1 < y2) ? 1 : -1;
+        if (y1 > y2) {
+            int16_t t;
+            t = x1; x1 = x2; x2 = t;
+            t = y1; y1 = y2; y2 = t;
+        }
+        e.YMin = y1;
+        e.YMax = y2;
+        e.X = (int32_t)x1 << 16;
+        // Round the step up so exact .5 crossings round like float did
+        int32_t Run = (int32_t)(x2 - x1) << 16;
+        e.DX = (Run > 0) ? (Run + (y2 - y1) - 1) / (y2 - y1) : Run / (y2 - y1);
+
+        UWORD j = n++;
+        while (j > 0 && Scratch[j - 1].YMin > e.YMin) {
+            Scratch[j] = Scratch[j - 1];
+            j--;
+        }
+        Scratch[j] = e;
+    }
+    if (n == 0) return;
+
+    // Scratch[first, last) is the active edge list, Scratch[last, n) is
+    // still waiting; retired edges are swapped below first
+    UWORD first = 0, last = 0;
+    int32_t y = Scratch[0].YMin;
+    if (y < Paint.winY) y = Paint.winY;
+    int32_t yEnd = (int32_t)Paint.winY + Paint.winH;
+
+    for (; y < yEnd && first < n; y++) {
+        // Activate edges reaching this line (stepped down to it when the
+        // polygon starts above the drawing window)
+        while (last < n && Scratch[last].YMin <= y) {
+            PAINT_EDGE *e = &Scratch[last];
+            e->X += (int32_t)((int64_t)(y - e->YMin) * e->DX);
+            last++;
+        }
+
+        // Retire edges that ended above this line
+        for (UWORD i = first; i < last; i++) {
+            if (Scratch[i].YMax <= y) {
+                PAINT_EDGE t = Scratch[i];
+                Scratch[i] = Scratch[first];
+                Scratch[first++] = t;
+            }
+        }
+        if (first == last) {
+            // Gap between parts: jump to the next edge
+            if (last < n && Scratch[last].YMin > y + 1)
+                y = Scratch[last].YMin - 1;
+            continue;
+        }
+
+        // Keep the active list sorted by X
+        for (UWORD i = first + 1; i < last; i++) {
+            PAINT_EDGE t = Scratch[i];
+            UWORD j = i;
+            while (j > first && Scratch[j - 1].X > t.X) {
+                Scratch[j] = Scratch[j - 1];
+                j--;
+            }
+            Scratch[j] = t;
+        }
+
+        // Inside runs become spans, pixel centres rounded like before
+        int Winding = 0;
+        int32_t SpanStart = 0;
+        for (UWORD i = first; i < last; i++) {
+            bool WasInside = (Rule == FILL_RULE_NONZERO) ? Winding != 0 : (Winding & 1);
+            Winding += (Rule == FILL_RULE_NONZERO) ? Scratch[i].Dir : 1;
+            bool Inside = (Rule == FILL_RULE_NONZERO) ? Winding != 0 : (Winding & 1);
+            if (!WasInside && Inside) {
+                SpanStart = Scratch[i].X;
+            } else if (WasInside && !Inside) {
+                Paint_FillSpanRect((SpanStart + 0x8000) >> 16, y,
+                                   (Scratch[i].X + 0x8000) >> 16, y, Color);
+            }
+        }
+
+        for (UWORD i = first; i < last; i++)
+            Scratch[i].X += Scratch[i].DX;
+    }
+}
+
+// Paint_DrawPolygon edge table beyond PAINT_POLYGON_STACK_EDGES
+static PAINT_EDGE *Paint_PolygonEdges = NULL;
+static UWORD Paint_PolygonEdgeCount = 0;
+
 /******************************************************************************
 function: Draw filled or outline polygon
 parameter:
@@ -862,39 +2069,26 @@ void Paint_DrawPolygon(const int16_t* xPoints, const int16_t* yPoints,
         return;
     }
     
-    // Filled mode: scanline algorithm
-    // Allocate edge table (max numPoints edges, minus horizontal)
-    PolygonEdge edges[16];  // Support up to 16 vertices
-    if (numPoints > 16) {
-        Debug("Paint_DrawPolygon: Max 16 vertices supported\r\n");
-        return;
-    }
-    
-    int edgeCount = buildEdgeTable(xPoints, yPoints, numPoints, edges);
-    if (edgeCount == 0) return;
-    
-    // Find Y range
-    UWORD minX, minY, maxX, maxY;
-    Paint_GetPolygonBounds(xPoints, yPoints, numPoints, &minX, &minY, &maxX, &maxY);
-    
-    // Scanline fill
-    float xIntersections[16];
-    
-    for (int16_t y = minY; y <= maxY; y++) {
-        int intersectionCount = 0;
-        
-        // Find active edges at this Y
-        for (int i = 0; i < edgeCount; i++) {
-            if (y >= edges[i].yMin && y < edges[i].yMax) {
-                xIntersections[intersectionCount++] = edges[i].xAtYMin + 
-                    (y - edges[i].yMin) * edges[i].slopeInverse;
+    // Filled mode: edge scratch on the stack, a kept heap table for big
+    // polygons (grown to the largest one drawn, never freed per call)
+    PAINT_EDGE stackEdges[PAINT_POLYGON_STACK_EDGES];
+    PAINT_EDGE *edges = stackEdges;
+    if (numPoints > PAINT_POLYGON_STACK_EDGES) {
+        if (numPoints > Paint_PolygonEdgeCount) {
+            PAINT_EDGE *Grown = (PAINT_EDGE *)realloc(Paint_PolygonEdges,
+                                                      numPoints * sizeof(PAINT_EDGE));
+            if (Grown == NULL) {
+                Debug("Paint_DrawPolygon: no memory for the edge table\r\n");
+                return;
             }
+            Paint_PolygonEdges = Grown;
+            Paint_PolygonEdgeCount = numPoints;
         }
-        
-        if (intersectionCount >= 2) {
-            fillScanline(y, xIntersections, intersectionCount, Color);
-        }
+        edges = Paint_PolygonEdges;
     }
+
+    Paint_FillPolygon(xPoints, yPoints, numPoints, Color, FILL_RULE_EVEN_ODD,
+                      edges, numPoints);
 }
 
 /******************************************************************************
@@ -1035,6 +2229,7 @@ void Paint_SetClipRegion(UWORD x1, UWORD y1, UWORD x2, UWORD y2) {
     Paint.clipY1 = y1;
     Paint.clipX2 = x2;
     Paint.clipY2 = y2;
+    Paint_SelectWriter();
 }
 
 /******************************************************************************
@@ -1042,6 +2237,141 @@ function: Clear clipping region (restore full screen drawing)
 ******************************************************************************/
 void Paint_ClearClipRegion(void) {
     Paint.clippingEnabled = false;
+    Paint_SelectWriter();
+}
+
+/******************************************************************************
+function: Enable or disable dirty rectangle tracking
+parameter:
+    enable : true to record touched areas (clears the current list)
+info:
+    Rects are kept in memory coordinates so they map straight onto the
+    panel RAM, whatever the rotation/mirroring of the drawing calls.
+******************************************************************************/
+void Paint_SetDirtyTracking(bool enable) {
+    Paint.dirtyEnabled = enable;
+    Paint.dirtyCount = 0;
+    Paint.dirtyLast = 0;
+}
+
+// Rects within PAINT_DIRTY_MERGE_GAP of each other count as touching
+static bool dirtyNear(const PAINT_RECT *a, const PAINT_RECT *b) {
+    return a->X1 <= b->X2 + PAINT_DIRTY_MERGE_GAP && b->X1 <= a->X2 + PAINT_DIRTY_MERGE_GAP &&
+           a->Y1 <= b->Y2 + PAINT_DIRTY_MERGE_GAP && b->Y1 <= a->Y2 + PAINT_DIRTY_MERGE_GAP;
+}
+
+static void dirtyUnion(PAINT_RECT *a, const PAINT_RECT *b) {
+    if(b->X1 < a->X1) a->X1 = b->X1;
+    if(b->Y1 < a->Y1) a->Y1 = b->Y1;
+    if(b->X2 > a->X2) a->X2 = b->X2;
+    if(b->Y2 > a->Y2) a->Y2 = b->Y2;
+}
+
+static UDOUBLE dirtyArea(const PAINT_RECT *r) {
+    return (UDOUBLE)(r->X2 - r->X1 + 1) * (r->Y2 - r->Y1 + 1);
+}
+
+static void dirtyRemove(UBYTE i) {
+    Paint.dirty[i] = Paint.dirty[--Paint.dirtyCount];
+    if(Paint.dirtyLast == Paint.dirtyCount) Paint.dirtyLast = i;
+}
+
+/******************************************************************************
+function: Record an area of the image as modified
+parameter:
+    X1, Y1, X2, Y2 : Memory coordinates, inclusive
+info:
+    Grows a nearby rect when there is one, otherwise starts a new one.
+    When the list is full the new area is merged into the rect whose
+    area grows least.
+******************************************************************************/
+void Paint_MarkDirty(UWORD X1, UWORD Y1, UWORD X2, UWORD Y2) {
+    if(!Paint.dirtyEnabled) return;
+    if(X2 >= Paint.WidthMemory) X2 = Paint.WidthMemory - 1;
+    if(Y2 >= Paint.HeightMemory) Y2 = Paint.HeightMemory - 1;
+    if(X1 > X2 || Y1 > Y2) return;
+
+    PAINT_RECT add = {X1, Y1, X2, Y2};
+    UBYTE target = PAINT_MAX_DIRTY;
+
+    if(Paint.dirtyCount > 0 && dirtyNear(&Paint.dirty[Paint.dirtyLast], &add)) {
+        target = Paint.dirtyLast;
+    } else {
+        for(UBYTE i = 0; i < Paint.dirtyCount; i++) {
+            if(dirtyNear(&Paint.dirty[i], &add)) {
+                target = i;
+                break;
+            }
+        }
+    }
+
+    if(target == PAINT_MAX_DIRTY) {
+        if(Paint.dirtyCount < PAINT_MAX_DIRTY) {
+            Paint.dirtyLast = Paint.dirtyCount;
+            Paint.dirty[Paint.dirtyCount++] = add;
+            return;
+        }
+        // Full: pick the cheapest merge
+        UDOUBLE bestGrowth = 0xFFFFFFFF;
+        for(UBYTE i = 0; i < Paint.dirtyCount; i++) {
+            PAINT_RECT merged = Paint.dirty[i];
+            dirtyUnion(&merged, &add);
+            UDOUBLE growth = dirtyArea(&merged) - dirtyArea(&Paint.dirty[i]);
+            if(growth < bestGrowth) {
+                bestGrowth = growth;
+                target = i;
+            }
+        }
+    }
+
+    dirtyUnion(&Paint.dirty[target], &add);
+    Paint.dirtyLast = target;
+
+    // The grown rect may now reach its neighbours
+    for(UBYTE i = 0; i < Paint.dirtyCount; ) {
+        if(i != Paint.dirtyLast && dirtyNear(&Paint.dirty[i], &Paint.dirty[Paint.dirtyLast])) {
+            dirtyUnion(&Paint.dirty[Paint.dirtyLast], &Paint.dirty[i]);
+            dirtyRemove(i);
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+}
+
+/******************************************************************************
+function: Get the dirty rectangles recorded since the last Paint_ClearDirty
+parameter:
+    rects : Receives a pointer to the list (memory coordinates)
+******************************************************************************/
+UBYTE Paint_GetDirtyRects(const PAINT_RECT **rects) {
+    if(rects) *rects = Paint.dirty;
+    return Paint.dirtyCount;
+}
+
+void Paint_ClearDirty(void) {
+    Paint.dirtyCount = 0;
+    Paint.dirtyLast = 0;
+}
+
+/******************************************************************************
+function: Get the fill work done since the last Paint_ResetSpanStats
+parameter:
+    NarrowRows : Receives the rows written by fills one byte wide in memory
+    FlatPixels : Receives the pixels of fills within one 8-row band
+info:
+    A narrow fill costs a read-modify-write per row. Turned by 90 degrees
+    the flat fills would cost one per pixel instead, so the two counts say
+    what drawing on the same image rotated would have cost.
+******************************************************************************/
+void Paint_GetSpanStats(UDOUBLE *NarrowRows, UDOUBLE *FlatPixels) {
+    if(NarrowRows) *NarrowRows = Paint.narrowRows;
+    if(FlatPixels) *FlatPixels = Paint.flatPixels;
+}
+
+void Paint_ResetSpanStats(void) {
+    Paint.narrowRows = 0;
+    Paint.flatPixels = 0;
 }
 
 /******************************************************************************
@@ -1055,24 +2385,8 @@ info:
     Uses direct memory manipulation for efficiency
 ******************************************************************************/
 void Paint_DrawHLine(UWORD x, UWORD y, UWORD w, UWORD Color) {
-    if(y >= Paint.Height || x >= Paint.Width) return;
-    
-    // Clip width
-    if(x + w > Paint.Width) {
-        w = Paint.Width - x;
-    }
-    
-    // For black/white mode, optimize byte-wise operations
-    if(Paint.Scale == 2) {
-        for(UWORD i = 0; i < w; i++) {
-            Paint_SetPixel(x + i, y, Color);
-        }
-    } else {
-        // For grayscale, still use pixel-by-pixel
-        for(UWORD i = 0; i < w; i++) {
-            Paint_SetPixel(x + i, y, Color);
-        }
-    }
+    if(w == 0) return;
+    Paint_FillSpanRect(x, y, (int)x + w - 1, y, Color);
 }
 
 /******************************************************************************
@@ -1085,16 +2399,8 @@ info:
     Much faster than calling Paint_DrawLine for vertical lines
 ******************************************************************************/
 void Paint_DrawVLine(UWORD x, UWORD y, UWORD h, UWORD Color) {
-    if(x >= Paint.Width || y >= Paint.Height) return;
-    
-    // Clip height
-    if(y + h > Paint.Height) {
-        h = Paint.Height - y;
-    }
-    
-    for(UWORD i = 0; i < h; i++) {
-        Paint_SetPixel(x, y + i, Color);
-    }
+    if(h == 0) return;
+    Paint_FillSpanRect(x, y, x, (int)y + h - 1, Color);
 }
 
 /******************************************************************************
@@ -1108,16 +2414,8 @@ info:
     Uses direct memory operations for speed
 ******************************************************************************/
 void Paint_FillRect(UWORD x, UWORD y, UWORD w, UWORD h, UWORD Color) {
-    if(x >= Paint.Width || y >= Paint.Height) return;
-    
-    // Clip to screen bounds
-    if(x + w > Paint.Width) w = Paint.Width - x;
-    if(y + h > Paint.Height) h = Paint.Height - y;
-    
-    // Use optimized horizontal line drawing
-    for(UWORD row = 0; row < h; row++) {
-        Paint_DrawHLine(x, y + row, w, Color);
-    }
+    if(w == 0 || h == 0) return;
+    Paint_FillSpanRect(x, y, (int)x + w - 1, (int)y + h - 1, Color);
 }
 
 // ============================================================================
@@ -82,6 +82,29 @@
 #include "DEV_Config.h"
 #include "fonts.h"
 
+/**
+ * Dirty rectangle, in memory (unrotated) pixel coordinates, inclusive
+**/
+typedef struct {
+    UWORD X1, Y1, X2, Y2;
+} PAINT_RECT;
+
+#define PAINT_MAX_DIRTY        8   // Rects kept before merging the closest pair
+#define PAINT_DIRTY_MERGE_GAP  8   // Rects closer than this (pixels) are merged
+
+/**
+ * Logical to memory transform: optional X/Y swap, then optional flips
+**/
+#define PAINT_XFORM_FLIP_Y  0x01
+#define PAINT_XFORM_FLIP_X  0x02
+#define PAINT_XFORM_SWAP    0x04
+
+/**
+ * Pixel writer for one rotation/mirror/scale combination. Takes logical
+ * coordinates already known to be inside the drawing window.
+**/
+typedef void (*PAINT_WRITER)(UWORD Xpoint, UWORD Ypoint, UWORD Color);
+
 /**
  * Image attributes
 **/
@@ -100,6 +123,18 @@ typedef struct {
     // Optimization: Pre-computed values
     bool clippingEnabled;
     UWORD clipX1, clipY1, clipX2, clipY2;
+    // Dirty rectangle tracking (see Paint_SetDirtyTracking)
+    bool dirtyEnabled;
+    UBYTE dirtyCount;
+    UBYTE dirtyLast;               // Rect touched last, checked first
+    PAINT_RECT dirty[PAINT_MAX_DIRTY];
+    // Fill work (see Paint_GetSpanStats)
+    UDOUBLE narrowRows;            // Rows of fills one byte wide in memory
+    UDOUBLE flatPixels;            // Pixels of fills within one 8-row band
+    // Selected on NewImage/SetRotate/SetMirroring/SetScale/clip changes
+    PAINT_WRITER Writer;
+    UBYTE Transform;               // PAINT_XFORM_* flags, logical -> memory
+    UWORD winX, winY, winW, winH;  // Drawable logical window (image and clip)
 } PAINT;
 extern PAINT Paint;
 
@@ -170,6 +205,14 @@ typedef enum {
     LINE_STYLE_DOTTED,
 } LINE_STYLE;
 
+/**
+ * End cap of a thick line
+**/
+typedef enum {
+    LINE_CAP_BUTT = 0,          // Square, flush with the end points
+    LINE_CAP_ROUND,             // Half disc past the end points
+} LINE_CAP;
+
 /**
  * Whether the graphic is filled
 **/
@@ -178,6 +221,37 @@ typedef enum {
     DRAW_FILL_FULL,
 } DRAW_FILL;
 
+/**
+ * Polygon fill rule
+**/
+typedef enum {
+    FILL_RULE_EVEN_ODD = 0,     // Inside where an odd number of edges lie to the left
+    FILL_RULE_NONZERO,          // Inside where edge directions don't cancel out
+} FILL_RULE;
+
+/**
+ * Polygon rasterizer edge (scratch for Paint_FillPolygon), X in 16.16
+**/
+typedef struct {
+    int32_t X;
+    int32_t DX;                 // X step per scanline
+    int16_t YMin, YMax;         // Active for YMin <= y < YMax
+    int8_t Dir;                 // +1 downward edge, -1 upward
+} PAINT_EDGE;
+
+#define PAINT_POLYGON_STACK_EDGES 32  // Paint_DrawPolygon grows a kept heap table beyond this
+
+#define PAINT_ANGLE_FRAC_BITS 8  // Paint_Sin/Paint_Cos angles are in 1/256 degree
+
+/**
+ * Pending span of Paint_FloodFill, in memory coordinates
+**/
+typedef struct {
+    UWORD X1, X2;               // Span of the row it was found from
+    UWORD Y;                    // Row to scan
+    int8_t Dir;                 // Row step away from that row, +1 or -1
+} PAINT_FILL_SEED;
+
 /**
  * Custom structure of a time attribute
 **/
@@ -211,6 +285,18 @@ UWORD Paint_GetBufferSize(void);                                 // Get buffer s
 void Paint_SetClipRegion(UWORD x1, UWORD y1, UWORD x2, UWORD y2);
 void Paint_ClearClipRegion(void);
 
+// Dirty rectangle tracking: every write to the image records the area it
+// touched, in memory coordinates, so the caller can refresh just that
+void Paint_SetDirtyTracking(bool enable);
+void Paint_MarkDirty(UWORD X1, UWORD Y1, UWORD X2, UWORD Y2);   // Memory coords, inclusive
+UBYTE Paint_GetDirtyRects(const PAINT_RECT **rects);           // Returns the count
+void Paint_ClearDirty(void);
+
+// Fill work since the last reset: rows of single-byte-wide fills (column
+// walks) and pixels of fills under one byte tall (column walks once rotated)
+void Paint_GetSpanStats(UDOUBLE *NarrowRows, UDOUBLE *FlatPixels);
+void Paint_ResetSpanStats(void);
+
 void Paint_Clear(UWORD Color);
 void Paint_ClearWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color);
 
@@ -224,9 +310,23 @@ void Paint_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color, DOT_PIXEL Dot_Pixe
 void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style);
 void Paint_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
 void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
+void Paint_DrawEllipse(UWORD X_Center, UWORD Y_Center, UWORD Radius_X, UWORD Radius_Y, UWORD Color, DRAW_FILL Draw_Fill);
+void Paint_DrawRoundRect(int16_t Xstart, int16_t Ystart, int16_t Xend, int16_t Yend, UWORD Radius, UWORD Color, DRAW_FILL Draw_Fill);
+void Paint_DrawArc(UWORD X_Center, UWORD Y_Center, UWORD Radius, int16_t Start_Angle, int16_t End_Angle, UWORD Color);
+void Paint_DrawThickLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Width, UWORD Color, LINE_CAP Cap);
+void Paint_DrawBezier(const int16_t* xPoints, const int16_t* yPoints, UWORD numPoints, UWORD Color);
+bool Paint_FloodFill(UWORD Xpoint, UWORD Ypoint, UWORD Color, PAINT_FILL_SEED* Stack, UWORD StackSize);
+
+// Q15 sine/cosine from the table the arcs use, no floating point
+int32_t Paint_Sin(int32_t Angle);
+int32_t Paint_Cos(int32_t Angle);
 
 //Display string
 void Paint_DrawChar(UWORD Xstart, UWORD Ystart, const char Acsii_Char, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+void Paint_BlitGlyph(UWORD Xpoint, UWORD Ypoint, const unsigned char *Glyph, UWORD Width, UWORD Height,
+                     UWORD Color_Foreground, UWORD Color_Background);
+void Paint_CaptureSprite(UBYTE *Sprite, UWORD Width, UWORD Height,
+                         void (*Draw)(void *Context), void *Context);
 void Paint_DrawString_EN(UWORD Xstart, UWORD Ystart, const char * pString, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
 void Paint_DrawNum(UWORD Xpoint, UWORD Ypoint, int32_t Nummber, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
 void Paint_DrawTime(UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
@@ -244,6 +344,10 @@ void Paint_DrawPolygon(const int16_t* xPoints, const int16_t* yPoints,
                        UWORD numPoints, UWORD Color, 
                        DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
 
+void Paint_FillPolygon(const int16_t* xPoints, const int16_t* yPoints,
+                       UWORD numPoints, UWORD Color, FILL_RULE Rule,
+                       PAINT_EDGE* Scratch, UWORD ScratchEdges);
+
 void Paint_GetPolygonBounds(const int16_t* xPoints, const int16_t* yPoints,
                             UWORD numPoints, UWORD* minX, UWORD* minY,
                             UWORD* maxX, UWORD* maxY);
@@ -108,6 +108,47 @@ static void EPD_4IN2_V2_SendData(UBYTE Data)
     DEV_Digital_Write(EPD_CS_PIN, 1);
 }
 
+/******************************************************************************
+function :	send command followed by a contiguous block of data
+parameter:
+     Reg : Command register
+    Data : Payload
+     Len : Payload length in bytes
+Info:
+    DC is set once and CS is held for the whole payload (see DEV_SPI_Stream*)
+******************************************************************************/
+static void EPD_4IN2_V2_SendImage(UBYTE Reg, const UBYTE *Data, UDOUBLE Len)
+{
+    DEV_SPI_StreamBegin(Reg);
+    DEV_SPI_StreamWrite(Data, Len);
+    DEV_SPI_StreamEnd();
+}
+
+/******************************************************************************
+function :	send command followed by rows taken from a larger buffer
+parameter:
+       Reg : Command register
+     First : First byte of the first row
+    Stride : Bytes between the starts of consecutive rows
+ WidthByte : Bytes sent per row
+      Rows : Number of rows
+Info:
+    Same single transaction as EPD_4IN2_V2_SendImage, without copying the
+    window out of the frame buffer first
+******************************************************************************/
+static void EPD_4IN2_V2_SendRows(UBYTE Reg, const UBYTE *First, UWORD Stride, UWORD WidthByte, UWORD Rows)
+{
+    DEV_SPI_StreamBegin(Reg);
+    if (Stride == WidthByte) {
+        DEV_SPI_StreamWrite(First, (UDOUBLE)WidthByte * Rows);
+    } else {
+        for (UWORD j = 0; j < Rows; j++) {
+            DEV_SPI_StreamWrite(First + (UDOUBLE)j * Stride, WidthByte);
+        }
+    }
+    DEV_SPI_StreamEnd();
+}
+
 /******************************************************************************
 function :	Wait until the busy_pin goes LOW
 parameter:
@@ -121,6 +162,39 @@ void EPD_4IN2_V2_ReadBusy(void)
     Debug("e-Paper busy release\r\n");
 }
 
+/******************************************************************************
+function :	Read the busy_pin once
+parameter:
+return   :  1 while a waveform is running, 0 when idle
+******************************************************************************/
+UBYTE EPD_4IN2_V2_IsBusy(void)
+{
+    return DEV_Digital_Read(EPD_BUSY_PIN) == 1 ? 1 : 0;
+}
+
+/******************************************************************************
+function :	Select blocking or non-blocking refreshes
+parameter:
+    Enable : 1 - Display/Clear/PartialDisplay return as soon as the update
+                 is triggered; the caller must wait for BUSY to drop
+                 (EPD_4IN2_V2_IsBusy / DEV_Busy_TakeIRQ) before sending
+                 anything else to the panel
+             0 - refreshes block until the waveform completes (default)
+******************************************************************************/
+static UBYTE EPD_4IN2_V2_Async = 0;
+
+void EPD_4IN2_V2_SetAsync(UBYTE Enable)
+{
+    EPD_4IN2_V2_Async = Enable ? 1 : 0;
+}
+
+static void EPD_4IN2_V2_WaitRefresh(void)
+{
+    if (!EPD_4IN2_V2_Async) {
+        EPD_4IN2_V2_ReadBusy();
+    }
+}
+
 /******************************************************************************
 function :	Turn On Display
 parameter:
@@ -130,7 +204,7 @@ static void EPD_4IN2_V2_TurnOnDisplay(void)
     EPD_4IN2_V2_SendCommand(0x22);
 	EPD_4IN2_V2_SendData(0xF7);
     EPD_4IN2_V2_SendCommand(0x20);
-    EPD_4IN2_V2_ReadBusy();
+    EPD_4IN2_V2_WaitRefresh();
 }
 
 static void EPD_4IN2_V2_TurnOnDisplay_Fast(void)
@@ -138,7 +212,7 @@ static void EPD_4IN2_V2_TurnOnDisplay_Fast(void)
     EPD_4IN2_V2_SendCommand(0x22);
 	EPD_4IN2_V2_SendData(0xC7);
     EPD_4IN2_V2_SendCommand(0x20);
-    EPD_4IN2_V2_ReadBusy();
+    EPD_4IN2_V2_WaitRefresh();
 }
 
 static void EPD_4IN2_V2_TurnOnDisplay_Partial(void)
@@ -146,7 +220,7 @@ static void EPD_4IN2_V2_TurnOnDisplay_Partial(void)
     EPD_4IN2_V2_SendCommand(0x22);
 	EPD_4IN2_V2_SendData(0xFF);
     EPD_4IN2_V2_SendCommand(0x20);
-    EPD_4IN2_V2_ReadBusy();
+    EPD_4IN2_V2_WaitRefresh();
 }
 
 static void EPD_4IN2_V2_TurnOnDisplay_4Gray(void)
@@ -154,7 +228,7 @@ static void EPD_4IN2_V2_TurnOnDisplay_4Gray(void)
     EPD_4IN2_V2_SendCommand(0x22);
 	EPD_4IN2_V2_SendData(0xCF);
     EPD_4IN2_V2_SendCommand(0x20);
-    EPD_4IN2_V2_ReadBusy();
+    EPD_4IN2_V2_WaitRefresh();
 }
 
 /******************************************************************************
@@ -194,11 +268,8 @@ static void EPD_4IN2_V2_4Gray_lut(void)
     unsigned char i;
 
     //WS byte 0~152, the content of VS[nX-LUTm], TP[nX], RP[n], SR[nXY], FR[n] and XON[nXY]
-    EPD_4IN2_V2_SendCommand(0x32);					
-    for(i=0;i<227;i++)
-    {
-        EPD_4IN2_V2_SendData(LUT_ALL[i]);
-    }	
+    EPD_4IN2_V2_SendImage(0x32, LUT_ALL, 227);
+    i = 227;
     //WS byte 153, the content of Option for LUT end	
     EPD_4IN2_V2_SendCommand(0x3F);					
     EPD_4IN2_V2_SendData(LUT_ALL[i++]);
@@ -334,6 +405,32 @@ void EPD_4IN2_V2_Init_4Gray(void)
 	 
 	EPD_4IN2_V2_SetCursor(0, 0);
 }
+/******************************************************************************
+function :	Undo what a partial refresh left behind, before a full frame
+parameter:
+    Mono : 1 to also restore the black/white update control and border
+           (Init / Init_Fast values); 0 for the 4-gray settings, which
+           partials never touch
+Info:
+    EPD_4IN2_V2_PartialBegin/LoadWindow narrow the RAM window and move the
+    cursor; without this a full frame would be streamed into the last
+    partial's window.
+******************************************************************************/
+static void EPD_4IN2_V2_FullFrameBegin(UBYTE Mono)
+{
+    if(Mono) {
+        EPD_4IN2_V2_SendCommand(0x21); //  Display update control
+        EPD_4IN2_V2_SendData(0x40);
+        EPD_4IN2_V2_SendData(0x00);
+
+        EPD_4IN2_V2_SendCommand(0x3C); //BorderWavefrom
+        EPD_4IN2_V2_SendData(0x05);
+    }
+
+    EPD_4IN2_V2_SetWindows(0, 0, EPD_4IN2_V2_WIDTH-1, EPD_4IN2_V2_HEIGHT-1);
+    EPD_4IN2_V2_SetCursor(0, 0);
+}
+
 /******************************************************************************
 function :	Clear screen
 parameter:
@@ -344,19 +441,15 @@ void EPD_4IN2_V2_Clear(void)
     Width = (EPD_4IN2_V2_WIDTH % 8 == 0)? (EPD_4IN2_V2_WIDTH / 8 ): (EPD_4IN2_V2_WIDTH / 8 + 1);
     Height = EPD_4IN2_V2_HEIGHT;
 
-    EPD_4IN2_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(0xFF);
-        }
-    }
+    EPD_4IN2_V2_FullFrameBegin(1);
+    DEV_SPI_StreamBegin(0x24);
+    DEV_SPI_StreamFill(0xFF, (UDOUBLE)Width * Height);
+    DEV_SPI_StreamEnd();
 
-    EPD_4IN2_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(0xFF);
-        }
-    }
+    EPD_4IN2_V2_SetCursor(0, 0);
+    DEV_SPI_StreamBegin(0x26);
+    DEV_SPI_StreamFill(0xFF, (UDOUBLE)Width * Height);
+    DEV_SPI_StreamEnd();
     EPD_4IN2_V2_TurnOnDisplay();
 }
 
@@ -370,19 +463,10 @@ void EPD_4IN2_V2_Display(UBYTE *Image)
     Width = (EPD_4IN2_V2_WIDTH % 8 == 0)? (EPD_4IN2_V2_WIDTH / 8 ): (EPD_4IN2_V2_WIDTH / 8 + 1);
     Height = EPD_4IN2_V2_HEIGHT;
 
-    EPD_4IN2_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(Image[i + j * Width]);
-        }
-    }
-
-    EPD_4IN2_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(Image[i + j * Width]);
-        }
-    }
+    EPD_4IN2_V2_FullFrameBegin(1);
+    EPD_4IN2_V2_SendImage(0x24, Image, (UDOUBLE)Width * Height);
+    EPD_4IN2_V2_SetCursor(0, 0);
+    EPD_4IN2_V2_SendImage(0x26, Image, (UDOUBLE)Width * Height);
     EPD_4IN2_V2_TurnOnDisplay();
 }
 
@@ -396,121 +480,83 @@ void EPD_4IN2_V2_Display_Fast(UBYTE *Image)
     Width = (EPD_4IN2_V2_WIDTH % 8 == 0)? (EPD_4IN2_V2_WIDTH / 8 ): (EPD_4IN2_V2_WIDTH / 8 + 1);
     Height = EPD_4IN2_V2_HEIGHT;
 
-    EPD_4IN2_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(Image[i + j * Width]);
-        }
-    }
-
-    EPD_4IN2_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(Image[i + j * Width]);
-        }
-    }
+    EPD_4IN2_V2_FullFrameBegin(1);
+    EPD_4IN2_V2_SendImage(0x24, Image, (UDOUBLE)Width * Height);
+    EPD_4IN2_V2_SetCursor(0, 0);
+    EPD_4IN2_V2_SendImage(0x26, Image, (UDOUBLE)Width * Height);
     EPD_4IN2_V2_TurnOnDisplay_Fast();
 }
 
 
-void EPD_4IN2_V2_Display_4Gray(UBYTE *Image)
-{
-    UDOUBLE i,j,k,m;
-    UBYTE temp1,temp2,temp3;
 /****Color display description****
       white  gray2  gray1  black
-0x10|  01     01     00     00
-0x13|  01     00     01     00
+0x24|  01     01     00     00
+0x26|  01     00     01     00
+Plane 0x24 takes the low bit of every 2bpp pixel and 0x26 the high bit,
+so each table turns one image byte (4 pixels) into a nibble of the
+plane byte; an output byte is the nibbles of two image bytes.
 *********************************/
-	EPD_4IN2_V2_SendCommand(0x24);	       
-	// EPD_4IN2_HEIGHT
-	// EPD_4IN2_WIDTH
-	for(m = 0; m<EPD_4IN2_V2_HEIGHT;m++)
-		for(i=0;i<EPD_4IN2_V2_WIDTH/8;i++)
-		{
-			temp3=0;
-			for(j=0;j<2;j++)	
-			{
-				
-				temp1 = Image[(m*(EPD_4IN2_V2_WIDTH/8)+i)*2+j];
-				for(k=0;k<2;k++)	
-				{
-					temp2 = temp1&0xC0 ;
-					if(temp2 == 0xC0)
-						temp3 |= 0x01;//white
-					else if(temp2 == 0x00)
-						temp3 |= 0x00;  //black
-					else if(temp2 == 0x80) 
-						temp3 |= 0x00;  //gray1
-					else //0x40
-						temp3 |= 0x01; //gray2
-					temp3 <<= 1;	
-					
-					temp1 <<= 2;
-					temp2 = temp1&0xC0 ;
-					if(temp2 == 0xC0)  //white
-						temp3 |= 0x01;
-					else if(temp2 == 0x00) //black
-						temp3 |= 0x00;
-					else if(temp2 == 0x80)
-						temp3 |= 0x00; //gray1
-					else    //0x40
-							temp3 |= 0x01;	//gray2	
-					if(j!=1 || k!=1)				
-						temp3 <<= 1;
-					
-					temp1 <<= 2;
-				}
-				
-			 }
-			EPD_4IN2_V2_SendData(temp3);			
-		}
-    // new  data
-    EPD_4IN2_V2_SendCommand(0x26);	 
-	for(m = 0; m<EPD_4IN2_V2_HEIGHT;m++)
-		for(i=0;i<EPD_4IN2_V2_WIDTH/8;i++)
-		{
-			temp3=0;
-			for(j=0;j<2;j++)	
-			{
-				temp1 = Image[(m*(EPD_4IN2_V2_WIDTH/8)+i)*2+j];
-				for(k=0;k<2;k++)	
-				{
-					temp2 = temp1&0xC0 ;
-					if(temp2 == 0xC0)
-						temp3 |= 0x01;//white
-					else if(temp2 == 0x00)
-						temp3 |= 0x00;  //black
-					else if(temp2 == 0x80) 
-						temp3 |= 0x01;  //gray1
-					else //0x40
-						temp3 |= 0x00; //gray2
-					temp3 <<= 1;	
-					
-					temp1 <<= 2;
-					temp2 = temp1&0xC0 ;
-					if(temp2 == 0xC0)  //white
-						temp3 |= 0x01;
-					else if(temp2 == 0x00) //black
-						temp3 |= 0x00;
-					else if(temp2 == 0x80)
-						temp3 |= 0x01; //gray1
-					else    //0x40
-							temp3 |= 0x00;	//gray2
-					if(j!=1 || k!=1)					
-						temp3 <<= 1;
-					
-					temp1 <<= 2;
-				}
-				
-			 }
-			EPD_4IN2_V2_SendData(temp3);	
-		}
+#define EPD_4GRAY_LOW_BITS(b)  ((((b) >> 3) & 0x08) | (((b) >> 2) & 0x04) | (((b) >> 1) & 0x02) | ((b) & 0x01))
+#define EPD_4GRAY_HIGH_BITS(b) EPD_4GRAY_LOW_BITS((b) >> 1)
+#define EPD_4GRAY_R4(F, n)   F(n), F((n) + 1), F((n) + 2), F((n) + 3)
+#define EPD_4GRAY_R16(F, n)  EPD_4GRAY_R4(F, n), EPD_4GRAY_R4(F, (n) + 4), EPD_4GRAY_R4(F, (n) + 8), EPD_4GRAY_R4(F, (n) + 12)
+#define EPD_4GRAY_R64(F, n)  EPD_4GRAY_R16(F, n), EPD_4GRAY_R16(F, (n) + 16), EPD_4GRAY_R16(F, (n) + 32), EPD_4GRAY_R16(F, (n) + 48)
+#define EPD_4GRAY_R256(F)    EPD_4GRAY_R64(F, 0), EPD_4GRAY_R64(F, 64), EPD_4GRAY_R64(F, 128), EPD_4GRAY_R64(F, 192)
+
+static const UBYTE EPD_4IN2_V2_4Gray_Plane24[256] = { EPD_4GRAY_R256(EPD_4GRAY_LOW_BITS) };
+static const UBYTE EPD_4IN2_V2_4Gray_Plane26[256] = { EPD_4GRAY_R256(EPD_4GRAY_HIGH_BITS) };
+
+#define EPD_4IN2_V2_4GRAY_CHUNK_ROWS 10  // Plane rows converted per SPI write (500 bytes of stack)
+
+/******************************************************************************
+function :	Convert a 2bpp image into one 1bpp plane and stream it to RAM
+parameter:
+      Reg : 0x24 or 0x26
+    Image : 2bpp image, 4 pixels per byte, MSB first
+      Lut : Nibble table of the plane
+******************************************************************************/
+static void EPD_4IN2_V2_Send4GrayPlane(UBYTE Reg, const UBYTE *Image, const UBYTE *Lut)
+{
+    UBYTE Chunk[EPD_4IN2_V2_4GRAY_CHUNK_ROWS * (EPD_4IN2_V2_WIDTH / 8)];
+    UDOUBLE Total = (UDOUBLE)(EPD_4IN2_V2_WIDTH / 8) * EPD_4IN2_V2_HEIGHT;
+
+    // Plane rows are half as long as image rows, so the frame converts
+    // as one run of byte pairs
+    DEV_SPI_StreamBegin(Reg);
+    for (UDOUBLE Done = 0; Done < Total; Done += sizeof(Chunk)) {
+        UDOUBLE Count = (Total - Done < sizeof(Chunk)) ? Total - Done : sizeof(Chunk);
+        const UBYTE *In = Image + 2 * Done;
+        for (UDOUBLE i = 0; i < Count; i++, In += 2) {
+            Chunk[i] = (UBYTE)((Lut[In[0]] << 4) | Lut[In[1]]);
+        }
+        DEV_SPI_StreamWrite(Chunk, Count);
+    }
+    DEV_SPI_StreamEnd();
+}
+
+/******************************************************************************
+function :	Sends a 2bpp image buffer to e-Paper and displays it in 4 grays
+parameter:
+    Image : EPD_4IN2_V2_WIDTH / 4 * EPD_4IN2_V2_HEIGHT bytes (Paint scale 4)
+******************************************************************************/
+void EPD_4IN2_V2_Display_4Gray(UBYTE *Image)
+{
+    EPD_4IN2_V2_FullFrameBegin(0);
+    EPD_4IN2_V2_Send4GrayPlane(0x24, Image, EPD_4IN2_V2_4Gray_Plane24);
+    EPD_4IN2_V2_SetCursor(0, 0);
+    EPD_4IN2_V2_Send4GrayPlane(0x26, Image, EPD_4IN2_V2_4Gray_Plane26);
     EPD_4IN2_V2_TurnOnDisplay_4Gray();
 }
 
-// Send partial data for partial refresh
-void EPD_4IN2_V2_PartialDisplay(UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+/******************************************************************************
+function :	Set a partial refresh window
+parameter:
+    Xstart, Ystart, Xend, Yend : Window in pixels (end exclusive)
+    XstartByte                 : Resulting first RAM X address in bytes
+return   :  Number of bytes in the window
+******************************************************************************/
+static UDOUBLE EPD_4IN2_V2_PartialWindow(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+                                         UWORD *XstartByte)
 {
     if((Xstart % 8 + Xend % 8 == 8 && Xstart % 8 > Xend % 8) || Xstart % 8 + Xend % 8 == 0 || (Xend - Xstart)%8 == 0)
 	{
@@ -524,23 +570,13 @@ void EPD_4IN2_V2_PartialDisplay(UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD
 	}
 
 
-	UWORD i, Width;
+	UWORD Width;
 	Width = Xend -  Xstart;
-	UWORD IMAGE_COUNTER = Width * (Yend-Ystart);
+	UDOUBLE IMAGE_COUNTER = (UDOUBLE)Width * (Yend-Ystart);
 
 	Xend -= 1;
 	Yend -= 1;	
 
-	EPD_4IN2_V2_SendCommand(0x3C); //BorderWavefrom,
-	EPD_4IN2_V2_SendData(0x80);	
-
-	EPD_4IN2_V2_SendCommand(0x21); 
-	EPD_4IN2_V2_SendData(0x00);
-	EPD_4IN2_V2_SendData(0x00);
-
-	EPD_4IN2_V2_SendCommand(0x3C); 
-	EPD_4IN2_V2_SendData(0x80); 
-
 	EPD_4IN2_V2_SendCommand(0x44);       // set RAM x address start/end, in page 35
 	EPD_4IN2_V2_SendData(Xstart & 0xff);    // RAM x address start at 00h;
 	EPD_4IN2_V2_SendData(Xend & 0xff);    // RAM x address end at 0fh(15+1)*8->128 
@@ -550,20 +586,190 @@ void EPD_4IN2_V2_PartialDisplay(UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD
 	EPD_4IN2_V2_SendData(Yend & 0xff);    // RAM y address end at 00h;
 	EPD_4IN2_V2_SendData((Yend>>8) & 0x01); 
 
+	*XstartByte = Xstart;
+	return IMAGE_COUNTER;
+}
+
+/******************************************************************************
+function :	Point the RAM address counters at the window origin
+******************************************************************************/
+static void EPD_4IN2_V2_PartialCursor(UWORD XstartByte, UWORD Ystart)
+{
 	EPD_4IN2_V2_SendCommand(0x4E);   // set RAM x address count to 0;
-	EPD_4IN2_V2_SendData(Xstart & 0xff);
+	EPD_4IN2_V2_SendData(XstartByte & 0xff);
 	EPD_4IN2_V2_SendCommand(0x4F);   // set RAM y address count to 0X127;
 	EPD_4IN2_V2_SendData(Ystart & 0xff);
 	EPD_4IN2_V2_SendData((Ystart>>8) & 0x01);
+}
+
+/******************************************************************************
+function :	Batched partial refresh
+Info:
+    RAM keeps whatever was written to it, and the partial waveform drives
+    every pixel that differs between 0x24 and 0x26, so several windows can
+    be loaded and then shown with a single update:
+        EPD_4IN2_V2_PartialBegin();
+        EPD_4IN2_V2_PartialLoadWindow(...);   // once per window
+        EPD_4IN2_V2_PartialUpdate();
+******************************************************************************/
+void EPD_4IN2_V2_PartialBegin(void)
+{
+	EPD_4IN2_V2_SendCommand(0x3C); //BorderWavefrom,
+	EPD_4IN2_V2_SendData(0x80);	
+
+	EPD_4IN2_V2_SendCommand(0x21); 
+	EPD_4IN2_V2_SendData(0x00);
+	EPD_4IN2_V2_SendData(0x00);
+
+	EPD_4IN2_V2_SendCommand(0x3C); 
+	EPD_4IN2_V2_SendData(0x80); 
+}
 
-    EPD_4IN2_V2_SendCommand(0x24);
-    for (i = 0; i < IMAGE_COUNTER; i++) {
-		EPD_4IN2_V2_SendData(Image[i]);
+/******************************************************************************
+function :	Set a window and stream its rows into RAM
+parameter:
+    OldBase, Base : Sources for 0x26 / 0x24 (OldBase NULL to leave 0x26 alone)
+    Stride        : Source bytes per row; 0 means the sources hold just the
+                    window, packed
+******************************************************************************/
+static void EPD_4IN2_V2_LoadWindow(const UBYTE *OldBase, const UBYTE *Base, UWORD Stride,
+                                   UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+{
+	UWORD XstartByte;
+	UDOUBLE IMAGE_COUNTER = EPD_4IN2_V2_PartialWindow(Xstart, Ystart, Xend, Yend, &XstartByte);
+	UWORD Rows = Yend - Ystart;
+	if(Rows == 0)
+		return;
+	UWORD WidthByte = IMAGE_COUNTER / Rows;
+
+	UDOUBLE Offset = 0;
+	if(Stride == 0)
+		Stride = WidthByte;
+	else
+		Offset = (UDOUBLE)Ystart * Stride + XstartByte;
+
+	if(OldBase != NULL) {
+		EPD_4IN2_V2_PartialCursor(XstartByte, Ystart);
+		EPD_4IN2_V2_SendRows(0x26, OldBase + Offset, Stride, WidthByte, Rows);
 	}
 
+	EPD_4IN2_V2_PartialCursor(XstartByte, Ystart);
+	EPD_4IN2_V2_SendRows(0x24, Base + Offset, Stride, WidthByte, Rows);
+}
+
+/******************************************************************************
+parameter:
+    OldImage : What the panel currently shows in the window (-> RAM 0x26),
+               NULL to leave 0x26 alone
+    Image    : What it should show after the update      (-> RAM 0x24)
+******************************************************************************/
+void EPD_4IN2_V2_PartialLoadWindow(UBYTE *OldImage, UBYTE *Image,
+                                   UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+{
+	EPD_4IN2_V2_LoadWindow(OldImage, Image, 0, Xstart, Ystart, Xend, Yend);
+}
+
+/******************************************************************************
+function :	Load a window straight out of full frame buffers
+parameter:
+    OldBase : Frame buffer the panel currently shows (-> RAM 0x26), or NULL
+    Base    : Frame buffer to show                   (-> RAM 0x24)
+    Stride  : Bytes per frame buffer row (EPD_4IN2_V2_WIDTH / 8 for a full frame)
+Info:
+    Rows are streamed from the frame buffer to SPI, so no window copy is
+    needed
+******************************************************************************/
+void EPD_4IN2_V2_PartialLoadWindow_Strided(const UBYTE *OldBase, const UBYTE *Base, UWORD Stride,
+                                           UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+{
+	EPD_4IN2_V2_LoadWindow(OldBase, Base, Stride, Xstart, Ystart, Xend, Yend);
+}
+
+/******************************************************************************
+function :	Load a window for one half of an inverted flash
+parameter:
+    Base   : Frame buffer the panel shows in the window
+    Stride : Bytes per frame buffer row
+    Invert : 1: 0x26 = Base, 0x24 = ~Base, so the update drives every pixel
+                of the window to its inverse
+             0: 0x26 = ~Base, 0x24 = Base, driving them back
+Info:
+    Two partial updates, one per half, put every pixel of the window
+    through a full black/white swing, which clears its ghosting without
+    flashing the rest of the screen. Rows are inverted through a one-row
+    buffer on their way to SPI.
+******************************************************************************/
+void EPD_4IN2_V2_PartialLoadWindow_Inverted(const UBYTE *Base, UWORD Stride, UBYTE Invert,
+                                            UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+{
+	UWORD XstartByte;
+	UDOUBLE IMAGE_COUNTER = EPD_4IN2_V2_PartialWindow(Xstart, Ystart, Xend, Yend, &XstartByte);
+	UWORD Rows = Yend - Ystart;
+	if(Rows == 0)
+		return;
+	UWORD WidthByte = IMAGE_COUNTER / Rows;
+	const UBYTE *First = Base + (UDOUBLE)Ystart * Stride + XstartByte;
+
+	UBYTE Row[EPD_4IN2_V2_WIDTH / 8];
+	for (UBYTE Pass = 0; Pass < 2; Pass++) {
+		// Pass 0 writes 0x26, pass 1 writes 0x24
+		UBYTE Inverted = (Pass == 0) ? !Invert : Invert;
+		EPD_4IN2_V2_PartialCursor(XstartByte, Ystart);
+		DEV_SPI_StreamBegin(Pass == 0 ? 0x26 : 0x24);
+		for (UWORD j = 0; j < Rows; j++) {
+			const UBYTE *Src = First + (UDOUBLE)j * Stride;
+			if (Inverted) {
+				for (UWORD i = 0; i < WidthByte; i++)
+					Row[i] = ~Src[i];
+				DEV_SPI_StreamWrite(Row, WidthByte);
+			} else {
+				DEV_SPI_StreamWrite(Src, WidthByte);
+			}
+		}
+		DEV_SPI_StreamEnd();
+	}
+}
+
+void EPD_4IN2_V2_PartialUpdate(void)
+{
 	EPD_4IN2_V2_TurnOnDisplay_Partial();
 }
 
+// Send partial data for partial refresh
+void EPD_4IN2_V2_PartialDisplay(UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+{
+	EPD_4IN2_V2_PartialBegin();
+	EPD_4IN2_V2_LoadWindow(NULL, Image, 0, Xstart, Ystart, Xend, Yend);
+	EPD_4IN2_V2_PartialUpdate();
+}
+
+// Partial refresh of a window of a full frame buffer, without copying it out
+void EPD_4IN2_V2_PartialDisplay_Strided(const UBYTE *Base, UWORD Stride,
+                                        UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+{
+	EPD_4IN2_V2_PartialBegin();
+	EPD_4IN2_V2_LoadWindow(NULL, Base, Stride, Xstart, Ystart, Xend, Yend);
+	EPD_4IN2_V2_PartialUpdate();
+}
+
+/******************************************************************************
+function :	Differential partial refresh
+parameter:
+    OldImage : What the panel currently shows in the window (-> RAM 0x26)
+    Image    : What it should show after the update      (-> RAM 0x24)
+Info:
+    EPD_4IN2_V2_PartialDisplay() only writes 0x24, so the "previous image"
+    RAM drifts away from the panel and the waveform ghosts. Writing the
+    caller's shadow of the window to 0x26 first keeps both RAMs in sync.
+******************************************************************************/
+void EPD_4IN2_V2_PartialDisplay_Diff(UBYTE *OldImage, UBYTE *Image,
+                                     UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+{
+	EPD_4IN2_V2_PartialBegin();
+	EPD_4IN2_V2_PartialLoadWindow(OldImage, Image, Xstart, Ystart, Xend, Yend);
+	EPD_4IN2_V2_PartialUpdate();
+}
+
 /******************************************************************************
 function :	Enter sleep mode
 parameter:
@@ -48,6 +48,25 @@ void EPD_4IN2_V2_Display(UBYTE *Image);
 void EPD_4IN2_V2_Display_Fast(UBYTE *Image);
 void EPD_4IN2_V2_Display_4Gray(UBYTE *Image);
 void EPD_4IN2_V2_PartialDisplay(UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
+void EPD_4IN2_V2_PartialDisplay_Diff(UBYTE *OldImage, UBYTE *Image,
+                                     UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
+void EPD_4IN2_V2_PartialDisplay_Strided(const UBYTE *Base, UWORD Stride,
+                                        UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
 void EPD_4IN2_V2_Sleep(void);
 
+// Batched partial refresh: several windows, one waveform
+void EPD_4IN2_V2_PartialBegin(void);
+void EPD_4IN2_V2_PartialLoadWindow(UBYTE *OldImage, UBYTE *Image,
+                                   UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
+void EPD_4IN2_V2_PartialLoadWindow_Strided(const UBYTE *OldBase, const UBYTE *Base, UWORD Stride,
+                                           UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
+void EPD_4IN2_V2_PartialLoadWindow_Inverted(const UBYTE *Base, UWORD Stride, UBYTE Invert,
+                                            UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
+void EPD_4IN2_V2_PartialUpdate(void);
+
+// Busy handling
+void EPD_4IN2_V2_ReadBusy(void);
+UBYTE EPD_4IN2_V2_IsBusy(void);
+void EPD_4IN2_V2_SetAsync(UBYTE Enable);   // 1: refreshes return right after triggering the waveform
+
 #endif
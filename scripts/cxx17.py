@@ -0,0 +1,5 @@
+# C++17 for the constexpr UI assets (VectorAsset.h). Added to CXXFLAGS
+# only, so C sources keep the toolchain's own -std.
+Import("env")
+
+env.Append(CXXFLAGS=["-std=gnu++17"])
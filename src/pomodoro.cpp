@@ -2,9 +2,13 @@
  * POMODORO TIMER - ESP32-S3 + E-Paper + DS3231 RTC
  * 
  * Based on simple_timer_bitmap.cpp partial refresh approach:
- * - Digits and progress squares use separate partial refresh regions
- * - Progress updates refresh entire border area (not individual squares)
- * - Buttons have their own isolated refresh region
+ * - Draw code only marks what it changed, with a latency budget (button
+ *   feedback 50ms, countdown 1s); loop() shows everything pending as one
+ *   partial waveform, refreshing only the bytes that changed
+ * - Partial refreshes run asynchronously (WatcherDisplay) so loop() keeps
+ *   polling the buttons while the panel waveform runs
+ * - Ghosted tiles are cleaned at quiet moments only: while stopped, or
+ *   when the progress ring wraps at a minute boundary
  * 
  * Button behavior:
  * - SW1 (Start/Pause): Toggle between START and PAUSE states
@@ -16,6 +20,8 @@
 #include <Wire.h>
 #include "EPD.h"
 #include "GUI_Paint.h"
+#include "WatcherDisplay.h"
+#include "pomodoro_assets.h"
 
 // ============================================================
 // SCREEN & LAYOUT (same as simple_timer_bitmap.cpp)
@@ -57,7 +63,8 @@
 // ============================================================
 // GLOBALS
 // ============================================================
-UBYTE *BlackImage = nullptr;
+WatcherDisplay display;
+UBYTE *BlackImage = nullptr;   // display.getBuffer()
 
 // Timer modes (minutes)
 const uint8_t TIMER_MODES[] = {5, 10, 15, 20, 25};
@@ -83,21 +90,6 @@ uint8_t stableBtnState[3] = {HIGH, HIGH, HIGH};
 struct SquarePos { uint16_t x, y; };
 SquarePos squarePositions[60];
 
-// 7-segment digit map (same as simple_timer)
-const bool DIGIT_SEGS[10][7] = {
-    //  A      B      C      D      E      F      G
-    {true,  true,  true,  true,  true,  true,  false}, // 0
-    {false, true,  true,  false, false, false, false}, // 1
-    {true,  true,  false, true,  true,  false, true},  // 2
-    {true,  true,  true,  true,  false, false, true},  // 3
-    {false, true,  true,  false, false, true,  true},  // 4
-    {true,  false, true,  true,  false, true,  true},  // 5
-    {true,  false, true,  true,  true,  true,  true},  // 6
-    {true,  true,  true,  false, false, false, false}, // 7
-    {true,  true,  true,  true,  true,  true,  true},  // 8
-    {true,  true,  true,  true,  false, true,  true}   // 9
-};
-
 // ============================================================
 // DS3231 RTC FUNCTIONS
 // ============================================================
@@ -134,76 +126,13 @@ uint32_t rtcGetSeconds() {
 }
 
 // ============================================================
-// 7-SEGMENT DRAWING (EXACT copy from simple_timer_bitmap.cpp)
+// 7-SEGMENT DRAWING (ONES.svg tables from pomodoro_assets.h)
 // ============================================================
 
-// Segment A - Top horizontal
-void drawSegmentA(uint16_t x, uint16_t y, bool on) {
-    if (!on) return;
-    int16_t xpts[] = {(int16_t)(x+1), (int16_t)(x+70), (int16_t)(x+57), (int16_t)(x+13), (int16_t)(x+1)};
-    int16_t ypts[] = {(int16_t)(y+0), (int16_t)(y+0), (int16_t)(y+11), (int16_t)(y+11), (int16_t)(y+0)};
-    Paint_DrawPolygon(xpts, ypts, 5, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-}
-
-// Segment B - Top right vertical
-void drawSegmentB(uint16_t x, uint16_t y, bool on) {
-    if (!on) return;
-    int16_t xpts[] = {(int16_t)(x+70), (int16_t)(x+70), (int16_t)(x+59), (int16_t)(x+59), (int16_t)(x+70)};
-    int16_t ypts[] = {(int16_t)(y+3), (int16_t)(y+64), (int16_t)(y+57), (int16_t)(y+13), (int16_t)(y+3)};
-    Paint_DrawPolygon(xpts, ypts, 5, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-}
-
-// Segment C - Bottom right vertical
-void drawSegmentC(uint16_t x, uint16_t y, bool on) {
-    if (!on) return;
-    int16_t xpts[] = {(int16_t)(x+70), (int16_t)(x+70), (int16_t)(x+59), (int16_t)(x+59), (int16_t)(x+70)};
-    int16_t ypts[] = {(int16_t)(y+67), (int16_t)(y+129), (int16_t)(y+118), (int16_t)(y+73), (int16_t)(y+67)};
-    Paint_DrawPolygon(xpts, ypts, 5, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-}
-
-// Segment D - Bottom horizontal
-void drawSegmentD(uint16_t x, uint16_t y, bool on) {
-    if (!on) return;
-    int16_t xpts[] = {(int16_t)(x+67), (int16_t)(x+3), (int16_t)(x+13), (int16_t)(x+57), (int16_t)(x+67)};
-    int16_t ypts[] = {(int16_t)(y+130), (int16_t)(y+130), (int16_t)(y+119), (int16_t)(y+119), (int16_t)(y+130)};
-    Paint_DrawPolygon(xpts, ypts, 5, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-}
-
-// Segment E - Bottom left vertical
-void drawSegmentE(uint16_t x, uint16_t y, bool on) {
-    if (!on) return;
-    int16_t xpts[] = {(int16_t)(x+0), (int16_t)(x+0), (int16_t)(x+11), (int16_t)(x+11), (int16_t)(x+0)};
-    int16_t ypts[] = {(int16_t)(y+129), (int16_t)(y+66), (int16_t)(y+73), (int16_t)(y+117), (int16_t)(y+129)};
-    Paint_DrawPolygon(xpts, ypts, 5, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-}
-
-// Segment F - Top left vertical
-void drawSegmentF(uint16_t x, uint16_t y, bool on) {
-    if (!on) return;
-    int16_t xpts[] = {(int16_t)(x+0), (int16_t)(x+0), (int16_t)(x+11), (int16_t)(x+11), (int16_t)(x+0)};
-    int16_t ypts[] = {(int16_t)(y+64), (int16_t)(y+3), (int16_t)(y+13), (int16_t)(y+57), (int16_t)(y+64)};
-    Paint_DrawPolygon(xpts, ypts, 5, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-}
-
-// Segment G - Middle horizontal
-void drawSegmentG(uint16_t x, uint16_t y, bool on) {
-    if (!on) return;
-    int16_t xpts[] = {(int16_t)(x+11), (int16_t)(x+59), (int16_t)(x+69), (int16_t)(x+59), (int16_t)(x+11), (int16_t)(x+2), (int16_t)(x+11)};
-    int16_t ypts[] = {(int16_t)(y+60), (int16_t)(y+60), (int16_t)(y+65), (int16_t)(y+70), (int16_t)(y+70), (int16_t)(y+65), (int16_t)(y+60)};
-    Paint_DrawPolygon(xpts, ypts, 7, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-}
-
-// Draw complete digit at position (same as simple_timer)
+// Draw complete digit at position (blank for anything but 0-9)
 void drawDigit(uint16_t x, uint16_t y, uint8_t digit) {
     if (digit > 9) return;
-    const bool* segs = DIGIT_SEGS[digit];
-    drawSegmentA(x, y, segs[0]);
-    drawSegmentB(x, y, segs[1]);
-    drawSegmentC(x, y, segs[2]);
-    drawSegmentD(x, y, segs[3]);
-    drawSegmentE(x, y, segs[4]);
-    drawSegmentF(x, y, segs[5]);
-    drawSegmentG(x, y, segs[6]);
+    display.drawAsset(x, y, ASSET_DIGITS[digit], BLACK);
 }
 
 // ============================================================
@@ -258,37 +187,6 @@ void drawProgressSquare(uint8_t index, bool filled) {
     }
 }
 
-// ============================================================
-// PARTIAL REFRESH (EXACT from simple_timer)
-// ============================================================
-void partialRefresh(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
-    uint16_t refreshX = (x / 8) * 8;
-    uint16_t refreshWidth = ((w + 7) / 8) * 8;
-    uint16_t refreshXEnd = refreshX + refreshWidth;
-    uint16_t refreshYEnd = y + h;
-
-    if (refreshXEnd > SCREEN_WIDTH) refreshXEnd = SCREEN_WIDTH;
-    if (refreshYEnd > SCREEN_HEIGHT) refreshYEnd = SCREEN_HEIGHT;
-
-    UWORD bytesPerRow = ((SCREEN_WIDTH % 8 == 0) ? (SCREEN_WIDTH / 8) : (SCREEN_WIDTH / 8 + 1));
-    UWORD regionBytes = refreshWidth / 8;
-    UWORD bufferSize = regionBytes * h;
-
-    UBYTE *buffer = (UBYTE*)malloc(bufferSize);
-    if (!buffer) return;
-
-    UWORD startX = refreshX / 8;
-    for (UWORD row = 0; row < h; row++) {
-        if ((y + row) >= SCREEN_HEIGHT) break;
-        UWORD srcOff = (y + row) * bytesPerRow + startX;
-        UWORD dstOff = row * regionBytes;
-        memcpy(&buffer[dstOff], &BlackImage[srcOff], regionBytes);
-    }
-
-    EPD_4IN2_V2_PartialDisplay(buffer, refreshX, y, refreshXEnd, refreshYEnd);
-    free(buffer);
-}
-
 // ============================================================
 // DISPLAY FUNCTIONS
 // ============================================================
@@ -328,8 +226,8 @@ void drawFullScreen() {
     // Draw buttons
     drawButtons();
 
-    // Full display update
-    EPD_4IN2_V2_Display(BlackImage);
+    // Full display update (asynchronous; loop() polls it)
+    display.beginFullRefresh();
 
     // Update tracking state
     lastTens = tens;
@@ -362,11 +260,6 @@ void updateDigits() {
         drawDigit(TENS_X, TENS_Y, tens);
         drawDigit(ONES_X, ONES_Y, ones);
 
-        // Partial refresh both digits together (same as simple_timer)
-        partialRefresh(TENS_X - 5, TENS_Y - 5,
-                      (ONES_X - TENS_X) + DIGIT_WIDTH + 10,
-                      DIGIT_HEIGHT + 10);
-
         lastTens = tens;
         lastOnes = ones;
     }
@@ -395,9 +288,6 @@ void updateProgressSquares() {
             drawProgressSquare(i, false);
         }
 
-        // Partial refresh border area (entire ring, same as simple_timer)
-        partialRefresh(BORDER_X, BORDER_Y, BORDER_W, BORDER_H);
-
         lastSecond = currentSecond;
     }
 }
@@ -410,9 +300,6 @@ void updateStartButton() {
 
     // Draw the new label
     Paint_DrawString_EN(BTN_START_X, BUTTON_Y, isRunning ? "PAUSE" : "START", &Font16, WHITE, BLACK);
-
-    // Partial refresh only the button area (below BORDER region)
-    partialRefresh(BTN_START_X - 8, BUTTON_Y - 6, 104, 34);
 }
 
 // ============================================================
@@ -440,6 +327,7 @@ void handleStartPause() {
 
     // Update only the button display
     updateStartButton();
+    display.markDirty(LATENCY_INTERACTIVE_MS);
 
     // Reset lastUpdate again after button refresh to prevent immediate timer tick
     if (isRunning) {
@@ -466,6 +354,7 @@ void handleMode() {
     updateDigits();
     updateProgressSquares();
     updateStartButton();
+    display.markDirty(LATENCY_INTERACTIVE_MS);
 
     Serial.printf("Mode changed to %d minutes\n", TIMER_MODES[timerModeIndex]);
 }
@@ -481,26 +370,11 @@ void handleReset() {
 
     Serial.println("Timer RESET to initial state");
 
-    // Re-initialize the display to clear any partial refresh state
-    EPD_4IN2_V2_Init();
-    delay(100);
-
-    // Hardware clear the display
-    EPD_4IN2_V2_Clear();
-    delay(500);  // Longer delay to ensure clear completes
-
-    // Clear the entire frame buffer to white
-    UWORD bufSize = ((SCREEN_WIDTH % 8 == 0) ? (SCREEN_WIDTH / 8) : (SCREEN_WIDTH / 8 + 1)) * SCREEN_HEIGHT;
-    memset(BlackImage, 0xFF, bufSize);
-
-    // Re-select the image buffer
-    Paint_SelectImage(BlackImage);
-    Paint_Clear(WHITE);
-
-    // Now draw fresh content
+    // Redraw from scratch; the full refresh cleans any ghosting and runs
+    // while loop() keeps polling
     drawFullScreen();
 
-    Serial.println("Reset complete - display cleared and redrawn");
+    Serial.println("Reset started - display redrawing");
 }
 
 // ============================================================
@@ -562,29 +436,23 @@ void setup() {
     // Initialize RTC
     rtcInit();
 
-    // Initialize display
-    if (DEV_Module_Init() != 0) {
+    // Initialize display (landscape, frame buffer owned by WatcherDisplay)
+    if (!display.begin(false, ROTATE_0)) {
         Serial.println("ERROR: Display init failed!");
         while (1) delay(1000);
     }
+    BlackImage = display.getBuffer();
 
-    EPD_4IN2_V2_Init();
+    // Partials carry the previous frame, so the tick loop never needs a
+    // full flash; what ghosting is left is cleaned per tile, when idle
+    display.setDifferentialRefresh(true, 0);
+    display.setTileCleaning(true);
+    display.setDeferredMaintenance(true);
 
-    // Allocate frame buffer
-    UWORD bufSize = ((SCREEN_WIDTH % 8 == 0) ? (SCREEN_WIDTH / 8) : (SCREEN_WIDTH / 8 + 1)) * SCREEN_HEIGHT;
-    BlackImage = (UBYTE*)malloc(bufSize);
-
-    if (!BlackImage) {
-        Serial.println("ERROR: Buffer allocation failed!");
-        while (1) delay(1000);
-    }
-
-    // Clear display
-    EPD_4IN2_V2_Clear();
-    delay(500);
+    // Clear display (buffer, panel and shadow)
+    display.clear();
 
     // Initialize paint
-    Paint_NewImage(BlackImage, SCREEN_WIDTH, SCREEN_HEIGHT, 0, WHITE);
     Paint_SelectImage(BlackImage);
 
     // Calculate square positions (same as simple_timer)
@@ -603,6 +471,9 @@ void setup() {
 // MAIN LOOP
 // ============================================================
 void loop() {
+    // Advance any running refresh (non-blocking)
+    display.poll();
+
     // Check buttons
     checkButtons();
 
@@ -616,19 +487,39 @@ void loop() {
             remainingSeconds--;
             elapsedSeconds++;
 
-            // Update display using separate partial refreshes
+            // Update display (separate regions, one batched partial refresh);
+            // a tick may wait for the next one, so two share a waveform
             updateDigits();
             updateProgressSquares();
 
+            // The ring just wrapped: show it now, and a clean until the
+            // next tick goes unnoticed
+            if (elapsedSeconds % 60 == 0) {
+                display.markDirty(LATENCY_INTERACTIVE_MS);
+                display.declareIdleWindow(1000);
+            } else {
+                display.markDirty(LATENCY_PROGRESS_MS);
+            }
+
             Serial.printf("Time: %02d:%02d (elapsed: %ds)\n",
                          remainingSeconds / 60, remainingSeconds % 60, elapsedSeconds);
         } else {
             // Timer complete
             isRunning = false;
             updateStartButton();
+            display.markDirty(LATENCY_INTERACTIVE_MS);
             Serial.println("\n*** TIMER COMPLETE! ***\n");
         }
     }
 
+    // Show what is due, and whatever else is pending with it, refreshing
+    // only the bytes that changed (one square of the ring per tick, not
+    // the whole ring) with a single waveform
+    display.serviceUpdates();
+
+    // Clean ghosted tiles if they are due and nothing is counting
+    display.setIdle(!isRunning);
+    display.maintainDisplay();
+
     delay(50);
 }
@@ -0,0 +1,597 @@
+/**
+ * Pomodoro UI assets - rasterized at compile time from the assets/Pomodoro SVGs
+ *
+ * The path data below is copied verbatim from the Figma exports, so a
+ * redesigned shape only needs its new "d" attribute pasted here. The
+ * digits keep the whole-pixel outlines pomodoro has always drawn. Every
+ * asset ends up as a packed 1bpp table in flash (see VectorAsset.h) with
+ * its ink bounding box; nothing is rasterized on the device.
+ */
+
+#ifndef POMODORO_ASSETS_H
+#define POMODORO_ASSETS_H
+
+#include "VectorAsset.h"
+
+// ============================================================
+// 7-SEGMENT DIGITS (ONES.svg / TENS.svg geometry, rounded to whole pixels)
+// ============================================================
+// The outlines pomodoro drew with Paint_DrawPolygon before the digits moved
+// to flash, filled with the same arithmetic so the tables match that
+// output pixel for pixel. Edges land on x = 70 and y = 130 inclusive.
+#define ASSET_DIGIT_WIDTH  71
+#define ASSET_DIGIT_HEIGHT 131
+
+constexpr int16_t SEGMENT_X[7][7] = {
+    { 1, 70, 57, 13, 1 },               // A top
+    { 70, 70, 59, 59, 70 },             // B top right
+    { 70, 70, 59, 59, 70 },             // C bottom right
+    { 67, 3, 13, 57, 67 },              // D bottom
+    { 0, 0, 11, 11, 0 },                // E bottom left
+    { 0, 0, 11, 11, 0 },                // F top left
+    { 11, 59, 69, 59, 11, 2, 11 }       // G middle
+};
+constexpr int16_t SEGMENT_Y[7][7] = {
+    { 0, 0, 11, 11, 0 },
+    { 3, 64, 57, 13, 3 },
+    { 67, 129, 118, 73, 67 },
+    { 130, 130, 119, 119, 130 },
+    { 129, 66, 73, 117, 129 },
+    { 64, 3, 13, 57, 64 },
+    { 60, 60, 65, 70, 70, 65, 60 }
+};
+constexpr uint8_t SEGMENT_POINTS[7] = { 5, 5, 5, 5, 5, 5, 7 };
+
+// Segments lit per digit, bit 0 = A ... bit 6 = G
+constexpr uint8_t SEGMENT_MASKS[10] = {
+    0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F
+};
+
+constexpr VectorAsset<ASSET_DIGIT_WIDTH, ASSET_DIGIT_HEIGHT> rasterizeDigit(uint8_t digit) {
+    VectorPolygon segments[7] = {};
+    size_t count = 0;
+    for (uint8_t s = 0; s < 7; s++) {
+        if (SEGMENT_MASKS[digit] & (1 << s))
+            segments[count++] = { SEGMENT_X[s], SEGMENT_Y[s], SEGMENT_POINTS[s] };
+    }
+    return vectorRasterizePolygons<ASSET_DIGIT_WIDTH, ASSET_DIGIT_HEIGHT>(segments, count);
+}
+
+constexpr VectorAsset<ASSET_DIGIT_WIDTH, ASSET_DIGIT_HEIGHT> ASSET_DIGITS[10] = {
+    rasterizeDigit(0), rasterizeDigit(1), rasterizeDigit(2), rasterizeDigit(3), rasterizeDigit(4),
+    rasterizeDigit(5), rasterizeDigit(6), rasterizeDigit(7), rasterizeDigit(8), rasterizeDigit(9)
+};
+
+// ============================================================
+// ICONS
+// ============================================================
+
+// START.svg (16x16)
+constexpr auto ASSET_START = vectorRasterize<16, 16>(
+    "M14.6421 6.28534C15.9363 7.06225 15.9364 8.93822 14.6421 9.71501L5.52873 15.1828"
+    "C4.19583 15.9822 2.50067 15.0222 2.50039 13.4679L2.50039 2.53242"
+    "C2.5004 0.977902 4.1957 0.0179235 5.52873 0.817588L14.6421 6.28534Z");
+
+// PAUSE.svg (13x13)
+constexpr auto ASSET_PAUSE = vectorRasterize<13, 13>(
+    "M3.5 0C4.32843 3.22128e-08 5 0.671573 5 1.5V11.5C5 12.3284 4.32843 13 3.5 13H1.5"
+    "C0.671573 13 0 12.3284 0 11.5V1.5C1.69118e-07 0.671573 0.671573 3.22128e-08 1.5 0"
+    "H3.5ZM11.5 0C12.3284 3.22128e-08 13 0.671573 13 1.5V11.5"
+    "C13 12.3284 12.3284 13 11.5 13H9.5C8.67157 13 8 12.3284 8 11.5V1.5"
+    "C8 0.671573 8.67157 3.22128e-08 9.5 0H11.5Z");
+
+// STOP.svg (13x13)
+constexpr auto ASSET_STOP = vectorRasterize<13, 13>(
+    "M3 0C1.34315 0 0 1.34315 0 3V10C0 11.6569 1.34315 13 3 13H10"
+    "C11.6569 13 13 11.6569 13 10V3C13 1.34315 11.6569 0 10 0H3Z", FILL_RULE_EVEN_ODD);
+
+// RESET.svg (16x16)
+constexpr auto ASSET_RESET = vectorRasterize<16, 16>(
+    "M8 1.5C4.41015 1.5 1.5 4.41015 1.5 8C1.5 11.5899 4.41015 14.5 8 14.5"
+    "C11.3026 14.5 14.0288 12.0377 14.445 8.8484"
+    "C14.4986 8.43767 14.2091 8.06126 13.7984 8.00766"
+    "C13.3877 7.95405 13.0113 8.24357 12.9577 8.6543C12.6377 11.1063 10.5394 13 8 13"
+    "C5.23858 13 3 10.7614 3 8C3 5.23858 5.23858 3 8 3"
+    "C9.39838 3 10.6626 3.57344 11.5708 4.5H10.25C9.83579 4.5 9.5 4.83579 9.5 5.25"
+    "C9.5 5.66421 9.83579 6 10.25 6H13.25C13.6642 6 14 5.66421 14 5.25V2.25"
+    "C14 1.83579 13.6642 1.5 13.25 1.5C12.8358 1.5 12.5 1.83579 12.5 2.25V3.30964"
+    "C11.3327 2.1896 9.74678 1.5 8 1.5Z", FILL_RULE_EVEN_ODD);
+
+// ============================================================
+// MODE LABELS
+// *_T.svg is the bare label; the plain name is the selected state,
+// the label cut out of a black pill (<rect rx="12">, as a path here)
+// ============================================================
+
+// FOCUS_T.svg (45x18)
+constexpr auto ASSET_FOCUS_LABEL = vectorRasterize<45, 18>(
+    "M2.7168 5.46729V14H0.95166V5.46729H2.7168ZM6.41553 9.09277V10.499H2.24072V9.09277"
+    "H6.41553ZM6.8916 5.46729V6.87354H2.24072V5.46729H6.8916ZM16.4829 9.53223V9.94238"
+    "C16.4829 10.5918 16.3901 11.1729 16.2046 11.6855"
+    "C16.019 12.1982 15.7554 12.6377 15.4136 13.0039"
+    "C15.0767 13.3652 14.6714 13.6411 14.1978 13.8315"
+    "C13.7241 14.022 13.2017 14.1172 12.6304 14.1172"
+    "C12.0591 14.1172 11.5366 14.022 11.063 13.8315"
+    "C10.5894 13.6411 10.1792 13.3652 9.83252 13.0039"
+    "C9.48584 12.6377 9.21729 12.1982 9.02686 11.6855"
+    "C8.84131 11.1729 8.74854 10.5918 8.74854 9.94238V9.53223"
+    "C8.74854 8.88281 8.84131 8.30176 9.02686 7.78906"
+    "C9.21729 7.27637 9.4834 6.83691 9.8252 6.4707"
+    "C10.167 6.10449 10.5747 5.82617 11.0483 5.63574"
+    "C11.522 5.44531 12.0444 5.3501 12.6157 5.3501"
+    "C13.1919 5.3501 13.7144 5.44531 14.1831 5.63574"
+    "C14.6567 5.82617 15.0645 6.10449 15.4062 6.4707"
+    "C15.7529 6.83691 16.019 7.27637 16.2046 7.78906"
+    "C16.3901 8.30176 16.4829 8.88281 16.4829 9.53223ZM14.7178 9.94238V9.51758"
+    "C14.7178 9.07324 14.6714 8.68018 14.5786 8.33838"
+    "C14.4858 7.99658 14.3467 7.7085 14.1611 7.47412"
+    "C13.9805 7.23975 13.7607 7.06152 13.502 6.93945"
+    "C13.2432 6.81738 12.9478 6.75635 12.6157 6.75635"
+    "C12.2886 6.75635 11.9932 6.81738 11.7295 6.93945"
+    "C11.4707 7.06152 11.251 7.23975 11.0703 7.47412"
+    "C10.8945 7.7085 10.7578 7.99658 10.6602 8.33838"
+    "C10.5674 8.68018 10.521 9.07324 10.521 9.51758V9.94238"
+    "C10.521 10.3818 10.5674 10.7749 10.6602 11.1216"
+    "C10.7578 11.4634 10.897 11.7539 11.0776 11.9932"
+    "C11.2632 12.2275 11.4854 12.4082 11.7441 12.5352"
+    "C12.0078 12.6572 12.3032 12.7183 12.6304 12.7183"
+    "C12.9624 12.7183 13.2554 12.6572 13.5093 12.5352"
+    "C13.7681 12.4082 13.9878 12.2275 14.1685 11.9932"
+    "C14.3491 11.7539 14.4858 11.4634 14.5786 11.1216"
+    "C14.6714 10.7749 14.7178 10.3818 14.7178 9.94238ZM24.2798 11.1582H26.0522"
+    "C26.0083 11.7393 25.8374 12.252 25.5396 12.6963"
+    "C25.2466 13.1406 24.8364 13.4897 24.3091 13.7437"
+    "C23.7817 13.9927 23.1445 14.1172 22.3975 14.1172"
+    "C21.8164 14.1172 21.2939 14.022 20.8301 13.8315"
+    "C20.3711 13.6411 19.978 13.3701 19.6509 13.0186"
+    "C19.3286 12.6621 19.0796 12.2324 18.9038 11.7295"
+    "C18.7329 11.2217 18.6475 10.6528 18.6475 10.0229V9.45166"
+    "C18.6475 8.82178 18.7354 8.25537 18.9111 7.75244"
+    "C19.0869 7.24463 19.3408 6.8125 19.6729 6.45605"
+    "C20.0049 6.09473 20.4004 5.82129 20.8594 5.63574"
+    "C21.3232 5.44531 21.8433 5.3501 22.4194 5.3501"
+    "C23.1763 5.3501 23.8135 5.47949 24.3311 5.73828"
+    "C24.8486 5.99219 25.2515 6.34619 25.5396 6.80029"
+    "C25.8276 7.25439 26.001 7.77441 26.0596 8.36035H24.2944"
+    "C24.2651 8.04297 24.1846 7.76465 24.0527 7.52539"
+    "C23.9209 7.28125 23.7231 7.09082 23.4595 6.9541"
+    "C23.1958 6.81738 22.8491 6.74902 22.4194 6.74902"
+    "C22.0874 6.74902 21.7969 6.80762 21.5479 6.9248"
+    "C21.2988 7.03711 21.0889 7.20801 20.918 7.4375"
+    "C20.752 7.66699 20.625 7.9502 20.5371 8.28711"
+    "C20.4541 8.61914 20.4126 9.00488 20.4126 9.44434V10.0229"
+    "C20.4126 10.4526 20.4492 10.8359 20.5225 11.1729"
+    "C20.6006 11.5049 20.7202 11.7856 20.8813 12.0151"
+    "C21.0425 12.2446 21.2476 12.4204 21.4966 12.5425"
+    "C21.7505 12.6597 22.0508 12.7183 22.3975 12.7183"
+    "C22.8125 12.7183 23.1519 12.6621 23.4155 12.5498"
+    "C23.6792 12.4326 23.8818 12.2568 24.0234 12.0225"
+    "C24.165 11.7881 24.2505 11.5 24.2798 11.1582ZM33.4683 5.46729H35.2407V11.0923"
+    "C35.2407 11.7466 35.0894 12.3008 34.7866 12.7549"
+    "C34.4839 13.2041 34.0713 13.5435 33.5488 13.7729"
+    "C33.0264 14.0024 32.4307 14.1172 31.7617 14.1172"
+    "C31.083 14.1172 30.48 14.0024 29.9526 13.7729"
+    "C29.4302 13.5435 29.02 13.2041 28.7222 12.7549"
+    "C28.4243 12.3008 28.2754 11.7466 28.2754 11.0923V5.46729H30.0332V11.0923"
+    "C30.0332 11.4683 30.1016 11.7783 30.2383 12.0225"
+    "C30.3799 12.2617 30.5801 12.4375 30.8389 12.5498"
+    "C31.0977 12.6621 31.4053 12.7183 31.7617 12.7183"
+    "C32.1182 12.7183 32.4233 12.6621 32.6772 12.5498"
+    "C32.9312 12.4375 33.1265 12.2617 33.2632 12.0225"
+    "C33.3999 11.7783 33.4683 11.4683 33.4683 11.0923V5.46729ZM42.6714 11.7661"
+    "C42.6714 11.605 42.6421 11.4609 42.5835 11.334"
+    "C42.5298 11.207 42.4346 11.0923 42.2979 10.9897"
+    "C42.166 10.8823 41.9829 10.7822 41.7485 10.6895"
+    "C41.519 10.5967 41.2285 10.5088 40.877 10.4258"
+    "C40.3691 10.3037 39.9199 10.167 39.5293 10.0156"
+    "C39.1436 9.85938 38.8188 9.67871 38.5552 9.47363"
+    "C38.2915 9.26855 38.0913 9.02686 37.9546 8.74854"
+    "C37.8228 8.47021 37.7568 8.14551 37.7568 7.77441"
+    "C37.7568 7.41797 37.835 7.09326 37.9912 6.80029"
+    "C38.1475 6.50244 38.3696 6.24609 38.6577 6.03125"
+    "C38.9458 5.81152 39.2876 5.64307 39.6831 5.52588"
+    "C40.0786 5.40869 40.5132 5.3501 40.9868 5.3501"
+    "C41.6753 5.3501 42.2734 5.4624 42.7812 5.68701"
+    "C43.2891 5.91162 43.6821 6.22168 43.9604 6.61719"
+    "C44.2437 7.00781 44.3853 7.46191 44.3853 7.97949H42.6201"
+    "C42.6201 7.73535 42.5566 7.51562 42.4297 7.32031"
+    "C42.3076 7.125 42.127 6.96875 41.8877 6.85156"
+    "C41.6484 6.73438 41.3481 6.67578 40.9868 6.67578"
+    "C40.6401 6.67578 40.3545 6.72705 40.1299 6.82959"
+    "C39.9053 6.92725 39.7368 7.05664 39.6245 7.21777"
+    "C39.5171 7.37402 39.4634 7.54492 39.4634 7.73047"
+    "C39.4634 7.87695 39.4951 8.00879 39.5586 8.12598"
+    "C39.627 8.24316 39.7344 8.35059 39.8809 8.44824"
+    "C40.0273 8.5459 40.2178 8.63867 40.4521 8.72656"
+    "C40.6865 8.81445 40.9722 8.8999 41.3091 8.98291"
+    "C41.812 9.1001 42.2563 9.23926 42.6421 9.40039"
+    "C43.0278 9.56152 43.3501 9.75195 43.6089 9.97168"
+    "C43.8677 10.1865 44.0605 10.4404 44.1875 10.7334"
+    "C44.3193 11.0215 44.3853 11.3511 44.3853 11.7222"
+    "C44.3853 12.0981 44.3071 12.4351 44.1509 12.7329"
+    "C43.9946 13.0259 43.77 13.2749 43.4771 13.48"
+    "C43.189 13.6851 42.8423 13.8438 42.437 13.9561"
+    "C42.0317 14.0635 41.5801 14.1172 41.082 14.1172"
+    "C40.6426 14.1172 40.2056 14.0635 39.771 13.9561"
+    "C39.3413 13.8486 38.9531 13.6826 38.6064 13.458"
+    "C38.2598 13.2334 37.9814 12.9478 37.7715 12.6011"
+    "C37.5664 12.2495 37.4639 11.8369 37.4639 11.3633H39.2363"
+    "C39.2363 11.6172 39.2803 11.8369 39.3682 12.0225"
+    "C39.4609 12.2031 39.5903 12.3521 39.7563 12.4692"
+    "C39.9272 12.5815 40.1299 12.6646 40.3643 12.7183"
+    "C40.5986 12.772 40.8574 12.7988 41.1406 12.7988"
+    "C41.4971 12.7988 41.7876 12.7524 42.0122 12.6597"
+    "C42.2417 12.562 42.4077 12.4351 42.5103 12.2788"
+    "C42.6177 12.1226 42.6714 11.9517 42.6714 11.7661Z");
+
+// FOCUS.svg (75x24)
+constexpr VectorLayer FOCUS_PILL_LAYERS[] = {
+    { "M12 0H63C69.6274 0 75 5.3726 75 12C75 18.6274 69.6274 24 63 24H12C5.3726 24 0 18.6274 0 12C0 5.3726 5.3726 0 12 0Z",
+      true, FILL_RULE_NONZERO },
+    {
+        "M17.7168 8.46729V17H15.9517V8.46729H17.7168ZM21.4155 12.0928V13.499H17.2407V12.0928"
+        "H21.4155ZM21.8916 8.46729V9.87354H17.2407V8.46729H21.8916ZM31.4829 12.5322V12.9424"
+        "C31.4829 13.5918 31.3901 14.1729 31.2046 14.6855"
+        "C31.019 15.1982 30.7554 15.6377 30.4136 16.0039"
+        "C30.0767 16.3652 29.6714 16.6411 29.1978 16.8315"
+        "C28.7241 17.022 28.2017 17.1172 27.6304 17.1172"
+        "C27.0591 17.1172 26.5366 17.022 26.063 16.8315"
+        "C25.5894 16.6411 25.1792 16.3652 24.8325 16.0039"
+        "C24.4858 15.6377 24.2173 15.1982 24.0269 14.6855"
+        "C23.8413 14.1729 23.7485 13.5918 23.7485 12.9424V12.5322"
+        "C23.7485 11.8828 23.8413 11.3018 24.0269 10.7891"
+        "C24.2173 10.2764 24.4834 9.83691 24.8252 9.4707"
+        "C25.167 9.10449 25.5747 8.82617 26.0483 8.63574"
+        "C26.522 8.44531 27.0444 8.3501 27.6157 8.3501"
+        "C28.1919 8.3501 28.7144 8.44531 29.1831 8.63574"
+        "C29.6567 8.82617 30.0645 9.10449 30.4062 9.4707"
+        "C30.7529 9.83691 31.019 10.2764 31.2046 10.7891"
+        "C31.3901 11.3018 31.4829 11.8828 31.4829 12.5322ZM29.7178 12.9424V12.5176"
+        "C29.7178 12.0732 29.6714 11.6802 29.5786 11.3384"
+        "C29.4858 10.9966 29.3467 10.7085 29.1611 10.4741"
+        "C28.9805 10.2397 28.7607 10.0615 28.502 9.93945"
+        "C28.2432 9.81738 27.9478 9.75635 27.6157 9.75635"
+        "C27.2886 9.75635 26.9932 9.81738 26.7295 9.93945"
+        "C26.4707 10.0615 26.251 10.2397 26.0703 10.4741"
+        "C25.8945 10.7085 25.7578 10.9966 25.6602 11.3384"
+        "C25.5674 11.6802 25.521 12.0732 25.521 12.5176V12.9424"
+        "C25.521 13.3818 25.5674 13.7749 25.6602 14.1216"
+        "C25.7578 14.4634 25.897 14.7539 26.0776 14.9932"
+        "C26.2632 15.2275 26.4854 15.4082 26.7441 15.5352"
+        "C27.0078 15.6572 27.3032 15.7183 27.6304 15.7183"
+        "C27.9624 15.7183 28.2554 15.6572 28.5093 15.5352"
+        "C28.7681 15.4082 28.9878 15.2275 29.1685 14.9932"
+        "C29.3491 14.7539 29.4858 14.4634 29.5786 14.1216"
+        "C29.6714 13.7749 29.7178 13.3818 29.7178 12.9424ZM39.2798 14.1582H41.0522"
+        "C41.0083 14.7393 40.8374 15.252 40.5396 15.6963"
+        "C40.2466 16.1406 39.8364 16.4897 39.3091 16.7437"
+        "C38.7817 16.9927 38.1445 17.1172 37.3975 17.1172"
+        "C36.8164 17.1172 36.2939 17.022 35.8301 16.8315"
+        "C35.3711 16.6411 34.978 16.3701 34.6509 16.0186"
+        "C34.3286 15.6621 34.0796 15.2324 33.9038 14.7295"
+        "C33.7329 14.2217 33.6475 13.6528 33.6475 13.0229V12.4517"
+        "C33.6475 11.8218 33.7354 11.2554 33.9111 10.7524"
+        "C34.0869 10.2446 34.3408 9.8125 34.6729 9.45605"
+        "C35.0049 9.09473 35.4004 8.82129 35.8594 8.63574"
+        "C36.3232 8.44531 36.8433 8.3501 37.4194 8.3501"
+        "C38.1763 8.3501 38.8135 8.47949 39.3311 8.73828"
+        "C39.8486 8.99219 40.2515 9.34619 40.5396 9.80029"
+        "C40.8276 10.2544 41.001 10.7744 41.0596 11.3604H39.2944"
+        "C39.2651 11.043 39.1846 10.7646 39.0527 10.5254"
+        "C38.9209 10.2812 38.7231 10.0908 38.4595 9.9541"
+        "C38.1958 9.81738 37.8491 9.74902 37.4194 9.74902"
+        "C37.0874 9.74902 36.7969 9.80762 36.5479 9.9248"
+        "C36.2988 10.0371 36.0889 10.208 35.918 10.4375"
+        "C35.752 10.667 35.625 10.9502 35.5371 11.2871"
+        "C35.4541 11.6191 35.4126 12.0049 35.4126 12.4443V13.0229"
+        "C35.4126 13.4526 35.4492 13.8359 35.5225 14.1729"
+        "C35.6006 14.5049 35.7202 14.7856 35.8813 15.0151"
+        "C36.0425 15.2446 36.2476 15.4204 36.4966 15.5425"
+        "C36.7505 15.6597 37.0508 15.7183 37.3975 15.7183"
+        "C37.8125 15.7183 38.1519 15.6621 38.4155 15.5498"
+        "C38.6792 15.4326 38.8818 15.2568 39.0234 15.0225"
+        "C39.165 14.7881 39.2505 14.5 39.2798 14.1582ZM48.4683 8.46729H50.2407V14.0923"
+        "C50.2407 14.7466 50.0894 15.3008 49.7866 15.7549"
+        "C49.4839 16.2041 49.0713 16.5435 48.5488 16.7729"
+        "C48.0264 17.0024 47.4307 17.1172 46.7617 17.1172"
+        "C46.083 17.1172 45.48 17.0024 44.9526 16.7729"
+        "C44.4302 16.5435 44.02 16.2041 43.7222 15.7549"
+        "C43.4243 15.3008 43.2754 14.7466 43.2754 14.0923V8.46729H45.0332V14.0923"
+        "C45.0332 14.4683 45.1016 14.7783 45.2383 15.0225"
+        "C45.3799 15.2617 45.5801 15.4375 45.8389 15.5498"
+        "C46.0977 15.6621 46.4053 15.7183 46.7617 15.7183"
+        "C47.1182 15.7183 47.4233 15.6621 47.6772 15.5498"
+        "C47.9312 15.4375 48.1265 15.2617 48.2632 15.0225"
+        "C48.3999 14.7783 48.4683 14.4683 48.4683 14.0923V8.46729ZM57.6714 14.7661"
+        "C57.6714 14.605 57.6421 14.4609 57.5835 14.334"
+        "C57.5298 14.207 57.4346 14.0923 57.2979 13.9897"
+        "C57.166 13.8823 56.9829 13.7822 56.7485 13.6895"
+        "C56.519 13.5967 56.2285 13.5088 55.877 13.4258"
+        "C55.3691 13.3037 54.9199 13.167 54.5293 13.0156"
+        "C54.1436 12.8594 53.8188 12.6787 53.5552 12.4736"
+        "C53.2915 12.2686 53.0913 12.0269 52.9546 11.7485"
+        "C52.8228 11.4702 52.7568 11.1455 52.7568 10.7744"
+        "C52.7568 10.418 52.835 10.0933 52.9912 9.80029"
+        "C53.1475 9.50244 53.3696 9.24609 53.6577 9.03125"
+        "C53.9458 8.81152 54.2876 8.64307 54.6831 8.52588"
+        "C55.0786 8.40869 55.5132 8.3501 55.9868 8.3501"
+        "C56.6753 8.3501 57.2734 8.4624 57.7812 8.68701"
+        "C58.2891 8.91162 58.6821 9.22168 58.9604 9.61719"
+        "C59.2437 10.0078 59.3853 10.4619 59.3853 10.9795H57.6201"
+        "C57.6201 10.7354 57.5566 10.5156 57.4297 10.3203"
+        "C57.3076 10.125 57.127 9.96875 56.8877 9.85156"
+        "C56.6484 9.73438 56.3481 9.67578 55.9868 9.67578"
+        "C55.6401 9.67578 55.3545 9.72705 55.1299 9.82959"
+        "C54.9053 9.92725 54.7368 10.0566 54.6245 10.2178"
+        "C54.5171 10.374 54.4634 10.5449 54.4634 10.7305"
+        "C54.4634 10.877 54.4951 11.0088 54.5586 11.126"
+        "C54.627 11.2432 54.7344 11.3506 54.8809 11.4482"
+        "C55.0273 11.5459 55.2178 11.6387 55.4521 11.7266"
+        "C55.6865 11.8145 55.9722 11.8999 56.3091 11.9829"
+        "C56.812 12.1001 57.2563 12.2393 57.6421 12.4004"
+        "C58.0278 12.5615 58.3501 12.752 58.6089 12.9717"
+        "C58.8677 13.1865 59.0605 13.4404 59.1875 13.7334"
+        "C59.3193 14.0215 59.3853 14.3511 59.3853 14.7222"
+        "C59.3853 15.0981 59.3071 15.4351 59.1509 15.7329"
+        "C58.9946 16.0259 58.77 16.2749 58.4771 16.48"
+        "C58.189 16.6851 57.8423 16.8438 57.437 16.9561"
+        "C57.0317 17.0635 56.5801 17.1172 56.082 17.1172"
+        "C55.6426 17.1172 55.2056 17.0635 54.771 16.9561"
+        "C54.3413 16.8486 53.9531 16.6826 53.6064 16.458"
+        "C53.2598 16.2334 52.9814 15.9478 52.7715 15.6011"
+        "C52.5664 15.2495 52.4639 14.8369 52.4639 14.3633H54.2363"
+        "C54.2363 14.6172 54.2803 14.8369 54.3682 15.0225"
+        "C54.4609 15.2031 54.5903 15.3521 54.7563 15.4692"
+        "C54.9272 15.5815 55.1299 15.6646 55.3643 15.7183"
+        "C55.5986 15.772 55.8574 15.7988 56.1406 15.7988"
+        "C56.4971 15.7988 56.7876 15.7524 57.0122 15.6597"
+        "C57.2417 15.562 57.4077 15.4351 57.5103 15.2788"
+        "C57.6177 15.1226 57.6714 14.9517 57.6714 14.7661Z",
+      false, FILL_RULE_NONZERO }
+};
+constexpr auto ASSET_FOCUS_PILL = vectorRasterize<75, 24>(FOCUS_PILL_LAYERS);
+
+// BREAK_T.svg (45x18)
+constexpr auto ASSET_BREAK_LABEL = vectorRasterize<45, 18>(
+    "M4.63574 10.272H2.27734L2.2627 9.05615H4.36475"
+    "C4.68213 9.05615 4.95068 9.01465 5.17041 8.93164"
+    "C5.39014 8.84863 5.55615 8.729 5.66846 8.57275"
+    "C5.78564 8.41162 5.84424 8.21631 5.84424 7.98682"
+    "C5.84424 7.72803 5.78809 7.51562 5.67578 7.34961"
+    "C5.56348 7.18359 5.39502 7.06396 5.17041 6.99072"
+    "C4.9458 6.9126 4.66748 6.87354 4.33545 6.87354H2.87061V14H1.10547V5.46729H4.24023"
+    "C4.76758 5.46729 5.23633 5.51611 5.64648 5.61377"
+    "C6.06152 5.70654 6.41553 5.84814 6.7085 6.03857"
+    "C7.00146 6.229 7.22363 6.47314 7.375 6.771"
+    "C7.53125 7.06396 7.60938 7.41064 7.60938 7.81104"
+    "C7.60938 8.15771 7.52148 8.47998 7.3457 8.77783"
+    "C7.1748 9.07568 6.91113 9.31738 6.55469 9.50293"
+    "C6.19824 9.68848 5.73682 9.79102 5.17041 9.81055L4.63574 10.272ZM4.55518 14H1.7793"
+    "L2.49707 12.6011H4.55518C4.89697 12.6011 5.17773 12.5522 5.39746 12.4546"
+    "C5.62207 12.3569 5.78809 12.2251 5.89551 12.0591"
+    "C6.00293 11.8882 6.05664 11.6929 6.05664 11.4731"
+    "C6.05664 11.229 6.00781 11.019 5.91016 10.8433"
+    "C5.81738 10.6626 5.66602 10.5234 5.45605 10.4258"
+    "C5.24609 10.3232 4.97266 10.272 4.63574 10.272H2.83398L2.84131 9.05615H5.12646"
+    "L5.5293 9.53223C6.07129 9.52246 6.51074 9.61768 6.84766 9.81787"
+    "C7.18457 10.0132 7.43115 10.2671 7.5874 10.5796"
+    "C7.74854 10.8921 7.8291 11.2168 7.8291 11.5537"
+    "C7.8291 11.9688 7.75586 12.3301 7.60938 12.6377"
+    "C7.46289 12.9404 7.25049 13.1943 6.97217 13.3994"
+    "C6.69385 13.5996 6.35205 13.751 5.94678 13.8535C5.5415 13.9512 5.07764 14 4.55518 14"
+    "ZM10.3013 5.46729H13.6631C14.1855 5.46729 14.6543 5.52344 15.0693 5.63574"
+    "C15.4844 5.74805 15.8359 5.91406 16.124 6.13379"
+    "C16.417 6.34863 16.6392 6.61719 16.7905 6.93945"
+    "C16.9468 7.25684 17.0249 7.62549 17.0249 8.04541"
+    "C17.0249 8.50928 16.9419 8.90723 16.7759 9.23926"
+    "C16.6099 9.56641 16.3755 9.8374 16.0728 10.0522"
+    "C15.77 10.2671 15.4136 10.4404 15.0034 10.5723L14.4395 10.8799H11.4731"
+    "L11.4585 9.47363H13.6851C14.0366 9.47363 14.3271 9.41992 14.5566 9.3125"
+    "C14.7861 9.20508 14.9595 9.05615 15.0767 8.86572"
+    "C15.1938 8.67041 15.2524 8.4458 15.2524 8.19189"
+    "C15.2524 7.92334 15.1938 7.69141 15.0767 7.49609"
+    "C14.9644 7.2959 14.7886 7.14209 14.5493 7.03467"
+    "C14.3149 6.92725 14.0195 6.87354 13.6631 6.87354H12.0737V14H10.3013V5.46729Z"
+    "M15.4722 14L13.3628 10.2207L15.2305 10.2061L17.3765 13.9194V14H15.4722Z"
+    "M25.6348 12.6011V14H20.7495V12.6011H25.6348ZM21.3062 5.46729V14H19.541V5.46729"
+    "H21.3062ZM25.0049 8.8877V10.2866H20.7495V8.8877H25.0049ZM25.6201 5.46729V6.87354"
+    "H20.7495V5.46729H25.6201ZM31.3516 7.21777L28.7881 14H27.001L30.436 5.46729H31.6226"
+    "L31.3516 7.21777ZM33.7173 14L31.1392 7.20312L30.8682 5.46729H32.0767L35.5044 14"
+    "H33.7173ZM33.6074 10.8359V12.1616H28.7295V10.8359H33.6074ZM39.1997 5.46729V14"
+    "H37.4346V5.46729H39.1997ZM44.6709 5.46729L41.0381 9.70068L38.9873 11.7002"
+    "L38.5771 10.0449L40.0273 8.27246L42.4736 5.46729H44.6709ZM42.7153 14L39.8955 10.0669"
+    "L41.1846 8.97559L44.8247 14H42.7153Z");
+
+// BREAK.svg (75x24)
+constexpr VectorLayer BREAK_PILL_LAYERS[] = {
+    { "M12 0H63C69.6274 0 75 5.3726 75 12C75 18.6274 69.6274 24 63 24H12C5.3726 24 0 18.6274 0 12C0 5.3726 5.3726 0 12 0Z",
+      true, FILL_RULE_NONZERO },
+    {
+        "M19.6357 13.272H17.2773L17.2627 12.0562H19.3647"
+        "C19.6821 12.0562 19.9507 12.0146 20.1704 11.9316"
+        "C20.3901 11.8486 20.5562 11.729 20.6685 11.5728"
+        "C20.7856 11.4116 20.8442 11.2163 20.8442 10.9868"
+        "C20.8442 10.728 20.7881 10.5156 20.6758 10.3496"
+        "C20.5635 10.1836 20.395 10.064 20.1704 9.99072"
+        "C19.9458 9.9126 19.6675 9.87354 19.3354 9.87354H17.8706V17H16.1055V8.46729H19.2402"
+        "C19.7676 8.46729 20.2363 8.51611 20.6465 8.61377"
+        "C21.0615 8.70654 21.4155 8.84814 21.7085 9.03857"
+        "C22.0015 9.229 22.2236 9.47314 22.375 9.771"
+        "C22.5312 10.064 22.6094 10.4106 22.6094 10.811"
+        "C22.6094 11.1577 22.5215 11.48 22.3457 11.7778"
+        "C22.1748 12.0757 21.9111 12.3174 21.5547 12.5029"
+        "C21.1982 12.6885 20.7368 12.791 20.1704 12.8105L19.6357 13.272ZM19.5552 17H16.7793"
+        "L17.4971 15.6011H19.5552C19.897 15.6011 20.1777 15.5522 20.3975 15.4546"
+        "C20.6221 15.3569 20.7881 15.2251 20.8955 15.0591"
+        "C21.0029 14.8882 21.0566 14.6929 21.0566 14.4731"
+        "C21.0566 14.229 21.0078 14.019 20.9102 13.8433"
+        "C20.8174 13.6626 20.666 13.5234 20.4561 13.4258"
+        "C20.2461 13.3232 19.9727 13.272 19.6357 13.272H17.834L17.8413 12.0562H20.1265"
+        "L20.5293 12.5322C21.0713 12.5225 21.5107 12.6177 21.8477 12.8179"
+        "C22.1846 13.0132 22.4312 13.2671 22.5874 13.5796"
+        "C22.7485 13.8921 22.8291 14.2168 22.8291 14.5537"
+        "C22.8291 14.9688 22.7559 15.3301 22.6094 15.6377"
+        "C22.4629 15.9404 22.2505 16.1943 21.9722 16.3994"
+        "C21.6938 16.5996 21.3521 16.751 20.9468 16.8535"
+        "C20.5415 16.9512 20.0776 17 19.5552 17ZM25.3013 8.46729H28.6631"
+        "C29.1855 8.46729 29.6543 8.52344 30.0693 8.63574"
+        "C30.4844 8.74805 30.8359 8.91406 31.124 9.13379"
+        "C31.417 9.34863 31.6392 9.61719 31.7905 9.93945"
+        "C31.9468 10.2568 32.0249 10.6255 32.0249 11.0454"
+        "C32.0249 11.5093 31.9419 11.9072 31.7759 12.2393"
+        "C31.6099 12.5664 31.3755 12.8374 31.0728 13.0522"
+        "C30.77 13.2671 30.4136 13.4404 30.0034 13.5723L29.4395 13.8799H26.4731"
+        "L26.4585 12.4736H28.6851C29.0366 12.4736 29.3271 12.4199 29.5566 12.3125"
+        "C29.7861 12.2051 29.9595 12.0562 30.0767 11.8657"
+        "C30.1938 11.6704 30.2524 11.4458 30.2524 11.1919"
+        "C30.2524 10.9233 30.1938 10.6914 30.0767 10.4961"
+        "C29.9644 10.2959 29.7886 10.1421 29.5493 10.0347"
+        "C29.3149 9.92725 29.0195 9.87354 28.6631 9.87354H27.0737V17H25.3013V8.46729Z"
+        "M30.4722 17L28.3628 13.2207L30.2305 13.2061L32.3765 16.9194V17H30.4722Z"
+        "M40.6348 15.6011V17H35.7495V15.6011H40.6348ZM36.3062 8.46729V17H34.541V8.46729"
+        "H36.3062ZM40.0049 11.8877V13.2866H35.7495V11.8877H40.0049ZM40.6201 8.46729V9.87354"
+        "H35.7495V8.46729H40.6201ZM46.3516 10.2178L43.7881 17H42.001L45.436 8.46729H46.6226"
+        "L46.3516 10.2178ZM48.7173 17L46.1392 10.2031L45.8682 8.46729H47.0767L50.5044 17"
+        "H48.7173ZM48.6074 13.8359V15.1616H43.7295V13.8359H48.6074ZM54.1997 8.46729V17"
+        "H52.4346V8.46729H54.1997ZM59.6709 8.46729L56.0381 12.7007L53.9873 14.7002"
+        "L53.5771 13.0449L55.0273 11.2725L57.4736 8.46729H59.6709ZM57.7153 17L54.8955 13.0669"
+        "L56.1846 11.9756L59.8247 17H57.7153Z",
+      false, FILL_RULE_NONZERO }
+};
+constexpr auto ASSET_BREAK_PILL = vectorRasterize<75, 24>(BREAK_PILL_LAYERS);
+
+// LONG_T.svg (53x18)
+constexpr auto ASSET_LONG_LABEL = vectorRasterize<53, 18>(
+    "M14.9072 12.6011V14H10.2856V12.6011H14.9072ZM10.8423 5.46729V14H9.07715V5.46729"
+    "H10.8423ZM24.3594 9.53223V9.94238C24.3594 10.5918 24.2666 11.1729 24.0811 11.6855"
+    "C23.8955 12.1982 23.6318 12.6377 23.29 13.0039"
+    "C22.9531 13.3652 22.5479 13.6411 22.0742 13.8315"
+    "C21.6006 14.022 21.0781 14.1172 20.5068 14.1172"
+    "C19.9355 14.1172 19.4131 14.022 18.9395 13.8315"
+    "C18.4658 13.6411 18.0557 13.3652 17.709 13.0039"
+    "C17.3623 12.6377 17.0938 12.1982 16.9033 11.6855"
+    "C16.7178 11.1729 16.625 10.5918 16.625 9.94238V9.53223"
+    "C16.625 8.88281 16.7178 8.30176 16.9033 7.78906"
+    "C17.0938 7.27637 17.3599 6.83691 17.7017 6.4707"
+    "C18.0435 6.10449 18.4512 5.82617 18.9248 5.63574"
+    "C19.3984 5.44531 19.9209 5.3501 20.4922 5.3501"
+    "C21.0684 5.3501 21.5908 5.44531 22.0596 5.63574"
+    "C22.5332 5.82617 22.9409 6.10449 23.2827 6.4707"
+    "C23.6294 6.83691 23.8955 7.27637 24.0811 7.78906"
+    "C24.2666 8.30176 24.3594 8.88281 24.3594 9.53223ZM22.5942 9.94238V9.51758"
+    "C22.5942 9.07324 22.5479 8.68018 22.4551 8.33838"
+    "C22.3623 7.99658 22.2231 7.7085 22.0376 7.47412"
+    "C21.8569 7.23975 21.6372 7.06152 21.3784 6.93945"
+    "C21.1196 6.81738 20.8242 6.75635 20.4922 6.75635"
+    "C20.165 6.75635 19.8696 6.81738 19.606 6.93945"
+    "C19.3472 7.06152 19.1274 7.23975 18.9468 7.47412"
+    "C18.771 7.7085 18.6343 7.99658 18.5366 8.33838"
+    "C18.4438 8.68018 18.3975 9.07324 18.3975 9.51758V9.94238"
+    "C18.3975 10.3818 18.4438 10.7749 18.5366 11.1216"
+    "C18.6343 11.4634 18.7734 11.7539 18.9541 11.9932"
+    "C19.1396 12.2275 19.3618 12.4082 19.6206 12.5352"
+    "C19.8843 12.6572 20.1797 12.7183 20.5068 12.7183"
+    "C20.8389 12.7183 21.1318 12.6572 21.3857 12.5352"
+    "C21.6445 12.4082 21.8643 12.2275 22.0449 11.9932"
+    "C22.2256 11.7539 22.3623 11.4634 22.4551 11.1216"
+    "C22.5479 10.7749 22.5942 10.3818 22.5942 9.94238ZM34.1997 5.46729V14H32.4272"
+    "L28.5747 8.11865V14H26.8096V5.46729H28.5747L32.4272 11.3486V5.46729H34.1997Z"
+    "M44.106 9.53223V12.9307C43.9644 13.0918 43.7495 13.2651 43.4614 13.4507"
+    "C43.1733 13.6362 42.7974 13.7949 42.3335 13.9268"
+    "C41.8696 14.0537 41.3008 14.1172 40.627 14.1172"
+    "C40.041 14.1172 39.5063 14.0269 39.0229 13.8462"
+    "C38.5444 13.6606 38.1294 13.3921 37.7778 13.0405"
+    "C37.4263 12.689 37.1553 12.2593 36.9648 11.7515"
+    "C36.7793 11.2388 36.6865 10.6553 36.6865 10.001V9.46631"
+    "C36.6865 8.81201 36.7769 8.23096 36.9575 7.72314"
+    "C37.1382 7.21045 37.3945 6.77832 37.7266 6.42676"
+    "C38.0635 6.0752 38.4663 5.80908 38.9351 5.62842"
+    "C39.4038 5.44287 39.9263 5.3501 40.5024 5.3501"
+    "C41.2837 5.3501 41.9258 5.47217 42.4287 5.71631"
+    "C42.9365 5.95557 43.3247 6.2876 43.5933 6.7124"
+    "C43.8618 7.13721 44.0303 7.62549 44.0986 8.17725H42.3774"
+    "C42.3286 7.88428 42.2358 7.63281 42.0991 7.42285"
+    "C41.9624 7.20801 41.7671 7.04199 41.5132 6.9248"
+    "C41.2642 6.80762 40.9419 6.74902 40.5464 6.74902"
+    "C40.2144 6.74902 39.9165 6.80762 39.6528 6.9248"
+    "C39.394 7.03711 39.1743 7.20801 38.9937 7.4375"
+    "C38.8179 7.66699 38.6836 7.9502 38.5908 8.28711"
+    "C38.5029 8.61914 38.459 9.00732 38.459 9.45166V10.001"
+    "C38.459 10.4453 38.5078 10.8384 38.6055 11.1802"
+    "C38.708 11.5171 38.8545 11.8003 39.0449 12.0298"
+    "C39.2402 12.2593 39.4771 12.4326 39.7554 12.5498"
+    "C40.0386 12.6621 40.3608 12.7183 40.7222 12.7183"
+    "C41.2056 12.7183 41.5693 12.6694 41.8135 12.5718"
+    "C42.0576 12.4692 42.231 12.374 42.3335 12.2861V10.7993H40.4878V9.53223H44.106Z");
+
+// LONG.svg (67x24)
+constexpr VectorLayer LONG_PILL_LAYERS[] = {
+    { "M12 0H55C61.6274 0 67 5.3726 67 12C67 18.6274 61.6274 24 55 24H12C5.3726 24 0 18.6274 0 12C0 5.3726 5.3726 0 12 0Z",
+      true, FILL_RULE_NONZERO },
+    {
+        "M21.9072 15.6011V17H17.2856V15.6011H21.9072ZM17.8423 8.46729V17H16.0771V8.46729"
+        "H17.8423ZM31.3594 12.5322V12.9424C31.3594 13.5918 31.2666 14.1729 31.0811 14.6855"
+        "C30.8955 15.1982 30.6318 15.6377 30.29 16.0039"
+        "C29.9531 16.3652 29.5479 16.6411 29.0742 16.8315"
+        "C28.6006 17.022 28.0781 17.1172 27.5068 17.1172"
+        "C26.9355 17.1172 26.4131 17.022 25.9395 16.8315"
+        "C25.4658 16.6411 25.0557 16.3652 24.709 16.0039"
+        "C24.3623 15.6377 24.0938 15.1982 23.9033 14.6855"
+        "C23.7178 14.1729 23.625 13.5918 23.625 12.9424V12.5322"
+        "C23.625 11.8828 23.7178 11.3018 23.9033 10.7891"
+        "C24.0938 10.2764 24.3599 9.83691 24.7017 9.4707"
+        "C25.0435 9.10449 25.4512 8.82617 25.9248 8.63574"
+        "C26.3984 8.44531 26.9209 8.3501 27.4922 8.3501"
+        "C28.0684 8.3501 28.5908 8.44531 29.0596 8.63574"
+        "C29.5332 8.82617 29.9409 9.10449 30.2827 9.4707"
+        "C30.6294 9.83691 30.8955 10.2764 31.0811 10.7891"
+        "C31.2666 11.3018 31.3594 11.8828 31.3594 12.5322ZM29.5942 12.9424V12.5176"
+        "C29.5942 12.0732 29.5479 11.6802 29.4551 11.3384"
+        "C29.3623 10.9966 29.2231 10.7085 29.0376 10.4741"
+        "C28.8569 10.2397 28.6372 10.0615 28.3784 9.93945"
+        "C28.1196 9.81738 27.8242 9.75635 27.4922 9.75635"
+        "C27.165 9.75635 26.8696 9.81738 26.606 9.93945"
+        "C26.3472 10.0615 26.1274 10.2397 25.9468 10.4741"
+        "C25.771 10.7085 25.6343 10.9966 25.5366 11.3384"
+        "C25.4438 11.6802 25.3975 12.0732 25.3975 12.5176V12.9424"
+        "C25.3975 13.3818 25.4438 13.7749 25.5366 14.1216"
+        "C25.6343 14.4634 25.7734 14.7539 25.9541 14.9932"
+        "C26.1396 15.2275 26.3618 15.4082 26.6206 15.5352"
+        "C26.8843 15.6572 27.1797 15.7183 27.5068 15.7183"
+        "C27.8389 15.7183 28.1318 15.6572 28.3857 15.5352"
+        "C28.6445 15.4082 28.8643 15.2275 29.0449 14.9932"
+        "C29.2256 14.7539 29.3623 14.4634 29.4551 14.1216"
+        "C29.5479 13.7749 29.5942 13.3818 29.5942 12.9424ZM41.1997 8.46729V17H39.4272"
+        "L35.5747 11.1187V17H33.8096V8.46729H35.5747L39.4272 14.3486V8.46729H41.1997Z"
+        "M51.106 12.5322V15.9307C50.9644 16.0918 50.7495 16.2651 50.4614 16.4507"
+        "C50.1733 16.6362 49.7974 16.7949 49.3335 16.9268"
+        "C48.8696 17.0537 48.3008 17.1172 47.627 17.1172"
+        "C47.041 17.1172 46.5063 17.0269 46.0229 16.8462"
+        "C45.5444 16.6606 45.1294 16.3921 44.7778 16.0405"
+        "C44.4263 15.689 44.1553 15.2593 43.9648 14.7515"
+        "C43.7793 14.2388 43.6865 13.6553 43.6865 13.001V12.4663"
+        "C43.6865 11.812 43.7769 11.231 43.9575 10.7231"
+        "C44.1382 10.2104 44.3945 9.77832 44.7266 9.42676"
+        "C45.0635 9.0752 45.4663 8.80908 45.9351 8.62842"
+        "C46.4038 8.44287 46.9263 8.3501 47.5024 8.3501"
+        "C48.2837 8.3501 48.9258 8.47217 49.4287 8.71631"
+        "C49.9365 8.95557 50.3247 9.2876 50.5933 9.7124"
+        "C50.8618 10.1372 51.0303 10.6255 51.0986 11.1772H49.3774"
+        "C49.3286 10.8843 49.2358 10.6328 49.0991 10.4229"
+        "C48.9624 10.208 48.7671 10.042 48.5132 9.9248"
+        "C48.2642 9.80762 47.9419 9.74902 47.5464 9.74902"
+        "C47.2144 9.74902 46.9165 9.80762 46.6528 9.9248"
+        "C46.394 10.0371 46.1743 10.208 45.9937 10.4375"
+        "C45.8179 10.667 45.6836 10.9502 45.5908 11.2871"
+        "C45.5029 11.6191 45.459 12.0073 45.459 12.4517V13.001"
+        "C45.459 13.4453 45.5078 13.8384 45.6055 14.1802"
+        "C45.708 14.5171 45.8545 14.8003 46.0449 15.0298"
+        "C46.2402 15.2593 46.4771 15.4326 46.7554 15.5498"
+        "C47.0386 15.6621 47.3608 15.7183 47.7222 15.7183"
+        "C48.2056 15.7183 48.5693 15.6694 48.8135 15.5718"
+        "C49.0576 15.4692 49.231 15.374 49.3335 15.2861V13.7993H47.4878V12.5322H51.106Z",
+      false, FILL_RULE_NONZERO }
+};
+constexpr auto ASSET_LONG_PILL = vectorRasterize<67, 24>(LONG_PILL_LAYERS);
+
+#endif // POMODORO_ASSETS_H
@@ -1,6 +1,7 @@
 #include <Arduino.h>
 #include "EPD.h"
 #include "GUI_Paint.h"
+#include "WatcherDisplay.h"
 
 // ============================================================
 // SIMPLE COUNTDOWN TIMER
@@ -8,6 +9,7 @@
 // - 60 progress squares around border (one per second)
 // - Polygon-based 7-segment rendering from ONES.svg paths
 // - Partial refresh for smooth updates
+// - Full refresh deferred to the minute boundary (or the end)
 // - No buttons, no title - minimal & clean
 // ============================================================
 
@@ -31,7 +33,8 @@
 #define BORDER_W      282
 #define BORDER_H      202
 
-// Display buffer
+// Display (owns the frame buffer)
+WatcherDisplay display;
 UBYTE *BlackImage;
 
 // Timer state
@@ -131,8 +134,8 @@ const bool DIGIT_SEGS[10][7] = {
     {true,  true,  true,  true,  false, true,  true}   // 9
 };
 
-// Draw complete digit at position
-void drawDigit(uint16_t x, uint16_t y, uint8_t digit) {
+// Rasterize a digit's segments at position
+void drawDigitPolygons(uint16_t x, uint16_t y, uint8_t digit) {
     if (digit > 9) return;
     const bool* segs = DIGIT_SEGS[digit];
     drawSegmentA(x, y, segs[0]);
@@ -144,6 +147,35 @@ void drawDigit(uint16_t x, uint16_t y, uint8_t digit) {
     drawSegmentG(x, y, segs[6]);
 }
 
+// ============================================================
+// DIGIT SPRITES
+// Each digit is rasterized once at startup into a display.cacheShape()
+// sprite (~1.2KB) and blitted row by row from then on
+// ============================================================
+#define DIGIT_SPRITE_W (DIGIT_WIDTH + 1)   // Segment paths reach x+70, y+130
+#define DIGIT_SPRITE_H (DIGIT_HEIGHT + 1)
+
+int8_t digitShapes[10] = {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1};
+
+void drawDigitShape(void* context) {
+    drawDigitPolygons(0, 0, (uint8_t)(uintptr_t)context);
+}
+
+void cacheDigits() {
+    for (uint8_t d = 0; d < 10; d++) {
+        digitShapes[d] = display.cacheShape(DIGIT_SPRITE_W, DIGIT_SPRITE_H,
+                                            drawDigitShape, (void*)(uintptr_t)d);
+    }
+}
+
+// Draw complete digit at position (polygons if its sprite is missing)
+void drawDigit(uint16_t x, uint16_t y, uint8_t digit) {
+    if (digit > 9) return;
+    if (!display.drawCached(digitShapes[digit], x, y, BLACK)) {
+        drawDigitPolygons(x, y, digit);
+    }
+}
+
 // ============================================================
 // CALCULATE 60 SQUARE POSITIONS (Clockwise from top-left)
 // ============================================================
@@ -200,31 +232,9 @@ void drawProgressSquare(uint8_t index, bool filled) {
 // PARTIAL REFRESH
 // ============================================================
 void partialRefresh(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
-    uint16_t refreshX = (x / 8) * 8;
-    uint16_t refreshWidth = ((w + 7) / 8) * 8;
-    uint16_t refreshXEnd = refreshX + refreshWidth;
-    uint16_t refreshYEnd = y + h;
-
-    if (refreshXEnd > SCREEN_WIDTH) refreshXEnd = SCREEN_WIDTH;
-    if (refreshYEnd > SCREEN_HEIGHT) refreshYEnd = SCREEN_HEIGHT;
-
-    UWORD bytesPerRow = ((SCREEN_WIDTH % 8 == 0) ? (SCREEN_WIDTH / 8) : (SCREEN_WIDTH / 8 + 1));
-    UWORD regionBytes = refreshWidth / 8;
-    UWORD bufferSize = regionBytes * h;
-
-    UBYTE *buffer = (UBYTE*)malloc(bufferSize);
-    if (!buffer) return;
-
-    UWORD startX = refreshX / 8;
-    for (UWORD row = 0; row < h; row++) {
-        if ((y + row) >= SCREEN_HEIGHT) break;
-        UWORD srcOff = (y + row) * bytesPerRow + startX;
-        UWORD dstOff = row * regionBytes;
-        memcpy(&buffer[dstOff], &BlackImage[srcOff], regionBytes);
-    }
-
-    EPD_4IN2_V2_PartialDisplay(buffer, refreshX, y, refreshXEnd, refreshYEnd);
-    free(buffer);
+    // Byte-aligned and clamped by WatcherDisplay; rows stream straight out
+    // of BlackImage. A due full refresh waits for an idle window.
+    display.updateRegion(x, y, w, h);
 }
 
 // ============================================================
@@ -248,7 +258,7 @@ void drawFullScreen() {
         drawProgressSquare(i, i < secondInMinute);
     }
 
-    EPD_4IN2_V2_Display(BlackImage);
+    display.fullRefresh();
 
     lastTens = tens;
     lastOnes = ones;
@@ -323,28 +333,26 @@ void setup() {
     Serial.println("  SIMPLE COUNTDOWN TIMER");
     Serial.println("========================================");
 
-    // Display
-    if (DEV_Module_Init() != 0) {
+    // Display (landscape, frame buffer owned by WatcherDisplay)
+    if (!display.begin(false, ROTATE_0)) {
         Serial.println("ERROR: Display init failed!");
         while(1) delay(1000);
     }
+    BlackImage = display.getBuffer();
 
-    EPD_4IN2_V2_Init();
-
-    UWORD size = ((SCREEN_WIDTH % 8 == 0) ? (SCREEN_WIDTH / 8) : (SCREEN_WIDTH / 8 + 1)) * SCREEN_HEIGHT;
-    BlackImage = (UBYTE*)malloc(size);
-
-    if (!BlackImage) {
-        Serial.println("ERROR: Buffer allocation failed!");
-        while(1) delay(1000);
-    }
+    // Partials carry the previous frame; the full refresh that still
+    // comes every 60 of them waits for a quiet moment
+    display.setDifferentialRefresh(true);
+    display.setDeferredMaintenance(true);
 
     EPD_4IN2_V2_Clear();
     delay(500);
 
-    Paint_NewImage(BlackImage, SCREEN_WIDTH, SCREEN_HEIGHT, 0, WHITE);
     Paint_SelectImage(BlackImage);
 
+    // Pre-rasterize the ten digits
+    cacheDigits();
+
     // Calculate square positions
     calculateSquarePositions();
 
@@ -371,13 +379,22 @@ void loop() {
             elapsedSeconds++;
             updateDigits();
             updateProgressSquares();
+
+            // The ring just wrapped: a flash until the next tick goes unnoticed
+            if (elapsedSeconds % 60 == 0) {
+                display.declareIdleWindow(1000);
+            }
             Serial.printf("Time: %02d:%02d (elapsed: %ds)\n",
                          remainingSeconds / 60, remainingSeconds % 60, elapsedSeconds);
         } else {
             isRunning = false;
+            display.setIdle(true);
             Serial.println("\n*** TIMER COMPLETE! ***\n");
         }
     }
 
+    // Start a due full refresh once idle (non-blocking)
+    display.maintainDisplay();
+
     delay(50);
 }